@@ -41,6 +41,10 @@ else
     CFLAGS := -Wall -m64 -O2 -fdiagnostics-color=always -DNDEBUG
 endif
 
+ifeq ($(MEMPROFILE), 1)
+    CFLAGS += -DMEMPROFILE
+endif
+
 SRC_DIR := src/org/devopsbroker
 OBJ_DIR := obj/org/devopsbroker
 
@@ -74,6 +78,7 @@ clean:
 	/bin/rm -fv $(OBJ_DIR)/lang/*
 	/bin/rm -fv $(OBJ_DIR)/log/*
 	/bin/rm -fv $(OBJ_DIR)/net/*
+	/bin/rm -fv $(OBJ_DIR)/proc/*
 	/bin/rm -fv $(OBJ_DIR)/socket/*
 	/bin/rm -fv $(OBJ_DIR)/sysfs/*
 	/bin/rm -fv $(OBJ_DIR)/terminal/*
@@ -89,6 +94,7 @@ prepare:
 	/bin/mkdir --parents --mode=750 $(OBJ_DIR)/lang
 	/bin/mkdir --parents --mode=750 $(OBJ_DIR)/log
 	/bin/mkdir --parents --mode=750 $(OBJ_DIR)/net
+	/bin/mkdir --parents --mode=750 $(OBJ_DIR)/proc
 	/bin/mkdir --parents --mode=750 $(OBJ_DIR)/socket
 	/bin/mkdir --parents --mode=750 $(OBJ_DIR)/sysfs
 	/bin/mkdir --parents --mode=750 $(OBJ_DIR)/terminal
@@ -121,6 +127,10 @@ $(OBJ_DIR)/net/%.o: $(SRC_DIR)/net/%.c $(SRC_DIR)/net/%.h | prepare
 	$(call printInfo,Compiling $(@F))
 	$(CC) $(CFLAGS) -c $< -o $@
 
+$(OBJ_DIR)/proc/%.o: $(SRC_DIR)/proc/%.c $(SRC_DIR)/proc/%.h | prepare
+	$(call printInfo,Compiling $(@F))
+	$(CC) $(CFLAGS) -c $< -o $@
+
 $(OBJ_DIR)/socket/%.o: $(SRC_DIR)/socket/%.c $(SRC_DIR)/socket/%.h | prepare
 	$(call printInfo,Compiling $(@F))
 	$(CC) $(CFLAGS) -c $< -o $@
@@ -166,6 +176,10 @@ $(OBJ_DIR)/net/%.o: $(SRC_DIR)/net/%.asm | prepare
 	$(call printInfo,Compiling $(@F))
 	$(ASM) $(ASMFLAGS) $< -o $@
 
+$(OBJ_DIR)/proc/%.o: $(SRC_DIR)/proc/%.asm | prepare
+	$(call printInfo,Compiling $(@F))
+	$(ASM) $(ASMFLAGS) $< -o $@
+
 $(OBJ_DIR)/socket/%.o: $(SRC_DIR)/socket/%.asm | prepare
 	$(call printInfo,Compiling $(@F))
 	$(ASM) $(ASMFLAGS) $< -o $@
@@ -196,6 +210,7 @@ printenv:
 	echo "  MAKEFILE_LIST: $(MAKEFILE_LIST)"
 	echo "   MAKECMDGOALS: $(MAKECMDGOALS)"
 	echo "          DEBUG: $(DEBUG)"
+	echo "     MEMPROFILE: $(MEMPROFILE)"
 	echo "         TMPDIR: $(TMPDIR)"
 	echo "         CURDIR: $(CURDIR)"
 	echo "            ASM: $(ASM)"
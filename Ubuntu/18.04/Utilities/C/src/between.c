@@ -34,9 +34,9 @@
 #include <string.h>
 
 #include "org/devopsbroker/io/file.h"
+#include "org/devopsbroker/lang/chunkbuilder.h"
 #include "org/devopsbroker/lang/error.h"
 #include "org/devopsbroker/lang/string.h"
-#include "org/devopsbroker/lang/stringbuilder.h"
 #include "org/devopsbroker/terminal/ansi.h"
 
 // ═══════════════════════════════ Preprocessor ═══════════════════════════════
@@ -55,13 +55,22 @@ static inline void removeNewline(char *endPtr) {
 	} while (*endPtr == '\n' || *endPtr == '\r');
 }
 
+// Length of the text with any trailing newline and carriage return removed
+static inline size_t trimNewline(const char *text, size_t length) {
+	while (length > 0 && (text[length - 1] == '\n' || text[length - 1] == '\r')) {
+		length--;
+	}
+
+	return length;
+}
+
 // ═════════════════════════════ Global Variables ═════════════════════════════
 
 char *pathName = NULL;
 char *startPtr = NULL;
 char *endPtr = NULL;
 
-StringBuilder *textBlock = NULL;
+ChunkBuilder *textBlock = NULL;
 
 // ══════════════════════════════════ main() ══════════════════════════════════
 
@@ -118,10 +127,10 @@ int main(int argc, char *argv[]) {
 					}
 					break;
 				} else {
-					// Copy text into StringBuilder from startPtr to end of buffer
+					// Copy text into ChunkBuilder from startPtr to end of buffer
 					numBytes -= (startPtr - buffer);
-					textBlock = c598a24c_createStringBuilder_uint32(numBytes << 1);
-					c598a24c_append_string_uint32(textBlock, startPtr, numBytes);
+					textBlock = f485dc30_createChunkBuilder();
+					f485dc30_append_string_size(textBlock, startPtr, numBytes);
 				}
 			}
 
@@ -130,16 +139,16 @@ int main(int argc, char *argv[]) {
 			endPtr = strstr(buffer, argv[2]);
 
 			if (endPtr != NULL) {
-				removeNewline(endPtr);
+				// Copy text into ChunkBuilder from start of buffer to endPtr
+				f485dc30_append_string_size(textBlock, buffer, trimNewline(buffer, endPtr - buffer));
+				f485dc30_append_char(textBlock, '\n');
 
-				// Copy text into StringBuilder from start of buffer to endPtr
-				numBytes -= (endPtr - buffer);
-				c598a24c_append_string_uint32(textBlock, buffer, numBytes);
-				printf("%s\n", textBlock->buffer);
+				// Write every chunk to STDOUT without joining them first
+				f485dc30_writeFile(textBlock, STDOUT_FILENO, "STDOUT");
 				break;
 			} else {
-				// Copy all text into StringBuilder from buffer
-				c598a24c_append_string_uint32(textBlock, buffer, numBytes);
+				// Copy all text into ChunkBuilder from buffer
+				f485dc30_append_string_size(textBlock, buffer, numBytes);
 			}
 		}
 
@@ -151,9 +160,9 @@ int main(int argc, char *argv[]) {
 		e2f74138_closeFile(fileDescriptor, pathName);
 	}
 
-	// Clean up StringBuilder if allocated
+	// Clean up ChunkBuilder if allocated
 	if (textBlock != NULL) {
-		c598a24c_destroyStringBuilder(textBlock);
+		f485dc30_destroyChunkBuilder(textBlock);
 	}
 
 	// Exit with success
@@ -35,17 +35,18 @@
 #include <unistd.h>
 
 #include "org/devopsbroker/lang/error.h"
+#include "org/devopsbroker/lang/stringbuilder.h"
 #include "org/devopsbroker/net/ipv4address.h"
 #include "org/devopsbroker/net/ipv6address.h"
+#include "org/devopsbroker/net/netlinksnapshot.h"
 #include "org/devopsbroker/net/networkdevice.h"
 #include "org/devopsbroker/socket/netlink.h"
 #include "org/devopsbroker/socket/socket.h"
-#include "org/devopsbroker/socket/unix.h"
 #include "org/devopsbroker/terminal/commandline.h"
 
 // ═══════════════════════════════ Preprocessor ═══════════════════════════════
 
-#define USAGE_MSG "derivesubnet " ANSI_GOLD "{ -4 | -6 | -h }" ANSI_YELLOW " IF_NAME"
+#define USAGE_MSG "derivesubnet " ANSI_GOLD "{ -4 | -6 | -h }" ANSI_YELLOW " [IF_NAME]"
 
 // ═════════════════════════════════ Typedefs ═════════════════════════════════
 
@@ -64,6 +65,10 @@ static_assert(sizeof(DeviceParams) == 16, "Check your assumptions");
 
 static void printHelp();
 
+static void printIPv4Subnet(NetworkDevice *networkDevice, bool printName);
+
+static void printIPv6Subnet(NetworkDevice *networkDevice, bool printName);
+
 /* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
  * Possible command-line options:
  *
@@ -100,12 +105,6 @@ static void processCmdLine(CmdLineParam *cmdLineParm, DeviceParams *deviceParams
 			deviceParams->deviceName = argv[i];
 		}
 	}
-
-	if (deviceParams->deviceName == NULL) {
-		c7c88e52_missingParam("device name");
-		c7c88e52_printUsage(USAGE_MSG);
-		exit(EXIT_FAILURE);
-	}
 }
 
 // ══════════════════════════════════ main() ══════════════════════════════════
@@ -120,100 +119,93 @@ int main(int argc, char *argv[]) {
 	d7ad7024_initCmdLineParam(&cmdLineParm, argc, argv, USAGE_MSG);
 	processCmdLine(&cmdLineParm, &deviceParams);
 
-	UnixSocket unixSocket;
-	NetworkDevice networkDevice;
-	NetworkDeviceRequest ndRequest;
+	NetlinkSnapshot snapshot;
+	NetworkDevice *networkDevice;
 
-	f0185083_initNetworkDevice(&networkDevice, deviceParams.deviceName);
-	f0185083_initNetworkDeviceRequest(&networkDevice, &ndRequest);
-
-	bfdb2c2a_open(&unixSocket, UNIX_SOCK_DGRAM);
-	f0185083_getNetworkDeviceIndex(&networkDevice, &ndRequest, &unixSocket);
-	bfdb2c2a_close(&unixSocket);
-
-	size_t bufSize = sysconf(_SC_PAGESIZE) - 72;
-	NetlinkSocket *netlinkSocket = e7173ad4_createNetlinkSocket(NETLINK_ROUTE_ENUM, bufSize);
+	NetlinkSocket *netlinkSocket = e7173ad4_createNetlinkSocket(NETLINK_ROUTE_ENUM, NETLINK_DUMP_SIZE);
 
 	// Initialize Netlink socket
 	e7173ad4_open(netlinkSocket);
 	a36b5966_setMaxSendBufferSize(netlinkSocket->fd, NETLINK_BUF_SIZE);
 	a36b5966_setMaxRecvBufferSize(netlinkSocket->fd, NETLINK_BUF_SIZE);
 	e7173ad4_setExtendedACKReporting(netlinkSocket, true);
+	e7173ad4_setStrictChecking(netlinkSocket, true);
 
 	// Bind Netlink socket
 	e7173ad4_bind(netlinkSocket);
 
-	if (deviceParams.deriveIPv4Subnet) {
-		f668c4bd_meminit(&networkDevice.ipv4Address, sizeof(IPv4Address));
-
-		f0185083_getIPv4Address(&networkDevice, netlinkSocket);
+	e15c4841_initNetlinkSnapshot(&snapshot);
 
-		if (networkDevice.ipv4Address.address == 0) {
-			c7c88e52_printNotice("Network device exists but cannot find IP address");
-
-			// Close Netlink socket
-			e7173ad4_close(netlinkSocket);
-			e7173ad4_destroyNetlinkSocket(netlinkSocket);
-
-			exit(EXIT_FAILURE);
-		}
-
-		f0185083_getIPv4Gateway(&networkDevice, netlinkSocket);
+	if (deviceParams.deviceName == NULL) {
+		// One link, address and route dump answers the queries for every interface
+		e15c4841_readNetlinkSnapshot(&snapshot, netlinkSocket);
 	} else {
-		f668c4bd_meminit(&networkDevice.ipv6Global, sizeof(IPv6Address));
-		f668c4bd_meminit(&networkDevice.ipv6Local, sizeof(IPv6Address));
-
-		f0185083_getIPv6Addresses(&networkDevice, netlinkSocket);
+		const unsigned char family = deviceParams.deriveIPv4Subnet ? AF_INET : AF_INET6;
 
-		if (b7808f25_isIpAddressZero(&networkDevice.ipv6Global)) {
-			c7c88e52_printNotice("Network device exists but cannot find IP address");
-
-			// Close Netlink socket
-			e7173ad4_close(netlinkSocket);
-			e7173ad4_destroyNetlinkSocket(netlinkSocket);
-
-			exit(EXIT_FAILURE);
-		}
-
-		f0185083_getIPv6Gateway(&networkDevice, netlinkSocket);
+		// Only the requested interface is dumped when the kernel supports
+		// filtering; an unknown device leaves the snapshot empty
+		e15c4841_readNetworkDevice(&snapshot, netlinkSocket, deviceParams.deviceName, family);
 	}
 
 	// Close Netlink socket
 	e7173ad4_close(netlinkSocket);
 	e7173ad4_destroyNetlinkSocket(netlinkSocket);
 
-	if (deviceParams.deriveIPv4Subnet) {
-		char ipAddrString[IPV4_STRBUF_LEN];
-
-		e1e7e8f5_extractString(&networkDevice.ipv4Address, IPV4_ADDR | IVP4_CIDR_SUFFIX, ipAddrString);
-		puts(ipAddrString);
+	if (deviceParams.deviceName == NULL) {
+		for (uint32_t i = 1; i < snapshot.size; i++) {
+			networkDevice = e15c4841_getNetworkDevice(&snapshot, i);
 
-		IPv4Address ipv4Gateway;
-		ipv4Gateway.address = networkDevice.ipv4Gateway;
-		e1e7e8f5_extractString(&ipv4Gateway, IPV4_ADDR, ipAddrString);
-		puts(ipAddrString);
+			if (networkDevice == NULL) {
+				continue;
+			}
 
-		e1e7e8f5_deriveSubnetMask(&networkDevice.ipv4Address);
-		e1e7e8f5_extractString(&networkDevice.ipv4Address, IPV4_ROUTE, ipAddrString);
-		puts(ipAddrString);
+			if (deviceParams.deriveIPv4Subnet) {
+				if (networkDevice->ipv4Address.address != 0) {
+					printIPv4Subnet(networkDevice, true);
+				}
+			} else if (!b7808f25_isIpAddressZero(&networkDevice->ipv6Global)) {
+				printIPv6Subnet(networkDevice, true);
+			}
+		}
 	} else {
-		char ipAddrString[IPV6_STRBUF_LEN];
+		networkDevice = e15c4841_findNetworkDevice(&snapshot, deviceParams.deviceName);
+
+		if (networkDevice == NULL) {
+			StringBuilder errorMessage;
+			c598a24c_initStringBuilder(&errorMessage);
+
+			c598a24c_append_string(&errorMessage, "Cannot find network device '");
+			c598a24c_append_string(&errorMessage, deviceParams.deviceName);
+			c598a24c_append_char(&errorMessage, '\'');
+
+			c7c88e52_printError_string(errorMessage.buffer);
+			c598a24c_cleanUpStringBuilder(&errorMessage);
 
-		b7808f25_extractString(&networkDevice.ipv6Global, ipAddrString);
-		puts(ipAddrString);
+			e15c4841_cleanUpNetlinkSnapshot(&snapshot);
+			exit(EXIT_FAILURE);
+		}
 
-		b7808f25_extractString(&networkDevice.ipv6Local, ipAddrString);
-		puts(ipAddrString);
+		if (deviceParams.deriveIPv4Subnet) {
+			if (networkDevice->ipv4Address.address == 0) {
+				c7c88e52_printNotice("Network device exists but cannot find IP address");
+				e15c4841_cleanUpNetlinkSnapshot(&snapshot);
+				exit(EXIT_FAILURE);
+			}
 
-		b7808f25_extractString(&networkDevice.ipv6Gateway, ipAddrString);
-		puts(ipAddrString);
+			printIPv4Subnet(networkDevice, false);
+		} else {
+			if (b7808f25_isIpAddressZero(&networkDevice->ipv6Global)) {
+				c7c88e52_printNotice("Network device exists but cannot find IP address");
+				e15c4841_cleanUpNetlinkSnapshot(&snapshot);
+				exit(EXIT_FAILURE);
+			}
 
-		IPv6Address ipv6GlobalSubnet;
-		b7808f25_deriveSubnet(&networkDevice.ipv6Global, &ipv6GlobalSubnet);
-		b7808f25_extractString(&ipv6GlobalSubnet, ipAddrString);
-		puts(ipAddrString);
+			printIPv6Subnet(networkDevice, false);
+		}
 	}
 
+	e15c4841_cleanUpNetlinkSnapshot(&snapshot);
+
 	// Exit with success
 	exit(EXIT_SUCCESS);
 }
@@ -223,16 +215,72 @@ int main(int argc, char *argv[]) {
 static void printHelp() {
 	c7c88e52_printUsage(USAGE_MSG);
 
-	puts("\nDerives the IPv4 routing prefix or IPv6 subnet for a network interface");
+	puts("\nDerives the IPv4 routing prefix or IPv6 subnet for one or every network interface");
 
 	puts(ANSI_BOLD "\nDefault Values:" ANSI_RESET);
 	puts("  Protocol\tIPv4");
 
 	puts(ANSI_BOLD "\nExamples:" ANSI_RESET);
 	puts("  derivesubnet -6 enp31s0");
+	puts("  derivesubnet -4");
+
+	puts(ANSI_BOLD "\nOutput:" ANSI_RESET);
+	puts("  With IF_NAME each value is printed on its own line");
+	puts("  Without IF_NAME one tab-separated line is printed per interface with an address");
 
 	puts(ANSI_BOLD "\nValid Options:\n");
 	puts(ANSI_YELLOW "  -4\t" ANSI_ROMANTIC "Derive the IPv4 routing prefix");
 	puts(ANSI_BOLD ANSI_YELLOW "  -6\t" ANSI_ROMANTIC "Derive the IPv6 subnet");
 	puts(ANSI_BOLD ANSI_YELLOW "  -h\t" ANSI_ROMANTIC "Print this help message\n");
 }
+
+static void printIPv4Subnet(NetworkDevice *networkDevice, bool printName) {
+	const char separator = printName ? '\t' : '\n';
+	char ipAddrString[IPV4_STRBUF_LEN];
+	IPv4Address ipv4Gateway;
+
+	if (printName) {
+		fputs(networkDevice->name, stdout);
+		putchar(separator);
+	}
+
+	e1e7e8f5_extractString(&networkDevice->ipv4Address, IPV4_ADDR | IVP4_CIDR_SUFFIX, ipAddrString);
+	fputs(ipAddrString, stdout);
+	putchar(separator);
+
+	ipv4Gateway.address = networkDevice->ipv4Gateway;
+	e1e7e8f5_extractString(&ipv4Gateway, IPV4_ADDR, ipAddrString);
+	fputs(ipAddrString, stdout);
+	putchar(separator);
+
+	e1e7e8f5_deriveSubnetMask(&networkDevice->ipv4Address);
+	e1e7e8f5_extractString(&networkDevice->ipv4Address, IPV4_ROUTE, ipAddrString);
+	puts(ipAddrString);
+}
+
+static void printIPv6Subnet(NetworkDevice *networkDevice, bool printName) {
+	const char separator = printName ? '\t' : '\n';
+	char ipAddrString[IPV6_STRBUF_LEN];
+	IPv6Address ipv6GlobalSubnet;
+
+	if (printName) {
+		fputs(networkDevice->name, stdout);
+		putchar(separator);
+	}
+
+	b7808f25_extractString(&networkDevice->ipv6Global, ipAddrString);
+	fputs(ipAddrString, stdout);
+	putchar(separator);
+
+	b7808f25_extractString(&networkDevice->ipv6Local, ipAddrString);
+	fputs(ipAddrString, stdout);
+	putchar(separator);
+
+	b7808f25_extractString(&networkDevice->ipv6Gateway, ipAddrString);
+	fputs(ipAddrString, stdout);
+	putchar(separator);
+
+	b7808f25_deriveSubnet(&networkDevice->ipv6Global, &ipv6GlobalSubnet);
+	b7808f25_extractString(&ipv6GlobalSubnet, ipAddrString);
+	puts(ipAddrString);
+}
@@ -35,6 +35,7 @@
 #include "org/devopsbroker/adt/listarray.h"
 #include "org/devopsbroker/io/shell.h"
 #include "org/devopsbroker/lang/error.h"
+#include "org/devopsbroker/lang/integer.h"
 #include "org/devopsbroker/lang/memory.h"
 #include "org/devopsbroker/lang/string.h"
 #include "org/devopsbroker/lang/stringbuilder.h"
@@ -85,7 +86,7 @@ typedef struct FirewallParams {
 	ListArray ruleList;
 } FirewallParams;
 
-static_assert(sizeof(FirewallParams) == 56, "Check your assumptions");
+static_assert(sizeof(FirewallParams) == 64, "Check your assumptions");
 
 // ═════════════════════════════ Global Variables ═════════════════════════════
 
@@ -112,7 +113,6 @@ static void printHelp(int argc, char *argv[]);
  * ----------------------------------------------------------------------------
  */
 static void processCmdLine(CmdLineParam *cmdLineParm, FirewallParams *firewallParams) {
-	StringBuilder strBuilder;
 	int argIndex = 1;
 
 	// Perform initializations
@@ -171,18 +171,12 @@ static void processCmdLine(CmdLineParam *cmdLineParm, FirewallParams *firewallPa
 	// Initialize the ListArray
 	b196167f_initListArray(&firewallParams->ruleList);
 
-	// Build the iptables command-line
-	c598a24c_initStringBuilder(&strBuilder);
-	c598a24c_append_string(&strBuilder, "/sbin/iptables -t ");
-	c598a24c_append_string(&strBuilder, firewallParams->tableName);
-	c598a24c_append_string(&strBuilder, " --line-numbers --numeric --list ");
-	c598a24c_append_string(&strBuilder, firewallParams->chainName);
-	c598a24c_append_string(&strBuilder, " 2>/dev/null");
-
+	// Run iptables directly with the table and chain as separate arguments
+	char *iptablesArgs[] = { "/sbin/iptables", "-t", firewallParams->tableName, "--line-numbers", "--numeric", "--list", firewallParams->chainName, NULL };
 	Shell iptables;
 	char *rule;
 
-	f6843e7e_openShellForRead(&iptables, strBuilder.buffer);
+	f6843e7e_openExecForRead(&iptables, iptablesArgs[0], iptablesArgs, true);
 
 	int numBytes = c196bc72_populateLineBuffer(&lineBuffer, iptables.fd);
 	while (numBytes != END_OF_FILE) {
@@ -378,50 +372,25 @@ static int findRuleIndex(FirewallParams *firewallParams) {
 }
 
 static int processAdd(FirewallParams *firewallParams) {
-	StringBuilder strBuilder;
 	int ruleIndex = findRuleIndex(firewallParams);
 	int status = 0;
 
 	// Insert the iptables firewall rule if it does not already exist
 	if (ruleIndex < 0) {
-		c598a24c_initStringBuilder(&strBuilder);
-
-		// Build the iptables command-line
-		c598a24c_append_string(&strBuilder, "/sbin/iptables -t ");
-		c598a24c_append_string(&strBuilder, firewallParams->tableName);
-		c598a24c_append_string(&strBuilder, " -I ");
-		c598a24c_append_string(&strBuilder, firewallParams->chainName);
-		c598a24c_append_char(&strBuilder, ' ');
-		c598a24c_append_uint(&strBuilder, firewallParams->ruleList.length - 2);
-		c598a24c_append_string(&strBuilder, " -p ");
-
-		if (firewallParams->protocol == TCP) {
-			c598a24c_append_string(&strBuilder, "tcp");
-		} else {
-			c598a24c_append_string(&strBuilder, "udp");
-		}
+		char *protocol = (firewallParams->protocol == TCP) ? "tcp" : "udp";
+		char *portOption = (firewallParams->portType == SOURCE) ? "--sport" : "--dport";
+		char *position = f45efac2_toString_uint32(firewallParams->ruleList.length - 2);
+		char *portNumber = f45efac2_toString_int32(firewallParams->portNumber);
 
-		c598a24c_append_string(&strBuilder, " -m ");
-
-		if (firewallParams->protocol == TCP) {
-			c598a24c_append_string(&strBuilder, "tcp");
-		} else {
-			c598a24c_append_string(&strBuilder, "udp");
-		}
-
-		if (firewallParams->portType == SOURCE) {
-			c598a24c_append_string(&strBuilder, " --sport ");
-		} else {
-			c598a24c_append_string(&strBuilder, " --dport ");
-		}
-
-		c598a24c_append_int(&strBuilder, firewallParams->portNumber);
-
-		c598a24c_append_string(&strBuilder, " -j ");
-		c598a24c_append_string(&strBuilder, firewallParams->ruleAction);
+		// Build the iptables argument list
+		char *iptablesArgs[] = { "/sbin/iptables", "-t", firewallParams->tableName, "-I", firewallParams->chainName, position,
+		                         "-p", protocol, "-m", protocol, portOption, portNumber, "-j", firewallParams->ruleAction, NULL };
 
 		// Insert the iptables firewall rule
-		status = system(strBuilder.buffer);
+		status = f6843e7e_execute(iptablesArgs[0], iptablesArgs);
+
+		f668c4bd_free(position);
+		f668c4bd_free(portNumber);
 	} else {
 		c7c88e52_printNotice("Rule already exists");
 	}
@@ -430,24 +399,20 @@ static int processAdd(FirewallParams *firewallParams) {
 }
 
 static int processDelete(FirewallParams *firewallParams) {
-	StringBuilder strBuilder;
 	int ruleIndex = findRuleIndex(firewallParams);
 	int status = 0;
 
 	// Delete the iptables firewall rule if it exists
 	if (ruleIndex >= 0) {
-		c598a24c_initStringBuilder(&strBuilder);
+		char *ruleNumber = f45efac2_toString_int32(ruleIndex);
 
-		// Build the iptables command-line
-		c598a24c_append_string(&strBuilder, "/sbin/iptables -t ");
-		c598a24c_append_string(&strBuilder, firewallParams->tableName);
-		c598a24c_append_string(&strBuilder, " -D ");
-		c598a24c_append_string(&strBuilder, firewallParams->chainName);
-		c598a24c_append_char(&strBuilder, ' ');
-		c598a24c_append_int(&strBuilder, ruleIndex);
+		// Build the iptables argument list
+		char *iptablesArgs[] = { "/sbin/iptables", "-t", firewallParams->tableName, "-D", firewallParams->chainName, ruleNumber, NULL };
 
 		// Delete the iptables firewall rule
-		status = system(strBuilder.buffer);
+		status = f6843e7e_execute(iptablesArgs[0], iptablesArgs);
+
+		f668c4bd_free(ruleNumber);
 	} else {
 		c7c88e52_printNotice("Rule does not exist");
 	}
@@ -35,9 +35,13 @@
 
 #include <locale.h>
 
-#include "org/devopsbroker/adt/listarray.h"
+#include "org/devopsbroker/adt/sort.h"
+#include "org/devopsbroker/adt/vector.h"
+#include "org/devopsbroker/io/file.h"
 #include "org/devopsbroker/io/pipe.h"
+#include "org/devopsbroker/lang/arena.h"
 #include "org/devopsbroker/lang/error.h"
+#include "org/devopsbroker/lang/stringbuilder.h"
 #include "org/devopsbroker/lang/system.h"
 #include "org/devopsbroker/log/logline.h"
 #include "org/devopsbroker/text/linebuffer.h"
@@ -47,8 +51,13 @@
 
 #define END_OF_FILE   0
 
+#define INPUT_ICMP_FORMAT  "Count: %u IN=%s MAC=%s SRC=%s DST=%s PROTO=%s TYPE=%u\n"
+#define INPUT_FORMAT       "Count: %u IN=%s MAC=%s SRC=%s DST=%s PROTO=%s SPT=%u DPT=%u\n"
+#define OUTPUT_FORMAT      "Count: %u OUT=%s SRC=%s DST=%s PROTO=%s SPT=%u DPT=%u\n"
+
 // ═════════════════════════════════ Typedefs ═════════════════════════════════
 
+typedef VECTOR_OF(LogLine) LogLineVector;
 
 // ═══════════════════════════ Function Declarations ══════════════════════════
 
@@ -57,9 +66,12 @@ static void filterOutputLogLine(LogLine *logLine);
 
 // ═════════════════════════════ Global Variables ═════════════════════════════
 
-// Input/Output LogLine ListArrays
-ListArray *inputLogLineList;
-ListArray *outputLogLineList;
+// All LogLine line data and vector values share the lifetime of the program run
+Arena arena;
+
+// Input/Output LogLine vectors store each LogLine inline for linear scans
+LogLineVector inputLogLineList;
+LogLineVector outputLogLineList;
 
 // dmesg path and argument list
 const char *dmesg = "/bin/dmesg";
@@ -74,10 +86,11 @@ int main(int argc, char *argv[]) {
 
 	programName = "firelog";
 
-	// Create the default LogLine and Input/Output LogLine ListArrays
+	// Create the default LogLine and Input/Output LogLine vectors
 	LogLine logLine;
-	inputLogLineList = b196167f_createListArray();
-	outputLogLineList = b196167f_createListArray();
+	eab6f0ff_initArena(&arena);
+	vectorInit_arena(&inputLogLineList, &arena, 64);
+	vectorInit_arena(&outputLogLineList, &arena, 64);
 
 	// Compile the BLOCK header regular expression
 	regex_t regExpr;
@@ -123,63 +136,87 @@ int main(int argc, char *argv[]) {
 	b395ed5f_freeRegExpr(&regExpr);
 
 	register uint32_t listLength;
-	register void **listValues;
+	register LogLine *listValues;
 	register uint32_t i;
 	register LogLine *listEntry;
 
+	// Build the report in memory and write it out with a single system call
+	StringBuilder report;
+	c598a24c_initStringBuilder_uint32(&report, 8192);
+
 	// Process the inputLogLineList entries
-	if (inputLogLineList->length > 0) {
-		listLength = inputLogLineList->length;
-		listValues = inputLogLineList->values;
+	if (inputLogLineList.length > 0) {
+		listLength = inputLogLineList.length;
+		listValues = inputLogLineList.values;
 		i = 0;
 
+		// Rank the entries by count, keeping first-seen order among ties
+		e9497a6d_radixSort(listValues, listLength, sizeof(LogLine), offsetof(LogLine, count), sizeof(uint32_t), SORT_DESCENDING);
+
+		StringFormat icmpFormat, inputFormat;
+		c598a24c_initStringFormat(&icmpFormat, INPUT_ICMP_FORMAT);
+		c598a24c_initStringFormat(&inputFormat, INPUT_FORMAT);
+
 		d99c60f5_printBox("firelog INPUT BLOCK Log Entries", false);
 
-		// Loop over the inputLogLineList entries and free the LogLine buffers and instances
+		// Loop over the inputLogLineList entries
 		while (i < listLength) {
-			listEntry = listValues[i++];
+			listEntry = &listValues[i++];
 
 			if (listEntry->destPort == 0) {
 				// Print ICMP firewall entry
-				printf("Count: %u IN=%s MAC=%s SRC=%s DST=%s PROTO=%s TYPE=%u\n", listEntry->count, listEntry->in, listEntry->macAddress, \
+				c598a24c_append_stringFormat(&report, &icmpFormat, listEntry->count, listEntry->in, listEntry->macAddress, \
 					listEntry->sourceIPAddr, listEntry->destIPAddr, listEntry->protocol, listEntry->sourcePort);
 			} else {
 				// Print non-ICMP firewall entry
-				printf("Count: %u IN=%s MAC=%s SRC=%s DST=%s PROTO=%s SPT=%u DPT=%u\n", listEntry->count, listEntry->in, listEntry->macAddress, \
+				c598a24c_append_stringFormat(&report, &inputFormat, listEntry->count, listEntry->in, listEntry->macAddress, \
 					listEntry->sourceIPAddr, listEntry->destIPAddr, listEntry->protocol, listEntry->sourcePort, listEntry->destPort);
 			}
-
-			b45c9f7e_destroyLogLine(listEntry);
 		}
 
-		b196167f_destroyListArray(inputLogLineList);
-		printf("\n");
-	}
+		c598a24c_cleanUpStringFormat(&icmpFormat);
+		c598a24c_cleanUpStringFormat(&inputFormat);
+		c598a24c_append_char(&report, '\n');
 
-	fflush(stdout);
+		// d99c60f5_printBox() goes through stdio so flush it before writing the report
+		fflush(stdout);
+		e2f74138_writeFile(STDOUT_FILENO, report.buffer, report.length, "stdout");
+		c598a24c_resetStringBuilder(&report);
+	}
 
 	// Process the outputLogLineList entries
-	if (outputLogLineList->length > 0) {
-		listLength = outputLogLineList->length;
-		listValues = outputLogLineList->values;
+	if (outputLogLineList.length > 0) {
+		listLength = outputLogLineList.length;
+		listValues = outputLogLineList.values;
 		i = 0;
 
+		e9497a6d_radixSort(listValues, listLength, sizeof(LogLine), offsetof(LogLine, count), sizeof(uint32_t), SORT_DESCENDING);
+
+		StringFormat outputFormat;
+		c598a24c_initStringFormat(&outputFormat, OUTPUT_FORMAT);
+
 		d99c60f5_printBox("firelog OUTPUT BLOCK Log Entries", false);
 
-		// Loop over the outputLogLineList entries and free the LogLine buffers and instances
+		// Loop over the outputLogLineList entries
 		while (i < listLength) {
-			listEntry = listValues[i++];
+			listEntry = &listValues[i++];
 
-			printf("Count: %u OUT=%s SRC=%s DST=%s PROTO=%s SPT=%u DPT=%u\n", listEntry->count, listEntry->out, listEntry->sourceIPAddr, \
+			c598a24c_append_stringFormat(&report, &outputFormat, listEntry->count, listEntry->out, listEntry->sourceIPAddr, \
 				 listEntry->destIPAddr, listEntry->protocol, listEntry->sourcePort, listEntry->destPort);
-
-			b45c9f7e_destroyLogLine(listEntry);
 		}
 
-		b196167f_destroyListArray(outputLogLineList);
-		printf("\n");
+		c598a24c_cleanUpStringFormat(&outputFormat);
+		c598a24c_append_char(&report, '\n');
+
+		fflush(stdout);
+		e2f74138_writeFile(STDOUT_FILENO, report.buffer, report.length, "stdout");
 	}
 
+	c598a24c_cleanUpStringBuilder(&report);
+
+	// Release every LogLine and vector allocation in one shot
+	eab6f0ff_cleanUpArena(&arena);
+
 	// Exit with success
 	exit(EXIT_SUCCESS);
 }
@@ -195,14 +232,14 @@ int main(int argc, char *argv[]) {
  *   o Ignore changes in SPT and/or DPT
  */
 void filterInputLogLine(register LogLine *logLine) {
-	register const uint32_t listLength = inputLogLineList->length;
-	register void **listValues = inputLogLineList->values;
+	register const uint32_t listLength = inputLogLineList.length;
+	register LogLine *listValues = inputLogLineList.values;
 	register uint32_t i = 0;
 	register LogLine *listEntry;
 
 	// 1. Loop over the existing inputLogLineList entries
 	while (i < listLength) {
-		listEntry = listValues[i++];
+		listEntry = &listValues[i++];
 
 		if (f6215943_isEqual(listEntry->in, logLine->in)
 			&& f6215943_isEqual(listEntry->out, logLine->out)
@@ -220,8 +257,8 @@ void filterInputLogLine(register LogLine *logLine) {
 	}
 
 	// 2. Add LogLine to the inputLogLineList
-	LogLine *newListItem = b45c9f7e_cloneLogLine(logLine);
-	b196167f_add(inputLogLineList, newListItem);
+	LogLine *newListItem = vectorEmplace(&inputLogLineList);
+	b45c9f7e_copyLogLine_arena(newListItem, logLine, &arena);
 }
 
 /*
@@ -231,14 +268,14 @@ void filterInputLogLine(register LogLine *logLine) {
  *   o Ignore changes in SPT
  */
 void filterOutputLogLine(register LogLine *logLine) {
-	register const uint32_t listLength = outputLogLineList->length;
-	register void **listValues = outputLogLineList->values;
+	register const uint32_t listLength = outputLogLineList.length;
+	register LogLine *listValues = outputLogLineList.values;
 	register uint32_t i = 0;
 	register LogLine *listEntry;
 
 	// 1. Loop over the existing outputLogLineList entries
 	while (i < listLength) {
-		listEntry = listValues[i++];
+		listEntry = &listValues[i++];
 
 		if (f6215943_isEqual(listEntry->in, logLine->in)
 			&& f6215943_isEqual(listEntry->out, logLine->out)
@@ -252,6 +289,6 @@ void filterOutputLogLine(register LogLine *logLine) {
 	}
 
 	// 2. Add LogLine to the outputLogLineList
-	LogLine *newListItem = b45c9f7e_cloneLogLine(logLine);
-	b196167f_add(outputLogLineList, newListItem);
+	LogLine *newListItem = vectorEmplace(&outputLogLineList);
+	b45c9f7e_copyLogLine_arena(newListItem, logLine, &arena);
 }
@@ -0,0 +1,357 @@
+/*
+ * linkstats.c - DevOpsBroker utility for sampling network interface statistics
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * Takes one RTM_GETLINK dump per sample and reads the IFLA_STATS64 counters of
+ * every interface from it, so each sample costs a single netlink round trip
+ * regardless of the number of interfaces. Samples are taken on an absolute
+ * CLOCK_MONOTONIC schedule and the rates are computed against the measured
+ * time between dumps rather than the nominal interval.
+ * -----------------------------------------------------------------------------
+ */
+
+// ════════════════════════════ Feature Test Macros ═══════════════════════════
+
+#define _DEFAULT_SOURCE
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <assert.h>
+#include <time.h>
+
+#include <linux/if_link.h>
+#include <net/if.h>
+
+#include "org/devopsbroker/lang/error.h"
+#include "org/devopsbroker/lang/memory.h"
+#include "org/devopsbroker/proc/procfile.h"
+#include "org/devopsbroker/socket/netlink.h"
+#include "org/devopsbroker/socket/socket.h"
+#include "org/devopsbroker/terminal/commandline.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define USAGE_MSG "linkstats " ANSI_GOLD "{ -i interval | -c count | -h }" ANSI_YELLOW " [IF_NAME]"
+
+#define DEFAULT_INTERVAL 1000
+
+#define MIN_INTERVAL 10
+
+#define DEFAULT_NUM_SLOTS 16
+
+#define LINK_NUM_COUNTERS (sizeof(LinkCounters) / sizeof(uint64_t))
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+// The leading fields of struct rtnl_link_stats64, which newer kernels extend
+typedef struct LinkCounters {
+	uint64_t rxPackets;
+	uint64_t txPackets;
+	uint64_t rxBytes;
+	uint64_t txBytes;
+	uint64_t rxErrors;
+	uint64_t txErrors;
+	uint64_t rxDropped;
+	uint64_t txDropped;
+	uint64_t multicast;
+	uint64_t collisions;
+	uint64_t rxLengthErrors;
+	uint64_t rxOverErrors;
+	uint64_t rxCrcErrors;
+	uint64_t rxFrameErrors;
+	uint64_t rxFifoErrors;
+	uint64_t rxMissedErrors;
+	uint64_t txAbortedErrors;
+	uint64_t txCarrierErrors;
+	uint64_t txFifoErrors;
+	uint64_t txHeartbeatErrors;
+	uint64_t txWindowErrors;
+	uint64_t rxCompressed;
+	uint64_t txCompressed;
+} LinkCounters;
+
+static_assert(sizeof(LinkCounters) == 184, "Check your assumptions");
+
+typedef struct LinkSample {
+	LinkCounters counters;
+	char name[IFNAMSIZ];
+	uint32_t index;                // Zero when the slot is unused
+	char _padding[4];
+} LinkSample;
+
+static_assert(sizeof(LinkSample) == 208, "Check your assumptions");
+
+typedef struct LinkSampler {
+	LinkSample *samples;           // Indexed by interface index
+	uint64_t timestamp;            // CLOCK_MONOTONIC nanoseconds
+	uint32_t size;
+	uint32_t sequence;
+} LinkSampler;
+
+static_assert(sizeof(LinkSampler) == 24, "Check your assumptions");
+
+typedef struct SamplerParams {
+	char *deviceName;
+	uint32_t interval;             // Milliseconds between samples
+	uint32_t count;                // Zero to sample until interrupted
+} SamplerParams;
+
+static_assert(sizeof(SamplerParams) == 16, "Check your assumptions");
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+static void printHelp();
+
+static void storeSample(void *context, NetlinkMessageHeader *msgHeader);
+
+static void readSample(LinkSampler *sampler, NetlinkSocket *netlinkSocket);
+
+static void printRates(const LinkSampler *prev, const LinkSampler *curr, const SamplerParams *samplerParams, const uint64_t startTime);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Possible command-line options:
+ *
+ *   -i -> Sample interval
+ *   -c -> Sample count
+ *   -h -> Help
+ * ----------------------------------------------------------------------------
+ */
+static void processCmdLine(CmdLineParam *cmdLineParm, SamplerParams *samplerParams) {
+	register int argc = cmdLineParm->argc;
+	register char **argv = cmdLineParm->argv;
+
+	// Perform initializations
+	f668c4bd_meminit(samplerParams, sizeof(SamplerParams));
+	samplerParams->interval = DEFAULT_INTERVAL;
+
+	for (int i = 1; i < argc; i++) {
+		if (argv[i][0] == '-') {
+			if (argv[i][1] == 'i') {
+				samplerParams->interval = d7ad7024_getUint32(cmdLineParm, "sample interval", ++i);
+
+				if (samplerParams->interval < MIN_INTERVAL) {
+					c7c88e52_invalidValue("sample interval", argv[i]);
+					c7c88e52_printUsage(USAGE_MSG);
+					exit(EXIT_FAILURE);
+				}
+			} else if (argv[i][1] == 'c') {
+				samplerParams->count = d7ad7024_getUint32(cmdLineParm, "sample count", ++i);
+			} else if (argv[i][1] == 'h') {
+				printHelp();
+				exit(EXIT_SUCCESS);
+			} else {
+				c7c88e52_invalidOption(argv[i]);
+				c7c88e52_printUsage(USAGE_MSG);
+				exit(EXIT_FAILURE);
+			}
+		} else {
+			samplerParams->deviceName = argv[i];
+		}
+	}
+}
+
+// ══════════════════════════════════ main() ══════════════════════════════════
+
+int main(int argc, char *argv[]) {
+
+	programName = "linkstats";
+
+	SamplerParams samplerParams;
+	CmdLineParam cmdLineParm;
+
+	d7ad7024_initCmdLineParam(&cmdLineParm, argc, argv, USAGE_MSG);
+	processCmdLine(&cmdLineParm, &samplerParams);
+
+	LinkSampler samplers[2];
+	LinkSampler *prev = &samplers[0];
+	LinkSampler *curr = &samplers[1];
+	LinkSampler *temp;
+	struct timespec deadline;
+
+	f668c4bd_meminit(samplers, sizeof(samplers));
+
+	NetlinkSocket *netlinkSocket = e7173ad4_createNetlinkSocket(NETLINK_ROUTE_ENUM, NETLINK_DUMP_SIZE);
+
+	// Initialize Netlink socket
+	e7173ad4_open(netlinkSocket);
+	a36b5966_setMaxSendBufferSize(netlinkSocket->fd, NETLINK_BUF_SIZE);
+	a36b5966_setMaxRecvBufferSize(netlinkSocket->fd, NETLINK_BUF_SIZE);
+	e7173ad4_setExtendedACKReporting(netlinkSocket, true);
+
+	// Bind Netlink socket
+	e7173ad4_bind(netlinkSocket);
+
+	// Output is usually piped into a dashboard collector
+	setvbuf(stdout, NULL, _IOLBF, 0);
+
+	printf("%10s %-15s %12s %12s %14s %14s %10s %10s %10s %10s\n", "TIME", "IF_NAME",
+	       "RX_PPS", "TX_PPS", "RX_BPS", "TX_BPS", "RX_DROP/S", "TX_DROP/S", "RX_ERR/S", "TX_ERR/S");
+
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	readSample(prev, netlinkSocket);
+
+	const uint64_t startTime = prev->timestamp;
+
+	for (uint32_t i = 0; samplerParams.count == 0 || i < samplerParams.count; i++) {
+		// Absolute deadlines keep the schedule from drifting by the dump time
+		deadline.tv_nsec += (samplerParams.interval % 1000) * 1000000L;
+		deadline.tv_sec += (samplerParams.interval / 1000) + (deadline.tv_nsec / 1000000000L);
+		deadline.tv_nsec %= 1000000000L;
+
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) != 0);
+
+		readSample(curr, netlinkSocket);
+		printRates(prev, curr, &samplerParams, startTime);
+
+		temp = prev;
+		prev = curr;
+		curr = temp;
+	}
+
+	f668c4bd_free(samplers[0].samples);
+	f668c4bd_free(samplers[1].samples);
+
+	// Close Netlink socket
+	e7173ad4_close(netlinkSocket);
+	e7173ad4_destroyNetlinkSocket(netlinkSocket);
+
+	// Exit with success
+	exit(EXIT_SUCCESS);
+}
+
+// ═════════════════════════ Function Implementations ═════════════════════════
+
+static void printHelp() {
+	c7c88e52_printUsage(USAGE_MSG);
+
+	puts("\nSamples the packet, byte, drop and error rates of every network interface");
+
+	puts(ANSI_BOLD "\nDefault Values:" ANSI_RESET);
+	puts("  Sample interval\t1000 milliseconds");
+	puts("  Sample count\t\tUntil interrupted");
+
+	puts(ANSI_BOLD "\nExamples:" ANSI_RESET);
+	puts("  linkstats -i 250");
+	puts("  linkstats -i 100 -c 50 enp31s0");
+
+	puts(ANSI_BOLD "\nValid Options:\n");
+	puts(ANSI_YELLOW "  -i\t" ANSI_ROMANTIC "Specify the sample interval in milliseconds");
+	puts(ANSI_BOLD ANSI_YELLOW "  -c\t" ANSI_ROMANTIC "Specify the number of samples to print");
+	puts(ANSI_BOLD ANSI_YELLOW "  -h\t" ANSI_ROMANTIC "Print this help message\n");
+}
+
+static void storeSample(void *context, NetlinkMessageHeader *msgHeader) {
+	LinkSampler *sampler = context;
+	NetlinkInfoMessage *infoMessage = (NetlinkInfoMessage *) NLMSG_DATA(msgHeader);
+	NetlinkAttribute *attribute = (NetlinkAttribute *) IFLA_RTA(infoMessage);
+	int attributeLen = IFLA_PAYLOAD(msgHeader);
+	const uint32_t index = infoMessage->ifi_index;
+	register LinkSample *sample;
+	size_t dataLen;
+
+	if (index >= sampler->size) {
+		uint32_t size = (sampler->size == 0) ? DEFAULT_NUM_SLOTS : sampler->size;
+
+		while (size <= index) {
+			size <<= 1;
+		}
+
+		sampler->samples = f668c4bd_realloc(sampler->samples, sizeof(LinkSample) * sampler->size, sizeof(LinkSample) * size);
+		f668c4bd_meminit(&sampler->samples[sampler->size], sizeof(LinkSample) * (size - sampler->size));
+		sampler->size = size;
+	}
+
+	sample = &sampler->samples[index];
+	sample->index = index;
+
+	for (; RTA_OK(attribute, attributeLen); attribute = RTA_NEXT(attribute, attributeLen)) {
+		dataLen = RTA_PAYLOAD(attribute);
+
+		if (attribute->rta_type == IFLA_IFNAME) {
+			dataLen = (dataLen < IFNAMSIZ) ? dataLen : IFNAMSIZ - 1;
+			f668c4bd_memcopy(RTA_DATA(attribute), sample->name, dataLen);
+			sample->name[dataLen] = '\0';
+		} else if (attribute->rta_type == IFLA_STATS64) {
+			dataLen = (dataLen < sizeof(LinkCounters)) ? dataLen : sizeof(LinkCounters);
+			f668c4bd_memcopy(RTA_DATA(attribute), &sample->counters, dataLen);
+		}
+	}
+}
+
+static void readSample(LinkSampler *sampler, NetlinkSocket *netlinkSocket) {
+	NetlinkInfoRequest request;
+	int errorNumber;
+
+	f668c4bd_meminit(sampler->samples, sizeof(LinkSample) * sampler->size);
+
+	// One dump returns the IFLA_STATS64 block of every interface
+	e7173ad4_initNetlinkInfoRequest(&request, 0);
+	request.msgBody.ifi_change = 0;
+	request.msgHeader.nlmsg_seq = ++sampler->sequence;
+
+	errorNumber = e7173ad4_processRequest(netlinkSocket, &request.msgHeader, NLM_F_REQUEST | NLM_F_DUMP, storeSample, sampler);
+
+	if (errorNumber != 0) {
+		c7c88e52_printLibError("Netlink link dump failed", errorNumber);
+		exit(EXIT_FAILURE);
+	}
+
+	sampler->timestamp = d2468f3c_getTimestamp();
+}
+
+static void printRates(const LinkSampler *prev, const LinkSampler *curr, const SamplerParams *samplerParams, const uint64_t startTime) {
+	const double elapsed = (curr->timestamp - prev->timestamp) / 1e9;
+	const double time = (curr->timestamp - startTime) / 1e9;
+	const LinkSample *currSample;
+	LinkCounters delta;
+
+	for (uint32_t i = 1; i < curr->size; i++) {
+		currSample = &curr->samples[i];
+
+		if (currSample->index == 0) {
+			continue;
+		}
+
+		if (samplerParams->deviceName != NULL && strcmp(samplerParams->deviceName, currSample->name) != 0) {
+			continue;
+		}
+
+		// An interface that is new or was recreated has no previous sample to compare
+		if (i >= prev->size || prev->samples[i].index == 0 || strcmp(prev->samples[i].name, currSample->name) != 0) {
+			continue;
+		}
+
+		d2468f3c_delta_uint64(&prev->samples[i].counters.rxPackets, &currSample->counters.rxPackets, &delta.rxPackets, LINK_NUM_COUNTERS);
+
+		printf("%10.3f %-15s %12.0f %12.0f %14.0f %14.0f %10.0f %10.0f %10.0f %10.0f\n", time, currSample->name,
+		       delta.rxPackets / elapsed, delta.txPackets / elapsed,
+		       (delta.rxBytes * 8) / elapsed, (delta.txBytes * 8) / elapsed,
+		       delta.rxDropped / elapsed, delta.txDropped / elapsed,
+		       delta.rxErrors / elapsed, delta.txErrors / elapsed);
+	}
+}
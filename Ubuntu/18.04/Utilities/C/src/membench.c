@@ -0,0 +1,171 @@
+/*
+ * membench.c - DevOpsBroker utility for benchmarking the memory routines
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * Compares f668c4bd_memcopy() and f668c4bd_meminit() against the glibc memcpy()
+ * and memset() for every size class handled by memory.linux.asm. Each size is
+ * run until roughly TARGET_BYTES have been moved and the throughput is
+ * reported in GiB/s.
+ * -----------------------------------------------------------------------------
+ */
+
+// ════════════════════════════ Feature Test Macros ═══════════════════════════
+
+#define _DEFAULT_SOURCE
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <time.h>
+
+#include "org/devopsbroker/lang/error.h"
+#include "org/devopsbroker/lang/integer.h"
+#include "org/devopsbroker/lang/memory.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define TARGET_BYTES (256UL * 1024 * 1024)
+
+#define MAX_BUFFER_SIZE (64UL * 1024 * 1024)
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+typedef void (*CopyFunction)(void *source, void *dest, size_t numBytes);
+
+typedef void (*InitFunction)(void *ptr, size_t size);
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+static const size_t bufferSizes[] = {
+	8, 16, 32, 64, 256, 1024, 4096, 16384, 65536, 262144,
+	1048576, 4194304, 16777216, 67108864
+};
+
+// Called through volatile pointers so the compiler cannot inline them away
+static void *(*volatile memcpyPtr)(void *, const void *, size_t) = memcpy;
+static void *(*volatile memsetPtr)(void *, int, size_t) = memset;
+
+// ════════════════════════════ Function Prototypes ═══════════════════════════
+
+static void libcMemcpy(void *source, void *dest, size_t numBytes);
+
+static void libcMemset(void *ptr, size_t size);
+
+static double benchCopy(CopyFunction copyFunction, char *source, char *dest, size_t numBytes);
+
+static double benchInit(InitFunction initFunction, char *ptr, size_t size);
+
+// ══════════════════════════════════ main() ══════════════════════════════════
+
+int main(int argc, char *argv[]) {
+	uint32_t numSizes = sizeof(bufferSizes) / sizeof(size_t);
+	char *source, *dest;
+
+	if (argc > 2) {
+		c7c88e52_printUsage("membench [NUM_SIZES]");
+		exit(EXIT_FAILURE);
+	}
+
+	if (argc == 2) {
+		uint32_t value = f45efac2_parse_uint32(argv[1]);
+
+		if (value > 0 && value < numSizes) {
+			numSizes = value;
+		}
+	}
+
+	source = f668c4bd_malloc(MAX_BUFFER_SIZE);
+	dest = f668c4bd_malloc(MAX_BUFFER_SIZE);
+
+	// Fault in every page before timing anything
+	memset(source, 0x5A, MAX_BUFFER_SIZE);
+	memset(dest, 0, MAX_BUFFER_SIZE);
+
+	puts("                       GiB/s");
+	puts("      Size     memcopy    memcpy   meminit    memset");
+
+	for (uint32_t i = 0; i < numSizes; i++) {
+		const size_t size = bufferSizes[i];
+
+		printf("%10zu  %10.2f%10.2f%10.2f%10.2f\n", size,
+		       benchCopy(f668c4bd_memcopy, source, dest, size),
+		       benchCopy(libcMemcpy, source, dest, size),
+		       benchInit(f668c4bd_meminit, dest, size),
+		       benchInit(libcMemset, dest, size));
+	}
+
+	free(source);
+	free(dest);
+
+	// Exit with success
+	exit(EXIT_SUCCESS);
+}
+
+// ═════════════════════════ Function Implementations ═════════════════════════
+
+static void libcMemcpy(void *source, void *dest, size_t numBytes) {
+	memcpyPtr(dest, source, numBytes);
+}
+
+static void libcMemset(void *ptr, size_t size) {
+	memsetPtr(ptr, 0, size);
+}
+
+static inline double elapsedSeconds(struct timespec *start, struct timespec *end) {
+	return (end->tv_sec - start->tv_sec) + ((end->tv_nsec - start->tv_nsec) / 1e9);
+}
+
+static double benchCopy(CopyFunction copyFunction, char *source, char *dest, size_t numBytes) {
+	const size_t numIterations = (TARGET_BYTES / numBytes) + 1;
+	struct timespec start, end;
+
+	// Warm up the caches and the size class dispatch
+	copyFunction(source, dest, numBytes);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (size_t i = 0; i < numIterations; i++) {
+		copyFunction(source, dest, numBytes);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	return (numIterations * numBytes) / elapsedSeconds(&start, &end) / (1024.0 * 1024 * 1024);
+}
+
+static double benchInit(InitFunction initFunction, char *ptr, size_t size) {
+	const size_t numIterations = (TARGET_BYTES / size) + 1;
+	struct timespec start, end;
+
+	initFunction(ptr, size);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (size_t i = 0; i < numIterations; i++) {
+		initFunction(ptr, size);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	return (numIterations * size) / elapsedSeconds(&start, &end) / (1024.0 * 1024 * 1024);
+}
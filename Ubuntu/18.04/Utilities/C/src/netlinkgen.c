@@ -0,0 +1,433 @@
+/*
+ * netlinkgen.c - DevOpsBroker utility for generating synthetic Netlink captures
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * Writes RTM_GETLINK, RTM_GETADDR and RTM_GETROUTE dump replies for a synthetic
+ * set of interfaces to a Netlink capture file. Running a utility with
+ * NETLINK_REPLAY set to the file serves it these tables instead of the kernel
+ * tables, so the Netlink parsing code can be benchmarked and tested against
+ * 100k-route tables without root or real interfaces.
+ *
+ * Interface synK has index K and is assigned, per round R starting at zero:
+ *
+ *   10.(K / 256).(K % 256).(R + 1)/24 and fd00:0:0:K::(R + 1)/64
+ *
+ * The first route of each family for synK is the default route through
+ * 10.(K / 256).(K % 256).254 or fd00:0:0:K::fffe; every other route is a host
+ * route through the same gateway.
+ * -----------------------------------------------------------------------------
+ */
+
+// ════════════════════════════ Feature Test Macros ═══════════════════════════
+
+#define _DEFAULT_SOURCE
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+
+#include <net/if.h>
+#include <net/if_arp.h>
+
+#include "org/devopsbroker/io/file.h"
+#include "org/devopsbroker/lang/error.h"
+#include "org/devopsbroker/lang/memory.h"
+#include "org/devopsbroker/lang/stringbuilder.h"
+#include "org/devopsbroker/socket/netlink.h"
+#include "org/devopsbroker/terminal/commandline.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define USAGE_MSG "netlinkgen " ANSI_GOLD "{ -l links | -a addresses | -r routes | -h }" ANSI_YELLOW " FILE"
+
+#define DEFAULT_NUM_LINKS 1000
+
+#define DEFAULT_NUM_ADDRESSES 10000
+
+#define DEFAULT_NUM_ROUTES 100000
+
+#define MAX_NUM_LINKS 65535
+
+#define MAX_ROUNDS 253
+
+// Room for the largest generated message
+#define MAX_MESSAGE_SIZE 256
+
+#ifndef IFF_LOWER_UP
+#define IFF_LOWER_UP 0x10000
+#endif
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+typedef struct GeneratorParams {
+	char *pathName;
+	uint32_t numLinks;
+	uint32_t numAddresses;
+	uint32_t numRoutes;
+	char _padding[4];
+} GeneratorParams;
+
+static_assert(sizeof(GeneratorParams) == 24, "Check your assumptions");
+
+typedef struct DumpWriter {
+	char *buffer;                  // NETLINK_DUMP_SIZE bytes
+	uint32_t length;
+	uint16_t requestType;
+	char _padding[2];
+	int fd;
+	char _padding2[4];
+} DumpWriter;
+
+static_assert(sizeof(DumpWriter) == 24, "Check your assumptions");
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+static void printHelp();
+
+static NetlinkMessageHeader *addMessage(DumpWriter *dumpWriter, uint16_t type, size_t bodyLen);
+
+static void finishDump(DumpWriter *dumpWriter);
+
+static void writeLinks(DumpWriter *dumpWriter, const GeneratorParams *generatorParams);
+
+static void writeAddresses(DumpWriter *dumpWriter, const GeneratorParams *generatorParams);
+
+static void writeRoutes(DumpWriter *dumpWriter, const GeneratorParams *generatorParams);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Possible command-line options:
+ *
+ *   -l -> Number of links
+ *   -a -> Number of addresses
+ *   -r -> Number of routes
+ *   -h -> Help
+ * ----------------------------------------------------------------------------
+ */
+static void processCmdLine(CmdLineParam *cmdLineParm, GeneratorParams *generatorParams) {
+	register int argc = cmdLineParm->argc;
+	register char **argv = cmdLineParm->argv;
+
+	// Perform initializations
+	f668c4bd_meminit(generatorParams, sizeof(GeneratorParams));
+	generatorParams->numLinks = DEFAULT_NUM_LINKS;
+	generatorParams->numAddresses = DEFAULT_NUM_ADDRESSES;
+	generatorParams->numRoutes = DEFAULT_NUM_ROUTES;
+
+	for (int i = 1; i < argc; i++) {
+		if (argv[i][0] == '-') {
+			if (argv[i][1] == 'l') {
+				generatorParams->numLinks = d7ad7024_getUint32(cmdLineParm, "number of links", ++i);
+
+				if (generatorParams->numLinks == 0 || generatorParams->numLinks > MAX_NUM_LINKS) {
+					c7c88e52_invalidValue("number of links", argv[i]);
+					c7c88e52_printUsage(USAGE_MSG);
+					exit(EXIT_FAILURE);
+				}
+			} else if (argv[i][1] == 'a') {
+				generatorParams->numAddresses = d7ad7024_getUint32(cmdLineParm, "number of addresses", ++i);
+			} else if (argv[i][1] == 'r') {
+				generatorParams->numRoutes = d7ad7024_getUint32(cmdLineParm, "number of routes", ++i);
+			} else if (argv[i][1] == 'h') {
+				printHelp();
+				exit(EXIT_SUCCESS);
+			} else {
+				c7c88e52_invalidOption(argv[i]);
+				c7c88e52_printUsage(USAGE_MSG);
+				exit(EXIT_FAILURE);
+			}
+		} else {
+			generatorParams->pathName = argv[i];
+		}
+	}
+
+	if (generatorParams->pathName == NULL) {
+		c7c88e52_missingParam("capture file");
+		c7c88e52_printUsage(USAGE_MSG);
+		exit(EXIT_FAILURE);
+	}
+
+	// Each round gives every link one more address of each family
+	if (((generatorParams->numAddresses + 1) >> 1) > generatorParams->numLinks * MAX_ROUNDS) {
+		c7c88e52_printError_string("Too many addresses for the number of links");
+		exit(EXIT_FAILURE);
+	}
+}
+
+// ══════════════════════════════════ main() ══════════════════════════════════
+
+int main(int argc, char *argv[]) {
+
+	programName = "netlinkgen";
+
+	GeneratorParams generatorParams;
+	CmdLineParam cmdLineParm;
+	DumpWriter dumpWriter;
+
+	d7ad7024_initCmdLineParam(&cmdLineParm, argc, argv, USAGE_MSG);
+	processCmdLine(&cmdLineParm, &generatorParams);
+
+	dumpWriter.buffer = f668c4bd_malloc(NETLINK_DUMP_SIZE);
+	dumpWriter.fd = open(generatorParams.pathName, O_WRONLY|O_CREAT|O_TRUNC|O_CLOEXEC, 0644);
+
+	if (dumpWriter.fd == SYSTEM_ERROR_CODE) {
+		StringBuilder errorMessage;
+		c598a24c_initStringBuilder(&errorMessage);
+
+		c598a24c_append_string(&errorMessage, "Cannot create '");
+		c598a24c_append_string(&errorMessage, generatorParams.pathName);
+		c598a24c_append_char(&errorMessage, '\'');
+
+		c7c88e52_printLibError(errorMessage.buffer, errno);
+		free(errorMessage.buffer);
+		exit(EXIT_FAILURE);
+	}
+
+	writeLinks(&dumpWriter, &generatorParams);
+	writeAddresses(&dumpWriter, &generatorParams);
+	writeRoutes(&dumpWriter, &generatorParams);
+
+	e2f74138_closeFile(dumpWriter.fd, generatorParams.pathName);
+	free(dumpWriter.buffer);
+
+	// Exit with success
+	exit(EXIT_SUCCESS);
+}
+
+// ═════════════════════════ Function Implementations ═════════════════════════
+
+static void printHelp() {
+	c7c88e52_printUsage(USAGE_MSG);
+
+	puts("\nGenerates a synthetic Netlink capture file for NETLINK_REPLAY");
+
+	puts(ANSI_BOLD "\nDefault Values:" ANSI_RESET);
+	puts("  Number of links\t1000");
+	puts("  Number of addresses\t10000");
+	puts("  Number of routes\t100000");
+
+	puts(ANSI_BOLD "\nExamples:" ANSI_RESET);
+	puts("  netlinkgen /tmp/routes.nlcap");
+	puts("  NETLINK_REPLAY=/tmp/routes.nlcap derivesubnet syn42");
+
+	puts(ANSI_BOLD "\nValid Options:\n");
+	puts(ANSI_YELLOW "  -l\t" ANSI_ROMANTIC "Specify the number of links");
+	puts(ANSI_BOLD ANSI_YELLOW "  -a\t" ANSI_ROMANTIC "Specify the number of addresses");
+	puts(ANSI_BOLD ANSI_YELLOW "  -r\t" ANSI_ROMANTIC "Specify the number of routes");
+	puts(ANSI_BOLD ANSI_YELLOW "  -h\t" ANSI_ROMANTIC "Print this help message\n");
+}
+
+static NetlinkMessageHeader *addMessage(DumpWriter *dumpWriter, uint16_t type, size_t bodyLen) {
+	NetlinkMessageHeader *msgHeader;
+
+	// Start a new datagram the way the kernel does once the next message will not fit
+	if (dumpWriter->length + MAX_MESSAGE_SIZE > NETLINK_DUMP_SIZE) {
+		e7173ad4_writeCaptureRecord(dumpWriter->fd, dumpWriter->requestType, dumpWriter->buffer, dumpWriter->length, false);
+		dumpWriter->length = 0;
+	}
+
+	msgHeader = (NetlinkMessageHeader *) (dumpWriter->buffer + dumpWriter->length);
+	f668c4bd_meminit(msgHeader, NLMSG_SPACE(bodyLen));
+
+	msgHeader->nlmsg_len = NLMSG_LENGTH(bodyLen);
+	msgHeader->nlmsg_type = type;
+	msgHeader->nlmsg_flags = NLM_F_MULTI;
+
+	return msgHeader;
+}
+
+static void finishDump(DumpWriter *dumpWriter) {
+	NetlinkMessageHeader *msgHeader;
+
+	if (dumpWriter->length > 0) {
+		e7173ad4_writeCaptureRecord(dumpWriter->fd, dumpWriter->requestType, dumpWriter->buffer, dumpWriter->length, false);
+		dumpWriter->length = 0;
+	}
+
+	// The kernel sends NLMSG_DONE on its own once the dump callback has nothing left
+	msgHeader = addMessage(dumpWriter, NLMSG_DONE, sizeof(int));
+	dumpWriter->length += NLMSG_ALIGN(msgHeader->nlmsg_len);
+
+	e7173ad4_writeCaptureRecord(dumpWriter->fd, dumpWriter->requestType, dumpWriter->buffer, dumpWriter->length, true);
+}
+
+static void writeLinks(DumpWriter *dumpWriter, const GeneratorParams *generatorParams) {
+	NetlinkMessageHeader *msgHeader;
+	NetlinkInfoMessage *infoMessage;
+	char deviceName[IFNAMSIZ];
+	int nameLen;
+
+	dumpWriter->length = 0;
+	dumpWriter->requestType = RTM_GETLINK;
+
+	for (uint32_t index = 1; index <= generatorParams->numLinks; index++) {
+		msgHeader = addMessage(dumpWriter, RTM_NEWLINK, sizeof(NetlinkInfoMessage));
+		infoMessage = (NetlinkInfoMessage *) NLMSG_DATA(msgHeader);
+
+		infoMessage->ifi_family = AF_UNSPEC;
+		infoMessage->ifi_type = ARPHRD_ETHER;
+		infoMessage->ifi_index = index;
+		infoMessage->ifi_flags = IFF_UP | IFF_RUNNING | IFF_LOWER_UP;
+
+		nameLen = snprintf(deviceName, IFNAMSIZ, "syn%u", index);
+		e7173ad4_addAttribute(msgHeader, MAX_MESSAGE_SIZE, IFLA_IFNAME, deviceName, nameLen + 1);
+
+		dumpWriter->length += NLMSG_ALIGN(msgHeader->nlmsg_len);
+	}
+
+	finishDump(dumpWriter);
+}
+
+static void writeAddresses(DumpWriter *dumpWriter, const GeneratorParams *generatorParams) {
+	NetlinkMessageHeader *msgHeader;
+	NetlinkAddressMessage *addrMessage;
+	uint8_t address[16];
+	uint32_t entry, index, round;
+
+	dumpWriter->length = 0;
+	dumpWriter->requestType = RTM_GETADDR;
+
+	for (uint32_t i = 0; i < generatorParams->numAddresses; i++) {
+		entry = i >> 1;
+		index = (entry % generatorParams->numLinks) + 1;
+		round = entry / generatorParams->numLinks;
+
+		msgHeader = addMessage(dumpWriter, RTM_NEWADDR, sizeof(NetlinkAddressMessage));
+		addrMessage = (NetlinkAddressMessage *) NLMSG_DATA(msgHeader);
+
+		addrMessage->ifa_flags = IFA_F_PERMANENT;
+		addrMessage->ifa_scope = RT_SCOPE_UNIVERSE;
+		addrMessage->ifa_index = index;
+		f668c4bd_meminit(address, sizeof(address));
+
+		// Even entries are IPv4 and odd entries are IPv6
+		if ((i & 1) == 0) {
+			addrMessage->ifa_family = AF_INET;
+			addrMessage->ifa_prefixlen = 24;
+
+			address[0] = 10;
+			address[1] = index >> 8;
+			address[2] = index;
+			address[3] = round + 1;
+
+			e7173ad4_addAttribute(msgHeader, MAX_MESSAGE_SIZE, IFA_LOCAL, address, 4);
+			e7173ad4_addAttribute(msgHeader, MAX_MESSAGE_SIZE, IFA_ADDRESS, address, 4);
+		} else {
+			addrMessage->ifa_family = AF_INET6;
+			addrMessage->ifa_prefixlen = 64;
+
+			address[0] = 0xfd;
+			address[6] = index >> 8;
+			address[7] = index;
+			address[15] = round + 1;
+
+			e7173ad4_addAttribute(msgHeader, MAX_MESSAGE_SIZE, IFA_ADDRESS, address, 16);
+		}
+
+		dumpWriter->length += NLMSG_ALIGN(msgHeader->nlmsg_len);
+	}
+
+	finishDump(dumpWriter);
+}
+
+static void writeRoutes(DumpWriter *dumpWriter, const GeneratorParams *generatorParams) {
+	NetlinkMessageHeader *msgHeader;
+	NetlinkRouteMessage *routeMessage;
+	const uint32_t routeTable = RT_TABLE_MAIN;
+	uint8_t destination[16];
+	uint8_t gateway[16];
+	uint32_t entry, index;
+	size_t addressLen;
+
+	dumpWriter->length = 0;
+	dumpWriter->requestType = RTM_GETROUTE;
+
+	for (uint32_t i = 0; i < generatorParams->numRoutes; i++) {
+		entry = i >> 1;
+		index = (entry % generatorParams->numLinks) + 1;
+
+		msgHeader = addMessage(dumpWriter, RTM_NEWROUTE, sizeof(NetlinkRouteMessage));
+		routeMessage = (NetlinkRouteMessage *) NLMSG_DATA(msgHeader);
+
+		routeMessage->rtm_table = RT_TABLE_MAIN;
+		routeMessage->rtm_protocol = RTPROT_BOOT;
+		routeMessage->rtm_scope = RT_SCOPE_UNIVERSE;
+		routeMessage->rtm_type = RTN_UNICAST;
+		f668c4bd_meminit(destination, sizeof(destination));
+		f668c4bd_meminit(gateway, sizeof(gateway));
+
+		// Even entries are IPv4 and odd entries are IPv6
+		if ((i & 1) == 0) {
+			routeMessage->rtm_family = AF_INET;
+			addressLen = 4;
+
+			// Host routes are numbered from 172.16.0.0
+			destination[0] = 172;
+			destination[1] = 16 + (entry >> 16);
+			destination[2] = entry >> 8;
+			destination[3] = entry;
+
+			gateway[0] = 10;
+			gateway[1] = index >> 8;
+			gateway[2] = index;
+			gateway[3] = 254;
+		} else {
+			routeMessage->rtm_family = AF_INET6;
+			addressLen = 16;
+
+			// Host routes are numbered from fd01::
+			destination[0] = 0xfd;
+			destination[1] = 0x01;
+			destination[12] = entry >> 24;
+			destination[13] = entry >> 16;
+			destination[14] = entry >> 8;
+			destination[15] = entry;
+
+			gateway[0] = 0xfd;
+			gateway[6] = index >> 8;
+			gateway[7] = index;
+			gateway[14] = 0xff;
+			gateway[15] = 0xfe;
+		}
+
+		e7173ad4_addAttribute(msgHeader, MAX_MESSAGE_SIZE, RTA_TABLE, &routeTable, sizeof(uint32_t));
+
+		// The first route of each family for every link is its default route
+		if (entry >= generatorParams->numLinks) {
+			routeMessage->rtm_dst_len = addressLen * 8;
+			e7173ad4_addAttribute(msgHeader, MAX_MESSAGE_SIZE, RTA_DST, destination, addressLen);
+		}
+
+		e7173ad4_addAttribute(msgHeader, MAX_MESSAGE_SIZE, RTA_GATEWAY, gateway, addressLen);
+		e7173ad4_addAttribute(msgHeader, MAX_MESSAGE_SIZE, RTA_OIF, &index, sizeof(uint32_t));
+
+		dumpWriter->length += NLMSG_ALIGN(msgHeader->nlmsg_len);
+	}
+
+	finishDump(dumpWriter);
+}
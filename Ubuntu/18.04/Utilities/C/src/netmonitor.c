@@ -0,0 +1,402 @@
+/*
+ * netmonitor.c - DevOpsBroker utility for running tuning hooks on network changes
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * Subscribes to the rtnetlink link, address and route multicast groups and
+ * keeps a NetlinkSnapshot of every interface. Events are only used as a signal
+ * that something may have changed: once a burst of events settles, one dump
+ * is taken and compared against the previous snapshot, and a hook is run for
+ * each interface whose link state, addresses or gateways actually differ.
+ *
+ * Each hook is invoked as:
+ *   HOOK IF_NAME { link | address | route }
+ * -----------------------------------------------------------------------------
+ */
+
+// ════════════════════════════ Feature Test Macros ═══════════════════════════
+
+#define _DEFAULT_SOURCE
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <assert.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include "org/devopsbroker/lang/error.h"
+#include "org/devopsbroker/lang/memory.h"
+#include "org/devopsbroker/lang/system.h"
+#include "org/devopsbroker/net/netlinksnapshot.h"
+#include "org/devopsbroker/net/networkdevice.h"
+#include "org/devopsbroker/socket/netlink.h"
+#include "org/devopsbroker/socket/socket.h"
+#include "org/devopsbroker/terminal/commandline.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define USAGE_MSG "netmonitor " ANSI_GOLD "{ -l hook | -a hook | -r hook | -d delay | -h }"
+
+#define DEFAULT_SETTLE_DELAY 250
+
+#define EVENT_RECV_BUF_SIZE (1024 * 1024)
+
+#define MONITOR_GROUPS (RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR | RTMGRP_IPV4_ROUTE | RTMGRP_IPV6_ROUTE)
+
+// Defined by <linux/if.h>, which cannot be included alongside <net/if.h>
+#ifndef IFF_LOWER_UP
+#define IFF_LOWER_UP 0x10000
+#endif
+
+// Link flags that matter for tuning; IFF_PROMISC and friends are ignored
+#define LINK_STATE_FLAGS (IFF_UP | IFF_RUNNING | IFF_LOWER_UP)
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+typedef enum NetworkChange {
+	LINK_CHANGE = 1,
+	ADDRESS_CHANGE = 2,
+	ROUTE_CHANGE = 4
+} NetworkChange;
+
+typedef struct MonitorParams {
+	char *linkHook;
+	char *addressHook;
+	char *routeHook;
+	uint32_t settleDelay;         // Milliseconds to wait for a burst to end
+	char _padding[4];
+} MonitorParams;
+
+static_assert(sizeof(MonitorParams) == 32, "Check your assumptions");
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+static volatile sig_atomic_t running = 1;
+
+// Stands in for an interface that is missing from one of the snapshots
+static const NetworkDevice missingDevice;
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+static void printHelp();
+
+static void stopMonitor(int signalNumber);
+
+static NetlinkSocket *openNetlinkSocket(size_t bufSize, uint32_t groups);
+
+static bool waitForEvent(int fd, int timeout);
+
+static void drainEvents(NetlinkSocket *eventSocket);
+
+static uint32_t compareNetworkDevice(const NetworkDevice *prev, const NetworkDevice *curr);
+
+static void runHook(const char *hook, const char *deviceName, const char *changeType);
+
+static void processChanges(const NetlinkSnapshot *prev, const NetlinkSnapshot *curr, const MonitorParams *monitorParams);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Possible command-line options:
+ *
+ *   -l -> Link state hook
+ *   -a -> Address hook
+ *   -r -> Route hook
+ *   -d -> Settle delay
+ *   -h -> Help
+ * ----------------------------------------------------------------------------
+ */
+static void processCmdLine(CmdLineParam *cmdLineParm, MonitorParams *monitorParams) {
+	register int argc = cmdLineParm->argc;
+	register char **argv = cmdLineParm->argv;
+
+	// Perform initializations
+	f668c4bd_meminit(monitorParams, sizeof(MonitorParams));
+	monitorParams->settleDelay = DEFAULT_SETTLE_DELAY;
+
+	for (int i = 1; i < argc; i++) {
+		if (argv[i][0] == '-') {
+			if (argv[i][1] == 'l') {
+				monitorParams->linkHook = d7ad7024_getString(cmdLineParm, "link hook", i++);
+			} else if (argv[i][1] == 'a') {
+				monitorParams->addressHook = d7ad7024_getString(cmdLineParm, "address hook", i++);
+			} else if (argv[i][1] == 'r') {
+				monitorParams->routeHook = d7ad7024_getString(cmdLineParm, "route hook", i++);
+			} else if (argv[i][1] == 'd') {
+				monitorParams->settleDelay = d7ad7024_getUint32(cmdLineParm, "settle delay", ++i);
+			} else if (argv[i][1] == 'h') {
+				printHelp();
+				exit(EXIT_SUCCESS);
+			} else {
+				c7c88e52_invalidOption(argv[i]);
+				c7c88e52_printUsage(USAGE_MSG);
+				exit(EXIT_FAILURE);
+			}
+		} else {
+			c7c88e52_invalidOption(argv[i]);
+			c7c88e52_printUsage(USAGE_MSG);
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	// Catch a mistyped hook now rather than at the first network change
+	char *hooks[] = { monitorParams->linkHook, monitorParams->addressHook, monitorParams->routeHook };
+
+	for (int i = 0; i < 3; i++) {
+		if (hooks[i] != NULL && access(hooks[i], X_OK) == SYSTEM_ERROR_CODE) {
+			c7c88e52_invalidValue("hook", hooks[i]);
+			exit(EXIT_FAILURE);
+		}
+	}
+}
+
+// ══════════════════════════════════ main() ══════════════════════════════════
+
+int main(int argc, char *argv[]) {
+
+	programName = "netmonitor";
+
+	MonitorParams monitorParams;
+	CmdLineParam cmdLineParm;
+
+	d7ad7024_initCmdLineParam(&cmdLineParm, argc, argv, USAGE_MSG);
+	processCmdLine(&cmdLineParm, &monitorParams);
+
+	NetlinkSnapshot snapshots[2];
+	NetlinkSnapshot *prev = &snapshots[0];
+	NetlinkSnapshot *curr = &snapshots[1];
+	NetlinkSnapshot *temp;
+	struct sigaction action;
+
+	// No SA_RESTART so a signal interrupts poll()
+	f668c4bd_meminit(&action, sizeof(struct sigaction));
+	action.sa_handler = stopMonitor;
+	sigaction(SIGINT, &action, NULL);
+	sigaction(SIGTERM, &action, NULL);
+
+	// Output goes to the journal when run as a service
+	setvbuf(stdout, NULL, _IOLBF, 0);
+
+	// Dump replies and multicast events need separate sockets so they never interleave
+	NetlinkSocket *requestSocket = openNetlinkSocket(NETLINK_DUMP_SIZE, 0);
+	NetlinkSocket *eventSocket = openNetlinkSocket(NETLINK_DUMP_SIZE, MONITOR_GROUPS);
+
+	e15c4841_initNetlinkSnapshot(prev);
+	e15c4841_initNetlinkSnapshot(curr);
+	e15c4841_readNetlinkSnapshot(prev, requestSocket);
+
+	while (running) {
+		if (!waitForEvent(eventSocket->fd, -1)) {
+			continue;
+		}
+
+		// Let the rest of the burst arrive before taking a new snapshot
+		do {
+			drainEvents(eventSocket);
+		} while (running && waitForEvent(eventSocket->fd, monitorParams.settleDelay));
+
+		if (!running) {
+			break;
+		}
+
+		e15c4841_readNetlinkSnapshot(curr, requestSocket);
+		processChanges(prev, curr, &monitorParams);
+
+		temp = prev;
+		prev = curr;
+		curr = temp;
+	}
+
+	e15c4841_cleanUpNetlinkSnapshot(prev);
+	e15c4841_cleanUpNetlinkSnapshot(curr);
+
+	// Close Netlink sockets
+	e7173ad4_close(eventSocket);
+	e7173ad4_destroyNetlinkSocket(eventSocket);
+	e7173ad4_close(requestSocket);
+	e7173ad4_destroyNetlinkSocket(requestSocket);
+
+	// Exit with success
+	exit(EXIT_SUCCESS);
+}
+
+// ═════════════════════════ Function Implementations ═════════════════════════
+
+static void printHelp() {
+	c7c88e52_printUsage(USAGE_MSG);
+
+	puts("\nRuns tuning hooks when the link state, addresses or gateways of an interface change");
+
+	puts(ANSI_BOLD "\nDefault Values:" ANSI_RESET);
+	puts("  Settle delay\t250 milliseconds");
+
+	puts(ANSI_BOLD "\nExamples:" ANSI_RESET);
+	puts("  netmonitor -l /usr/local/sbin/retune-nic -a /usr/local/sbin/refresh-firewall");
+	puts("  netmonitor -r /usr/local/sbin/refresh-routes -d 1000");
+
+	puts(ANSI_BOLD "\nHook Invocation:" ANSI_RESET);
+	puts("  HOOK IF_NAME { link | address | route }");
+
+	puts(ANSI_BOLD "\nValid Options:\n");
+	puts(ANSI_YELLOW "  -l\t" ANSI_ROMANTIC "Run hook when an interface is added, removed, or goes up or down");
+	puts(ANSI_BOLD ANSI_YELLOW "  -a\t" ANSI_ROMANTIC "Run hook when an interface address changes");
+	puts(ANSI_BOLD ANSI_YELLOW "  -r\t" ANSI_ROMANTIC "Run hook when an interface gateway changes");
+	puts(ANSI_BOLD ANSI_YELLOW "  -d\t" ANSI_ROMANTIC "Specify the settle delay in milliseconds");
+	puts(ANSI_BOLD ANSI_YELLOW "  -h\t" ANSI_ROMANTIC "Print this help message\n");
+}
+
+static void stopMonitor(int signalNumber) {
+	running = 0;
+}
+
+static NetlinkSocket *openNetlinkSocket(size_t bufSize, uint32_t groups) {
+	NetlinkSocket *netlinkSocket = e7173ad4_createNetlinkSocket(NETLINK_ROUTE_ENUM, bufSize);
+
+	// Initialize Netlink socket
+	e7173ad4_open(netlinkSocket);
+	a36b5966_setMaxSendBufferSize(netlinkSocket->fd, NETLINK_BUF_SIZE);
+	a36b5966_setMaxRecvBufferSize(netlinkSocket->fd, (groups == 0) ? NETLINK_BUF_SIZE : EVENT_RECV_BUF_SIZE);
+	e7173ad4_setExtendedACKReporting(netlinkSocket, true);
+
+	// Bind Netlink socket
+	netlinkSocket->addr.nl_groups = groups;
+	e7173ad4_bind(netlinkSocket);
+
+	return netlinkSocket;
+}
+
+static bool waitForEvent(int fd, int timeout) {
+	struct pollfd pollFd = { .fd = fd, .events = POLLIN };
+	int status = poll(&pollFd, 1, timeout);
+
+	if (status == SYSTEM_ERROR_CODE) {
+		if (errno == EINTR) {
+			return false;
+		}
+
+		c7c88e52_printLibError("Cannot poll Netlink socket", errno);
+		exit(EXIT_FAILURE);
+	}
+
+	return (status > 0);
+}
+
+static void drainEvents(NetlinkSocket *eventSocket) {
+	IOBuffer *ioBuffer = eventSocket->ioBuffer;
+	ssize_t msgLen;
+
+	// The contents are not needed since the next snapshot is taken from a dump
+	while (true) {
+		msgLen = recv(eventSocket->fd, ioBuffer->iov_base, ioBuffer->iov_len, MSG_DONTWAIT);
+
+		if (msgLen == SYSTEM_ERROR_CODE) {
+			// ENOBUFS only means events were dropped, which the dump makes up for
+			if (errno == EAGAIN || errno == EINTR) {
+				return;
+			} else if (errno != ENOBUFS) {
+				c7c88e52_printLibError("Cannot receive Netlink event", errno);
+				exit(EXIT_FAILURE);
+			}
+		}
+	}
+}
+
+static uint32_t compareNetworkDevice(const NetworkDevice *prev, const NetworkDevice *curr) {
+	uint32_t changes = 0;
+
+	if (prev->index != curr->index || ((prev->flags ^ curr->flags) & LINK_STATE_FLAGS) != 0) {
+		changes |= LINK_CHANGE;
+	}
+
+	if (prev->ipv4Address.address != curr->ipv4Address.address
+	    || prev->ipv4Address.cidrSuffix != curr->ipv4Address.cidrSuffix
+	    || memcmp(&prev->ipv6Global, &curr->ipv6Global, sizeof(IPv6Address)) != 0
+	    || memcmp(&prev->ipv6Local, &curr->ipv6Local, sizeof(IPv6Address)) != 0) {
+		changes |= ADDRESS_CHANGE;
+	}
+
+	if (prev->ipv4Gateway != curr->ipv4Gateway
+	    || memcmp(&prev->ipv6Gateway, &curr->ipv6Gateway, sizeof(IPv6Address)) != 0) {
+		changes |= ROUTE_CHANGE;
+	}
+
+	return changes;
+}
+
+static void runHook(const char *hook, const char *deviceName, const char *changeType) {
+	char *const argv[] = { (char *) hook, (char *) deviceName, (char *) changeType, NULL };
+	pid_t child;
+	int exitStatus;
+
+	printf("%s: %s changed\n", deviceName, changeType);
+
+	if (hook != NULL) {
+		child = c16819a0_trySpawn(hook, argv, NULL);
+
+		// A missing or non-executable hook must not take the daemon down with it
+		if (child == SYSTEM_ERROR_CODE) {
+			fprintf(stderr, "%s: %s hook '%s' could not be started: %s\n", programName, changeType, hook, strerror(errno));
+			return;
+		}
+
+		exitStatus = c16819a0_waitForExitStatus(child);
+
+		if (exitStatus != 0) {
+			fprintf(stderr, "%s: %s hook '%s' exited with status %d\n", programName, changeType, hook, exitStatus);
+		}
+	}
+}
+
+static void processChanges(const NetlinkSnapshot *prev, const NetlinkSnapshot *curr, const MonitorParams *monitorParams) {
+	const uint32_t size = (prev->size > curr->size) ? prev->size : curr->size;
+	const NetworkDevice *prevDevice;
+	const NetworkDevice *currDevice;
+	const char *deviceName;
+	uint32_t changes;
+
+	for (uint32_t i = 1; i < size; i++) {
+		prevDevice = e15c4841_getNetworkDevice(prev, i);
+		currDevice = e15c4841_getNetworkDevice(curr, i);
+
+		if (prevDevice == NULL && currDevice == NULL) {
+			continue;
+		}
+
+		deviceName = (currDevice != NULL) ? currDevice->name : prevDevice->name;
+		changes = compareNetworkDevice((prevDevice != NULL) ? prevDevice : &missingDevice,
+		                               (currDevice != NULL) ? currDevice : &missingDevice);
+
+		if (changes & LINK_CHANGE) {
+			runHook(monitorParams->linkHook, deviceName, "link");
+		}
+
+		if (changes & ADDRESS_CHANGE) {
+			runHook(monitorParams->addressHook, deviceName, "address");
+		}
+
+		if (changes & ROUTE_CHANGE) {
+			runHook(monitorParams->routeHook, deviceName, "route");
+		}
+	}
+}
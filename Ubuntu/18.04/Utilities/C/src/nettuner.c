@@ -74,11 +74,13 @@
 #include <unistd.h>
 
 #include "org/devopsbroker/info/systeminfo.h"
+#include "org/devopsbroker/io/file.h"
 #include "org/devopsbroker/lang/error.h"
 #include "org/devopsbroker/lang/float.h"
 #include "org/devopsbroker/lang/integer.h"
 #include "org/devopsbroker/lang/memory.h"
 #include "org/devopsbroker/lang/string.h"
+#include "org/devopsbroker/lang/stringbuilder.h"
 #include "org/devopsbroker/net/ethernet.h"
 #include "org/devopsbroker/socket/ipv4.h"
 #include "org/devopsbroker/terminal/commandline.h"
@@ -570,160 +572,166 @@ static void generateNetworkManagerTuningScript(char * deviceName, EthtoolSetting
 }
 
 void printNetworkKernelTuningConfig(SysctlSettings *sysctlSettings) {
-	puts(  "# Set Default Queuing Discipline");
-	puts(  "net.core.default_qdisc = pfifo_fast\n");
+	StringBuilder config;
+	c598a24c_initStringBuilder_uint32(&config, 8192);
 
-	puts(  "# Optimize Maximum Number of Queued Incoming Packets");
-	printf("net.core.netdev_max_backlog = %u\n\n", sysctlSettings->netdev_max_backlog);
+	c598a24c_append_string(&config, "# Set Default Queuing Discipline\n");
+	c598a24c_append_string(&config, "net.core.default_qdisc = pfifo_fast\n\n");
 
-	puts(  "# Optimize Maximum Amount of Option Memory Buffers");
-	printf("net.core.optmem_max = %u\n\n", sysctlSettings->optmem_max);
+	c598a24c_append_string(&config, "# Optimize Maximum Number of Queued Incoming Packets\n");
+	c598a24c_append_format(&config, "net.core.netdev_max_backlog = %u\n\n", sysctlSettings->netdev_max_backlog);
 
-	puts(  "# Optimize Connection Backlog");
-	printf("net.core.somaxconn = %u\n\n", sysctlSettings->somaxconn);
+	c598a24c_append_string(&config, "# Optimize Maximum Amount of Option Memory Buffers\n");
+	c598a24c_append_format(&config, "net.core.optmem_max = %u\n\n", sysctlSettings->optmem_max);
 
-	puts(  "# Optimize Non-TCP Receive/Send Socket Buffer Size");
-	printf("net.core.rmem_default = %u\n", sysctlSettings->rmem_default);
-	printf("net.core.rmem_max = %u\n", sysctlSettings->rmem_max);
-	printf("net.core.wmem_default = %u\n", sysctlSettings->wmem_default);
-	printf("net.core.wmem_max = %u\n\n", sysctlSettings->wmem_max);
+	c598a24c_append_string(&config, "# Optimize Connection Backlog\n");
+	c598a24c_append_format(&config, "net.core.somaxconn = %u\n\n", sysctlSettings->somaxconn);
 
-	puts(  "# Do not accept source routed packets");
-	puts(  "net.ipv4.conf.all.accept_source_route = 0");
-	puts(  "net.ipv6.conf.all.accept_source_route = 0");
-	puts(  "net.ipv4.conf.default.accept_source_route = 0");
-	puts(  "net.ipv6.conf.default.accept_source_route = 0\n");
+	c598a24c_append_string(&config, "# Optimize Non-TCP Receive/Send Socket Buffer Size\n");
+	c598a24c_append_format(&config, "net.core.rmem_default = %u\n", sysctlSettings->rmem_default);
+	c598a24c_append_format(&config, "net.core.rmem_max = %u\n", sysctlSettings->rmem_max);
+	c598a24c_append_format(&config, "net.core.wmem_default = %u\n", sysctlSettings->wmem_default);
+	c598a24c_append_format(&config, "net.core.wmem_max = %u\n\n", sysctlSettings->wmem_max);
 
-	puts(  "# Do not accept ICMP REDIRECT Messages");
-	puts(  "net.ipv4.conf.all.accept_redirects = 0");
-	puts(  "net.ipv6.conf.all.accept_redirects = 0");
-	puts(  "net.ipv4.conf.default.accept_redirects = 0");
-	puts(  "net.ipv6.conf.default.accept_redirects = 0\n");
+	c598a24c_append_string(&config, "# Do not accept source routed packets\n");
+	c598a24c_append_string(&config, "net.ipv4.conf.all.accept_source_route = 0\n");
+	c598a24c_append_string(&config, "net.ipv6.conf.all.accept_source_route = 0\n");
+	c598a24c_append_string(&config, "net.ipv4.conf.default.accept_source_route = 0\n");
+	c598a24c_append_string(&config, "net.ipv6.conf.default.accept_source_route = 0\n\n");
 
-	puts(  "# Disable logging packets with impossible addresses");
-	puts(  "net.ipv4.conf.all.log_martians = 0");
-	puts(  "net.ipv4.conf.default.log_martians = 0\n");
+	c598a24c_append_string(&config, "# Do not accept ICMP REDIRECT Messages\n");
+	c598a24c_append_string(&config, "net.ipv4.conf.all.accept_redirects = 0\n");
+	c598a24c_append_string(&config, "net.ipv6.conf.all.accept_redirects = 0\n");
+	c598a24c_append_string(&config, "net.ipv4.conf.default.accept_redirects = 0\n");
+	c598a24c_append_string(&config, "net.ipv6.conf.default.accept_redirects = 0\n\n");
 
-	puts(  "# Enable Source Address Verification");
-	puts(  "net.ipv4.conf.all.rp_filter = 1");
-	puts(  "net.ipv4.conf.default.rp_filter = 1\n");
+	c598a24c_append_string(&config, "# Disable logging packets with impossible addresses\n");
+	c598a24c_append_string(&config, "net.ipv4.conf.all.log_martians = 0\n");
+	c598a24c_append_string(&config, "net.ipv4.conf.default.log_martians = 0\n\n");
 
-	puts(  "# Do not send ICMP REDIRECT Messages");
-	puts(  "net.ipv4.conf.all.send_redirects = 0");
-	puts(  "net.ipv4.conf.default.send_redirects = 0\n");
+	c598a24c_append_string(&config, "# Enable Source Address Verification\n");
+	c598a24c_append_string(&config, "net.ipv4.conf.all.rp_filter = 1\n");
+	c598a24c_append_string(&config, "net.ipv4.conf.default.rp_filter = 1\n\n");
 
-	puts(  "# Allow ICMP ECHO Requests (Ping)");
-	puts(  "net.ipv4.icmp_echo_ignore_all = 0\n");
+	c598a24c_append_string(&config, "# Do not send ICMP REDIRECT Messages\n");
+	c598a24c_append_string(&config, "net.ipv4.conf.all.send_redirects = 0\n");
+	c598a24c_append_string(&config, "net.ipv4.conf.default.send_redirects = 0\n\n");
 
-	puts(  "# Drop BROADCAST/MULTICAST ICMP ECHO Requests");
-	puts(  "net.ipv4.icmp_echo_ignore_broadcasts = 1\n");
+	c598a24c_append_string(&config, "# Allow ICMP ECHO Requests (Ping)\n");
+	c598a24c_append_string(&config, "net.ipv4.icmp_echo_ignore_all = 0\n\n");
 
-	puts(  "# Ignore bogus ICMP error responses");
-	puts(  "net.ipv4.icmp_ignore_bogus_error_responses = 1\n");
+	c598a24c_append_string(&config, "# Drop BROADCAST/MULTICAST ICMP ECHO Requests\n");
+	c598a24c_append_string(&config, "net.ipv4.icmp_echo_ignore_broadcasts = 1\n\n");
 
-	puts(  "# Disable IP Forwarding");
-	puts(  "net.ipv4.ip_forward = 0");
-	puts(  "net.ipv4.conf.all.forwarding = 0");
-	puts(  "net.ipv6.conf.all.forwarding = 0");
-	puts(  "net.ipv4.conf.default.forwarding = 0");
-	puts(  "net.ipv6.conf.default.forwarding = 0\n");
+	c598a24c_append_string(&config, "# Ignore bogus ICMP error responses\n");
+	c598a24c_append_string(&config, "net.ipv4.icmp_ignore_bogus_error_responses = 1\n\n");
 
-	puts(  "# Enable Path MTU Discovery if using Jumbo Frames");
-	printf("net.ipv4.ip_no_pmtu_disc = %u\n\n", sysctlSettings->ip_no_pmtu_disc);
+	c598a24c_append_string(&config, "# Disable IP Forwarding\n");
+	c598a24c_append_string(&config, "net.ipv4.ip_forward = 0\n");
+	c598a24c_append_string(&config, "net.ipv4.conf.all.forwarding = 0\n");
+	c598a24c_append_string(&config, "net.ipv6.conf.all.forwarding = 0\n");
+	c598a24c_append_string(&config, "net.ipv4.conf.default.forwarding = 0\n");
+	c598a24c_append_string(&config, "net.ipv6.conf.default.forwarding = 0\n\n");
 
-	puts(  "# Increase the total port range for both TCP and UDP connections");
-	puts(  "net.ipv4.ip_local_port_range = 1500 65001\n");
+	c598a24c_append_string(&config, "# Enable Path MTU Discovery if using Jumbo Frames\n");
+	c598a24c_append_format(&config, "net.ipv4.ip_no_pmtu_disc = %u\n\n", sysctlSettings->ip_no_pmtu_disc);
 
-	puts(  "# Divide socket receive buffer space evenly between TCP window and application");
-	puts(  "net.ipv4.tcp_adv_win_scale = 1\n");
+	c598a24c_append_string(&config, "# Increase the total port range for both TCP and UDP connections\n");
+	c598a24c_append_string(&config, "net.ipv4.ip_local_port_range = 1500 65001\n\n");
 
-	puts(  "# Use TCP-LP Congestion Control Algorithm");
-	puts(  "net.ipv4.tcp_congestion_control = lp\n");
+	c598a24c_append_string(&config, "# Divide socket receive buffer space evenly between TCP window and application\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_adv_win_scale = 1\n\n");
 
-	puts(  "# Enable TCP Explicit Congestion Notification (ECN)");
-	puts(  "net.ipv4.tcp_ecn = 1\n");
+	c598a24c_append_string(&config, "# Use TCP-LP Congestion Control Algorithm\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_congestion_control = lp\n\n");
 
-	puts(  "# Enable TCP Fast Open (TFO)");
-	puts(  "net.ipv4.tcp_fastopen = 3\n");
+	c598a24c_append_string(&config, "# Enable TCP Explicit Congestion Notification (ECN)\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_ecn = 1\n\n");
 
-	puts(  "# Optimize TCP FIN Timeout");
-	puts(  "net.ipv4.tcp_fin_timeout = 20\n");
+	c598a24c_append_string(&config, "# Enable TCP Fast Open (TFO)\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_fastopen = 3\n\n");
 
-	puts(  "# Optimize TCP Keepalive (Detect dead connections after 120s)");
-	puts(  "net.ipv4.tcp_keepalive_time = 60");
-	puts(  "net.ipv4.tcp_keepalive_intvl = 10");
-	puts(  "net.ipv4.tcp_keepalive_probes = 6\n");
+	c598a24c_append_string(&config, "# Optimize TCP FIN Timeout\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_fin_timeout = 20\n\n");
 
-	puts(  "# Disable F-RTO enhanced recovery algorithm (no wireless network)");
-	puts(  "net.ipv4.tcp_frto = 0\n");
+	c598a24c_append_string(&config, "# Optimize TCP Keepalive (Detect dead connections after 120s)\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_keepalive_time = 60\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_keepalive_intvl = 10\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_keepalive_probes = 6\n\n");
 
-	puts(  "# Optimize TCP Limits for Output Bytes on the Device");
-	printf("net.ipv4.tcp_limit_output_bytes = %u\n\n", sysctlSettings->tcp_limit_output_bytes);
+	c598a24c_append_string(&config, "# Disable F-RTO enhanced recovery algorithm (no wireless network)\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_frto = 0\n\n");
 
-	puts(  "# Enable TCP Low Latency");
-	puts(  "net.ipv4.tcp_low_latency = 1\n");
+	c598a24c_append_string(&config, "# Optimize TCP Limits for Output Bytes on the Device\n");
+	c598a24c_append_format(&config, "net.ipv4.tcp_limit_output_bytes = %u\n\n", sysctlSettings->tcp_limit_output_bytes);
 
-	puts(  "# Optimize TCP Max Orphans and TCP Max TIME_WAIT Buckets");
-	printf("net.ipv4.tcp_max_orphans = %u\n", sysctlSettings->tcp_max_orphans);
-	printf("net.ipv4.tcp_max_tw_buckets = %u\n\n", sysctlSettings->tcp_max_tw_buckets);
+	c598a24c_append_string(&config, "# Enable TCP Low Latency\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_low_latency = 1\n\n");
 
-	puts(  "# Enable TCP Receive Buffer Auto-Tuning");
-	puts(  "net.ipv4.tcp_moderate_rcvbuf = 1\n");
+	c598a24c_append_string(&config, "# Optimize TCP Max Orphans and TCP Max TIME_WAIT Buckets\n");
+	c598a24c_append_format(&config, "net.ipv4.tcp_max_orphans = %u\n", sysctlSettings->tcp_max_orphans);
+	c598a24c_append_format(&config, "net.ipv4.tcp_max_tw_buckets = %u\n\n", sysctlSettings->tcp_max_tw_buckets);
 
-	puts(  "# Controls TCP Packetization-Layer Path MTU Discovery");
-	puts(  "net.ipv4.tcp_mtu_probing = 1\n");
+	c598a24c_append_string(&config, "# Enable TCP Receive Buffer Auto-Tuning\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_moderate_rcvbuf = 1\n\n");
 
-	puts(  "# Disable TCP Metrics Cache");
-	puts(  "net.ipv4.tcp_no_metrics_save = 1\n");
+	c598a24c_append_string(&config, "# Controls TCP Packetization-Layer Path MTU Discovery\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_mtu_probing = 1\n\n");
 
-	puts(  "# How may times to retry before killing TCP connection, closed by our side");
-	puts(  "net.ipv4.tcp_orphan_retries = 1\n");
+	c598a24c_append_string(&config, "# Disable TCP Metrics Cache\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_no_metrics_save = 1\n\n");
 
-	puts(  "# Enable TCP Time-Wait Attack Protection");
-	puts(  "net.ipv4.tcp_rfc1337 = 1\n");
+	c598a24c_append_string(&config, "# How may times to retry before killing TCP connection, closed by our side\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_orphan_retries = 1\n\n");
 
-	puts(  "# Enable TCP Select Acknowledgments");
-	puts(  "net.ipv4.tcp_sack = 1");
-	puts(  "net.ipv4.tcp_dsack = 1");
-	puts(  "net.ipv4.tcp_fack = 1\n");
+	c598a24c_append_string(&config, "# Enable TCP Time-Wait Attack Protection\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_rfc1337 = 1\n\n");
 
-	puts(  "# Disable TCP Slow Start After Idle");
-	puts(  "net.ipv4.tcp_slow_start_after_idle = 0\n");
+	c598a24c_append_string(&config, "# Enable TCP Select Acknowledgments\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_sack = 1\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_dsack = 1\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_fack = 1\n\n");
 
-	puts(  "# Enable SYN Flood Attack Protection");
-	printf("net.ipv4.tcp_max_syn_backlog = %u\n", sysctlSettings->tcp_max_syn_backlog);
-	puts(  "net.ipv4.tcp_synack_retries = 2");
-	puts(  "net.ipv4.tcp_syncookies = 1\n");
+	c598a24c_append_string(&config, "# Disable TCP Slow Start After Idle\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_slow_start_after_idle = 0\n\n");
 
-	puts(  "# Optimize TCP SYN Retries");
-	puts(  "net.ipv4.tcp_syn_retries = 2\n");
+	c598a24c_append_string(&config, "# Enable SYN Flood Attack Protection\n");
+	c598a24c_append_format(&config, "net.ipv4.tcp_max_syn_backlog = %u\n", sysctlSettings->tcp_max_syn_backlog);
+	c598a24c_append_string(&config, "net.ipv4.tcp_synack_retries = 2\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_syncookies = 1\n\n");
 
-	puts(  "# Disable IPv4 TCP Timestamps");
-	puts(  "net.ipv4.tcp_timestamps = 0\n");
+	c598a24c_append_string(&config, "# Optimize TCP SYN Retries\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_syn_retries = 2\n\n");
 
-	puts(  "# Enable TCP TIME_WAIT Socket Reuse");
-	puts(  "net.ipv4.tcp_tw_reuse = 1\n");
+	c598a24c_append_string(&config, "# Disable IPv4 TCP Timestamps\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_timestamps = 0\n\n");
 
-	puts(  "# Enable TCP Window Scaling");
-	puts(  "net.ipv4.tcp_window_scaling = 1\n");
+	c598a24c_append_string(&config, "# Enable TCP TIME_WAIT Socket Reuse\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_tw_reuse = 1\n\n");
 
-	puts(  "# Optimize TCP Receive/Send Socket Buffer Size");
-	printf("net.ipv4.tcp_rmem = %u %u %u\n", sysctlSettings->tcp_rmem_min, sysctlSettings->tcp_rmem_default, sysctlSettings->tcp_rmem_max);
-	printf("net.ipv4.tcp_wmem = %u %u %u\n\n", sysctlSettings->tcp_wmem_min, sysctlSettings->tcp_wmem_default, sysctlSettings->tcp_wmem_max);
+	c598a24c_append_string(&config, "# Enable TCP Window Scaling\n");
+	c598a24c_append_string(&config, "net.ipv4.tcp_window_scaling = 1\n\n");
 
-	puts(  "# Optimize UDP Socket Buffer Size");
-	printf("net.ipv4.udp_rmem_min = %u\n", sysctlSettings->udp_rmem_min);
-	printf("net.ipv4.udp_wmem_min = %u\n\n", sysctlSettings->udp_wmem_min);
+	c598a24c_append_string(&config, "# Optimize TCP Receive/Send Socket Buffer Size\n");
+	c598a24c_append_format(&config, "net.ipv4.tcp_rmem = %u %u %u\n", sysctlSettings->tcp_rmem_min, sysctlSettings->tcp_rmem_default, sysctlSettings->tcp_rmem_max);
+	c598a24c_append_format(&config, "net.ipv4.tcp_wmem = %u %u %u\n\n", sysctlSettings->tcp_wmem_min, sysctlSettings->tcp_wmem_default, sysctlSettings->tcp_wmem_max);
 
-	puts(  "# Optimize TCP/UDP Total Buffer Space");
-	printf("net.ipv4.tcp_mem = %u %u %u\n", sysctlSettings->tcp_mem_low, sysctlSettings->tcp_mem_mid, sysctlSettings->tcp_mem_max);
-	printf("net.ipv4.udp_mem = %u %u %u\n\n", sysctlSettings->udp_mem_low, sysctlSettings->udp_mem_mid, sysctlSettings->udp_mem_max);
+	c598a24c_append_string(&config, "# Optimize UDP Socket Buffer Size\n");
+	c598a24c_append_format(&config, "net.ipv4.udp_rmem_min = %u\n", sysctlSettings->udp_rmem_min);
+	c598a24c_append_format(&config, "net.ipv4.udp_wmem_min = %u\n\n", sysctlSettings->udp_wmem_min);
 
-	puts(  "# Set the IPv4 Route Minimum PMTU");
-	puts(  "net.ipv4.route.min_pmtu = 552\n");
+	c598a24c_append_string(&config, "# Optimize TCP/UDP Total Buffer Space\n");
+	c598a24c_append_format(&config, "net.ipv4.tcp_mem = %u %u %u\n", sysctlSettings->tcp_mem_low, sysctlSettings->tcp_mem_mid, sysctlSettings->tcp_mem_max);
+	c598a24c_append_format(&config, "net.ipv4.udp_mem = %u %u %u\n\n", sysctlSettings->udp_mem_low, sysctlSettings->udp_mem_mid, sysctlSettings->udp_mem_max);
 
-	puts(  "# Set the IPv4 Minimum Advertised MSS");
-	puts(  "net.ipv4.route.min_adv_mss = 512");
+	c598a24c_append_string(&config, "# Set the IPv4 Route Minimum PMTU\n");
+	c598a24c_append_string(&config, "net.ipv4.route.min_pmtu = 552\n\n");
+
+	c598a24c_append_string(&config, "# Set the IPv4 Minimum Advertised MSS\n");
+	c598a24c_append_string(&config, "net.ipv4.route.min_adv_mss = 512\n");
+
+	e2f74138_writeFile(STDOUT_FILENO, config.buffer, config.length, "stdout");
+	c598a24c_cleanUpStringBuilder(&config);
 }
 
 static void printHelp() {
@@ -0,0 +1,528 @@
+/*
+ * hashmap.c - DevOpsBroker C source file for providing open-addressing hash maps
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+// ════════════════════════════ Feature Test Macros ═══════════════════════════
+
+#define _DEFAULT_SOURCE
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <emmintrin.h>
+#include <nmmintrin.h>
+
+#include "hashmap.h"
+
+#include "../info/cpuid.h"
+#include "../lang/memory.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define CTRL_EMPTY   ((int8_t) -128)
+#define CTRL_DELETED ((int8_t) -2)
+
+#define HASHMAP_MIN_BUCKETS 16
+
+// Maximum load factor of 7/8
+#define maxLoad(numBuckets) ((numBuckets) - ((numBuckets) >> 3))
+
+#define hashGroup(hash) ((size_t) ((hash) >> 7))
+#define hashTag(hash) ((int8_t) ((hash) & 0x7F))
+
+#define alignSize(size, alignment) (((size) + ((alignment) - 1)) & ~((alignment) - 1))
+
+#define getSlot(hashMap, index) ((hashMap)->slots + ((index) * (hashMap)->slotSize))
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+/*
+ * Static functions in C restrict their scope to the file where they are declared
+ */
+static inline uint32_t matchTag(const int8_t *group, const int8_t tag) {
+	const __m128i ctrl = _mm_loadu_si128((const __m128i *) group);
+
+	return (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(tag)));
+}
+
+static inline uint32_t matchEmpty(const int8_t *group) {
+	return matchTag(group, CTRL_EMPTY);
+}
+
+// EMPTY and DELETED are the only control bytes with the sign bit set
+static inline uint32_t matchEmptyOrDeleted(const int8_t *group) {
+	const __m128i ctrl = _mm_loadu_si128((const __m128i *) group);
+
+	return (uint32_t) _mm_movemask_epi8(ctrl);
+}
+
+static inline void setCtrl(register HashMap *hashMap, const size_t index, const int8_t tag) {
+	const size_t mask = hashMap->numBuckets - 1;
+
+	// The first GROUP_WIDTH - 1 control bytes are mirrored past the end so an
+	// unaligned group load never has to wrap around
+	hashMap->ctrl[index] = tag;
+	hashMap->ctrl[((index - (HASHMAP_GROUP_WIDTH - 1)) & mask) + (HASHMAP_GROUP_WIDTH - 1)] = tag;
+}
+
+static inline bool keysEqual(const HashMap *hashMap, const void *foo, const void *bar) {
+	if (hashMap->equal == NULL) {
+		return memcmp(foo, bar, hashMap->keySize) == 0;
+	}
+
+	return hashMap->equal(foo, bar, hashMap->keySize);
+}
+
+static inline size_t getAllocSize(const size_t numBuckets, const uint32_t slotSize) {
+	return alignSize(numBuckets + HASHMAP_GROUP_WIDTH, (size_t) HASHMAP_GROUP_WIDTH) + (numBuckets * slotSize);
+}
+
+static void freeSlots(register HashMap *hashMap) {
+	if (hashMap->ctrl != NULL) {
+		const size_t allocSize = getAllocSize(hashMap->numBuckets, hashMap->slotSize);
+
+		if (allocSize >= HASHMAP_MAP_THRESHOLD) {
+			f668c4bd_unmapBuffer(hashMap->ctrl, allocSize, MAP_BUFFER_HUGEPAGE);
+		} else {
+			f668c4bd_free(hashMap->ctrl);
+		}
+	}
+}
+
+static void allocSlots(register HashMap *hashMap, const size_t numBuckets) {
+	const size_t allocSize = getAllocSize(numBuckets, hashMap->slotSize);
+	const size_t ctrlSize = numBuckets + HASHMAP_GROUP_WIDTH;
+
+	if (allocSize >= HASHMAP_MAP_THRESHOLD) {
+		hashMap->ctrl = f668c4bd_mapBuffer(allocSize, MAP_BUFFER_HUGEPAGE);
+	} else {
+		hashMap->ctrl = f668c4bd_malloc(allocSize);
+	}
+
+	memset(hashMap->ctrl, CTRL_EMPTY, ctrlSize);
+
+	hashMap->slots = (char *) hashMap->ctrl + alignSize(ctrlSize, (size_t) HASHMAP_GROUP_WIDTH);
+	hashMap->numBuckets = numBuckets;
+	hashMap->growthLeft = maxLoad(numBuckets) - hashMap->length;
+}
+
+/*
+ * Returns the first EMPTY or DELETED slot on the probe sequence of the hash
+ */
+static size_t findInsertSlot(register const HashMap *hashMap, const uint64_t hash) {
+	const size_t mask = hashMap->numBuckets - 1;
+	register size_t position = hashGroup(hash) & mask;
+	register size_t probeStep = 0;
+	register uint32_t matches;
+
+	while (true) {
+		matches = matchEmptyOrDeleted(hashMap->ctrl + position);
+
+		if (matches != 0) {
+			return (position + __builtin_ctz(matches)) & mask;
+		}
+
+		probeStep += HASHMAP_GROUP_WIDTH;
+		position = (position + probeStep) & mask;
+	}
+}
+
+/*
+ * Returns the slot index holding the key, or SIZE_MAX if it is not present
+ */
+static size_t findSlot(register const HashMap *hashMap, const void *key, const uint64_t hash) {
+	const size_t mask = hashMap->numBuckets - 1;
+	const int8_t tag = hashTag(hash);
+	register size_t position = hashGroup(hash) & mask;
+	register size_t probeStep = 0;
+	register uint32_t matches;
+	register size_t index;
+
+	while (true) {
+		const int8_t *group = hashMap->ctrl + position;
+
+		matches = matchTag(group, tag);
+
+		while (matches != 0) {
+			index = (position + __builtin_ctz(matches)) & mask;
+
+			if (keysEqual(hashMap, getSlot(hashMap, index), key)) {
+				return index;
+			}
+
+			matches &= matches - 1;
+		}
+
+		// An EMPTY byte ends the probe sequence of every key that hashes here
+		if (matchEmpty(group) != 0) {
+			return SIZE_MAX;
+		}
+
+		probeStep += HASHMAP_GROUP_WIDTH;
+		position = (position + probeStep) & mask;
+	}
+}
+
+static void rehash(register HashMap *hashMap, const size_t numBuckets) {
+	int8_t *oldCtrl = hashMap->ctrl;
+	char *oldSlots = hashMap->slots;
+	const size_t oldNumBuckets = hashMap->numBuckets;
+	const size_t oldAllocSize = getAllocSize(oldNumBuckets, hashMap->slotSize);
+	register char *slot;
+	register size_t index;
+	uint64_t hash;
+
+	allocSlots(hashMap, numBuckets);
+
+	for (size_t i = 0; i < oldNumBuckets; i++) {
+		if (oldCtrl[i] >= 0) {
+			slot = oldSlots + (i * hashMap->slotSize);
+			hash = hashMap->hash(slot, hashMap->keySize, 0);
+			index = findInsertSlot(hashMap, hash);
+
+			setCtrl(hashMap, index, hashTag(hash));
+			memcpy(getSlot(hashMap, index), slot, hashMap->slotSize);
+		}
+	}
+
+	if (oldCtrl != NULL) {
+		if (oldAllocSize >= HASHMAP_MAP_THRESHOLD) {
+			f668c4bd_unmapBuffer(oldCtrl, oldAllocSize, MAP_BUFFER_HUGEPAGE);
+		} else {
+			f668c4bd_free(oldCtrl);
+		}
+	}
+}
+
+static inline uint64_t wymix(const uint64_t foo, const uint64_t bar) {
+	const __uint128_t product = (__uint128_t) foo * bar;
+
+	return ((uint64_t) product) ^ ((uint64_t) (product >> 64));
+}
+
+static inline uint64_t wyread8(const uint8_t *ptr) {
+	uint64_t value;
+
+	memcpy(&value, ptr, sizeof(uint64_t));
+
+	return value;
+}
+
+static inline uint64_t wyread4(const uint8_t *ptr) {
+	uint32_t value;
+
+	memcpy(&value, ptr, sizeof(uint32_t));
+
+	return value;
+}
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+static const uint64_t wysecret[4] = {
+	0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull
+};
+
+// ═════════════════════════ Function Implementations ═════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Create/Destroy Functions ~~~~~~~~~~~~~~~~~~~~~~~~~
+
+HashMap *c47905f7_createHashMap(const uint32_t keySize, const uint32_t valueSize) {
+	register HashMap *hashMap = f668c4bd_malloc(sizeof(HashMap));
+
+	c47905f7_initHashMap_hash(hashMap, keySize, valueSize, NULL, NULL);
+
+	return hashMap;
+}
+
+void c47905f7_destroyHashMap(HashMap *hashMap) {
+	freeSlots(hashMap);
+	f668c4bd_free(hashMap);
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void c47905f7_cleanUpHashMap(HashMap *hashMap) {
+	freeSlots(hashMap);
+
+	hashMap->ctrl = NULL;
+	hashMap->slots = NULL;
+	hashMap->numBuckets = 0;
+	hashMap->length = 0;
+	hashMap->growthLeft = 0;
+}
+
+void c47905f7_initHashMap(HashMap *hashMap, const uint32_t keySize, const uint32_t valueSize) {
+	c47905f7_initHashMap_hash(hashMap, keySize, valueSize, NULL, NULL);
+}
+
+void c47905f7_initHashMap_hash(HashMap *hashMap, const uint32_t keySize, const uint32_t valueSize, HashFunction hash, KeyEqualFunction equal) {
+	uint32_t valueAlignment = 8;
+
+	// Align the value to its natural alignment, up to eight bytes
+	while (valueAlignment > 1 && (valueSize & (valueAlignment - 1)) != 0) {
+		valueAlignment >>= 1;
+	}
+
+	if (hash == NULL) {
+		hash = c47905f7_wyhash;
+	} else if (hash == c47905f7_crc32c) {
+		CPUID cpuid;
+		f618482d_getProcessorInfo(&cpuid);
+
+		if (!cpuid.hasSSE4_2) {
+			hash = c47905f7_wyhash;
+		}
+	}
+
+	hashMap->ctrl = NULL;
+	hashMap->slots = NULL;
+	hashMap->hash = hash;
+	hashMap->equal = equal;
+	hashMap->numBuckets = 0;
+	hashMap->length = 0;
+	hashMap->growthLeft = 0;
+	hashMap->keySize = keySize;
+	hashMap->valueSize = valueSize;
+	hashMap->valueOffset = alignSize(keySize, valueAlignment);
+	hashMap->slotSize = alignSize(hashMap->valueOffset + valueSize, (keySize >= 8 || valueAlignment == 8) ? 8 : valueAlignment);
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Hash Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+__attribute__((target("sse4.2")))
+uint64_t c47905f7_crc32c(const void *key, const size_t keySize, const uint64_t seed) {
+	register const uint8_t *ptr = key;
+	register size_t length = keySize;
+	register uint64_t crc = (uint32_t) ~seed;
+
+	while (length >= sizeof(uint64_t)) {
+		crc = _mm_crc32_u64(crc, wyread8(ptr));
+		ptr += sizeof(uint64_t);
+		length -= sizeof(uint64_t);
+	}
+
+	if (length >= sizeof(uint32_t)) {
+		crc = _mm_crc32_u32((uint32_t) crc, (uint32_t) wyread4(ptr));
+		ptr += sizeof(uint32_t);
+		length -= sizeof(uint32_t);
+	}
+
+	while (length-- > 0) {
+		crc = _mm_crc32_u8((uint32_t) crc, *ptr++);
+	}
+
+	// Spread the 32-bit CRC across all 64 bits for the group and tag bits
+	return (crc | (crc << 32)) * 0x9e3779b97f4a7c15ull;
+}
+
+uint64_t c47905f7_wyhash(const void *key, const size_t keySize, uint64_t seed) {
+	register const uint8_t *ptr = key;
+	register size_t length = keySize;
+	uint64_t foo, bar;
+
+	seed ^= wymix(seed ^ wysecret[0], wysecret[1]);
+
+	if (length <= 16) {
+		if (length >= 4) {
+			foo = (wyread4(ptr) << 32) | wyread4(ptr + ((length >> 3) << 2));
+			bar = (wyread4(ptr + length - 4) << 32) | wyread4(ptr + length - 4 - ((length >> 3) << 2));
+		} else if (length > 0) {
+			foo = (((uint64_t) ptr[0]) << 16) | (((uint64_t) ptr[length >> 1]) << 8) | ptr[length - 1];
+			bar = 0;
+		} else {
+			foo = bar = 0;
+		}
+	} else {
+		if (length > 48) {
+			uint64_t seed1 = seed, seed2 = seed;
+
+			do {
+				seed = wymix(wyread8(ptr) ^ wysecret[1], wyread8(ptr + 8) ^ seed);
+				seed1 = wymix(wyread8(ptr + 16) ^ wysecret[2], wyread8(ptr + 24) ^ seed1);
+				seed2 = wymix(wyread8(ptr + 32) ^ wysecret[3], wyread8(ptr + 40) ^ seed2);
+				ptr += 48;
+				length -= 48;
+			} while (length > 48);
+
+			seed ^= seed1 ^ seed2;
+		}
+
+		while (length > 16) {
+			seed = wymix(wyread8(ptr) ^ wysecret[1], wyread8(ptr + 8) ^ seed);
+			ptr += 16;
+			length -= 16;
+		}
+
+		foo = wyread8(ptr + length - 16);
+		bar = wyread8(ptr + length - 8);
+	}
+
+	const __uint128_t product = (__uint128_t) (foo ^ wysecret[1]) * (bar ^ seed);
+
+	return wymix(((uint64_t) product) ^ wysecret[0] ^ keySize, ((uint64_t) (product >> 64)) ^ wysecret[1]);
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void c47905f7_clear(register HashMap *hashMap) {
+	if (hashMap->ctrl != NULL) {
+		memset(hashMap->ctrl, CTRL_EMPTY, hashMap->numBuckets + HASHMAP_GROUP_WIDTH);
+
+		hashMap->length = 0;
+		hashMap->growthLeft = maxLoad(hashMap->numBuckets);
+	}
+}
+
+void *c47905f7_emplace(register HashMap *hashMap, const void *key, bool *inserted) {
+	const uint64_t hash = hashMap->hash(key, hashMap->keySize, 0);
+	register size_t index;
+
+	if (hashMap->length > 0) {
+		index = findSlot(hashMap, key, hash);
+
+		if (index != SIZE_MAX) {
+			if (inserted != NULL) {
+				*inserted = false;
+			}
+
+			return getSlot(hashMap, index) + hashMap->valueOffset;
+		}
+	}
+
+	if (hashMap->numBuckets == 0) {
+		allocSlots(hashMap, HASHMAP_MIN_BUCKETS);
+	}
+
+	index = findInsertSlot(hashMap, hash);
+
+	// Reusing a DELETED slot does not consume any growth
+	if (hashMap->ctrl[index] == CTRL_EMPTY) {
+		if (hashMap->growthLeft == 0) {
+			// Reclaim the DELETED slots in place when the table is mostly tombstones
+			const size_t numBuckets = (hashMap->length < (maxLoad(hashMap->numBuckets) >> 1))
+				? hashMap->numBuckets : hashMap->numBuckets << 1;
+
+			rehash(hashMap, numBuckets);
+			index = findInsertSlot(hashMap, hash);
+		}
+
+		hashMap->growthLeft--;
+	}
+
+	setCtrl(hashMap, index, hashTag(hash));
+	memcpy(getSlot(hashMap, index), key, hashMap->keySize);
+	hashMap->length++;
+
+	if (inserted != NULL) {
+		*inserted = true;
+	}
+
+	return getSlot(hashMap, index) + hashMap->valueOffset;
+}
+
+bool c47905f7_erase(register HashMap *hashMap, const void *key) {
+	if (hashMap->length == 0) {
+		return false;
+	}
+
+	const size_t index = findSlot(hashMap, key, hashMap->hash(key, hashMap->keySize, 0));
+
+	if (index == SIZE_MAX) {
+		return false;
+	}
+
+	setCtrl(hashMap, index, CTRL_DELETED);
+	hashMap->length--;
+
+	return true;
+}
+
+void *c47905f7_find(register const HashMap *hashMap, const void *key) {
+	if (hashMap->length == 0) {
+		return NULL;
+	}
+
+	const size_t index = findSlot(hashMap, key, hashMap->hash(key, hashMap->keySize, 0));
+
+	if (index == SIZE_MAX) {
+		return NULL;
+	}
+
+	return getSlot(hashMap, index) + hashMap->valueOffset;
+}
+
+bool c47905f7_nextEntry(register const HashMap *hashMap, size_t *position, void **key, void **value) {
+	register size_t index = *position;
+	register uint32_t matches;
+
+	while (index < hashMap->numBuckets) {
+		// Full slots are the control bytes without the sign bit set
+		matches = ~matchEmptyOrDeleted(hashMap->ctrl + index) & 0xFFFF;
+
+		if (hashMap->numBuckets - index < HASHMAP_GROUP_WIDTH) {
+			matches &= (1U << (hashMap->numBuckets - index)) - 1;
+		}
+
+		if (matches != 0) {
+			index += __builtin_ctz(matches);
+
+			*key = getSlot(hashMap, index);
+			*value = getSlot(hashMap, index) + hashMap->valueOffset;
+			*position = index + 1;
+
+			return true;
+		}
+
+		index += HASHMAP_GROUP_WIDTH;
+	}
+
+	*position = index;
+
+	return false;
+}
+
+bool c47905f7_put(HashMap *hashMap, const void *key, const void *value) {
+	bool inserted;
+	void *entryValue = c47905f7_emplace(hashMap, key, &inserted);
+
+	memcpy(entryValue, value, hashMap->valueSize);
+
+	return inserted;
+}
+
+void c47905f7_reserve(register HashMap *hashMap, const size_t numElements) {
+	register size_t numBuckets = HASHMAP_MIN_BUCKETS;
+
+	while (maxLoad(numBuckets) < numElements) {
+		numBuckets <<= 1;
+	}
+
+	if (numBuckets > hashMap->numBuckets) {
+		rehash(hashMap, numBuckets);
+	}
+}
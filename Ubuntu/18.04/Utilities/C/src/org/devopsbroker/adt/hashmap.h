@@ -0,0 +1,268 @@
+/*
+ * hashmap.h - DevOpsBroker C header file for providing open-addressing hash maps
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * A HashMap stores fixed-size keys and values inline in a single slot array
+ * with one control byte per slot. Control bytes hold either EMPTY, DELETED or
+ * the low seven bits of the key hash, and are probed sixteen at a time with
+ * SSE2 so a lookup usually touches one control group and one slot.
+ *
+ * Keys are compared with memcmp() unless a KeyEqualFunction is supplied, so a
+ * key that is a pointer (such as a char *) needs both a matching HashFunction
+ * and KeyEqualFunction. Tables of two megabytes or more are mapped with
+ * transparent huge pages.
+ *
+ * echo ORG_DEVOPSBROKER_ADT_HASHMAP | md5sum | cut -c 25-32
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef ORG_DEVOPSBROKER_ADT_HASHMAP_H
+#define ORG_DEVOPSBROKER_ADT_HASHMAP_H
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <assert.h>
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define HASHMAP_GROUP_WIDTH 16
+
+#define HASHMAP_MAP_THRESHOLD 2097152
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+typedef uint64_t (*HashFunction)(const void *key, const size_t keySize, const uint64_t seed);
+
+typedef bool (*KeyEqualFunction)(const void *foo, const void *bar, const size_t keySize);
+
+typedef struct HashMap {
+	int8_t *ctrl;
+	char *slots;
+	HashFunction hash;
+	KeyEqualFunction equal;                    // NULL to compare keys with memcmp()
+	size_t numBuckets;
+	size_t length;
+	size_t growthLeft;
+	uint32_t keySize;
+	uint32_t valueSize;
+	uint32_t valueOffset;
+	uint32_t slotSize;
+} HashMap;
+
+static_assert(sizeof(HashMap) == 72, "Check your assumptions");
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Create/Destroy Functions ~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c47905f7_createHashMap
+ * Description: Creates a HashMap struct using wyhash and memcmp() on the keys
+ *
+ * Parameters:
+ *   keySize        The size of each key
+ *   valueSize      The size of each value (may be zero for a set)
+ * Returns:         A HashMap struct instance
+ * ----------------------------------------------------------------------------
+ */
+HashMap *c47905f7_createHashMap(const uint32_t keySize, const uint32_t valueSize);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c47905f7_destroyHashMap
+ * Description: Frees the memory allocated to the HashMap struct pointer
+ *
+ * Parameters:
+ *   hashMap    A pointer to the HashMap instance to destroy
+ * ----------------------------------------------------------------------------
+ */
+void c47905f7_destroyHashMap(HashMap *hashMap);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c47905f7_cleanUpHashMap
+ * Description: Frees the slots owned by the HashMap
+ *
+ * Parameters:
+ *   hashMap    A pointer to the HashMap instance to clean up
+ * ----------------------------------------------------------------------------
+ */
+void c47905f7_cleanUpHashMap(HashMap *hashMap);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c47905f7_initHashMap
+ * Description: Initializes a HashMap struct using wyhash and memcmp() on the keys
+ *        NOTE: No memory is allocated until the first insert or reserve
+ *
+ * Parameters:
+ *   hashMap        A pointer to the HashMap instance to initalize
+ *   keySize        The size of each key
+ *   valueSize      The size of each value (may be zero for a set)
+ * ----------------------------------------------------------------------------
+ */
+void c47905f7_initHashMap(HashMap *hashMap, const uint32_t keySize, const uint32_t valueSize);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c47905f7_initHashMap_hash
+ * Description: Initializes a HashMap struct with the specified hash and key
+ *              equality functions
+ *        NOTE: c47905f7_crc32c falls back to c47905f7_wyhash without SSE4.2
+ *
+ * Parameters:
+ *   hashMap        A pointer to the HashMap instance to initalize
+ *   keySize        The size of each key
+ *   valueSize      The size of each value (may be zero for a set)
+ *   hash           The HashFunction to use (NULL for c47905f7_wyhash)
+ *   equal          The KeyEqualFunction to use (NULL for memcmp())
+ * ----------------------------------------------------------------------------
+ */
+void c47905f7_initHashMap_hash(HashMap *hashMap, const uint32_t keySize, const uint32_t valueSize, HashFunction hash, KeyEqualFunction equal);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Hash Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c47905f7_crc32c
+ * Description: Hashes the key with the SSE4.2 CRC32C instruction
+ *        NOTE: Only call directly when the processor supports SSE4.2
+ *
+ * Parameters:
+ *   key        A pointer to the key to hash
+ *   keySize    The size of the key
+ *   seed       The hash seed
+ * Returns:     The 64-bit hash of the key
+ * ----------------------------------------------------------------------------
+ */
+uint64_t c47905f7_crc32c(const void *key, const size_t keySize, const uint64_t seed);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c47905f7_wyhash
+ * Description: Hashes the key with wyhash
+ *
+ * Parameters:
+ *   key        A pointer to the key to hash
+ *   keySize    The size of the key
+ *   seed       The hash seed
+ * Returns:     The 64-bit hash of the key
+ * ----------------------------------------------------------------------------
+ */
+uint64_t c47905f7_wyhash(const void *key, const size_t keySize, const uint64_t seed);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c47905f7_clear
+ * Description: Removes every entry while keeping the allocated slots
+ *
+ * Parameters:
+ *   hashMap    A pointer to the HashMap instance
+ * ----------------------------------------------------------------------------
+ */
+void c47905f7_clear(HashMap *hashMap);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c47905f7_emplace
+ * Description: Finds the entry for the key, inserting the key if missing
+ *        NOTE: The value of a new entry is uninitialized and the returned
+ *              pointer is invalidated by the next insert
+ *
+ * Parameters:
+ *   hashMap    A pointer to the HashMap instance
+ *   key        A pointer to the key
+ *   inserted   Set to true when the key was inserted (may be NULL)
+ * Returns:     A pointer to the value of the entry
+ * ----------------------------------------------------------------------------
+ */
+void *c47905f7_emplace(HashMap *hashMap, const void *key, bool *inserted);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c47905f7_erase
+ * Description: Removes the entry for the key
+ *
+ * Parameters:
+ *   hashMap    A pointer to the HashMap instance
+ *   key        A pointer to the key
+ * Returns:     True if an entry was removed, false otherwise
+ * ----------------------------------------------------------------------------
+ */
+bool c47905f7_erase(HashMap *hashMap, const void *key);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c47905f7_find
+ * Description: Finds the value for the key
+ *
+ * Parameters:
+ *   hashMap    A pointer to the HashMap instance
+ *   key        A pointer to the key
+ * Returns:     A pointer to the value, or NULL if the key is not present
+ * ----------------------------------------------------------------------------
+ */
+void *c47905f7_find(const HashMap *hashMap, const void *key);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c47905f7_nextEntry
+ * Description: Iterates over the entries in slot order
+ *
+ *   size_t position = 0;
+ *   void *key, *value;
+ *
+ *   while (c47905f7_nextEntry(hashMap, &position, &key, &value)) { ... }
+ *
+ * Parameters:
+ *   hashMap    A pointer to the HashMap instance
+ *   position   The iteration position, starting at zero
+ *   key        Set to the key of the next entry
+ *   value      Set to the value of the next entry
+ * Returns:     True if an entry was found, false at the end of the HashMap
+ * ----------------------------------------------------------------------------
+ */
+bool c47905f7_nextEntry(const HashMap *hashMap, size_t *position, void **key, void **value);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c47905f7_put
+ * Description: Inserts or replaces the value for the key
+ *
+ * Parameters:
+ *   hashMap    A pointer to the HashMap instance
+ *   key        A pointer to the key
+ *   value      A pointer to the value to copy into the entry
+ * Returns:     True if the key was inserted, false if its value was replaced
+ * ----------------------------------------------------------------------------
+ */
+bool c47905f7_put(HashMap *hashMap, const void *key, const void *value);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c47905f7_reserve
+ * Description: Grows the HashMap so it can hold the specified number of entries
+ *              without rehashing
+ *
+ * Parameters:
+ *   hashMap        A pointer to the HashMap instance
+ *   numElements    The number of entries to make room for
+ * ----------------------------------------------------------------------------
+ */
+void c47905f7_reserve(HashMap *hashMap, const size_t numElements);
+
+#endif /* ORG_DEVOPSBROKER_ADT_HASHMAP_H */
@@ -55,6 +55,7 @@ ListArray *b196167f_createListArray() {
 	listArray->values = f668c4bd_malloc(sizeof(void*) * B196167F_DEFAULT_SIZE);
 	listArray->size = B196167F_DEFAULT_SIZE;
 	listArray->length = 0;
+	listArray->arena = NULL;
 
 	return listArray;
 }
@@ -65,12 +66,16 @@ ListArray *b196167f_createListArray_uint32(const uint32_t size) {
 	listArray->values = f668c4bd_malloc(sizeof(void*) * size);
 	listArray->size = size;
 	listArray->length = 0;
+	listArray->arena = NULL;
 
 	return listArray;
 }
 
 void b196167f_destroyListArray(ListArray *listArray) {
-	f668c4bd_free(listArray->values);
+	if (listArray->arena == NULL) {
+		f668c4bd_free(listArray->values);
+	}
+
 	f668c4bd_free(listArray);
 }
 
@@ -80,4 +85,12 @@ void b196167f_initListArray_uint32(ListArray *listArray, const uint32_t size) {
 	listArray->values = f668c4bd_malloc(sizeof(void*) * size);
 	listArray->size = size;
 	listArray->length = 0;
+	listArray->arena = NULL;
+}
+
+void b196167f_initListArray_arena(ListArray *listArray, Arena *arena, const uint32_t size) {
+	listArray->values = eab6f0ff_alloc(arena, sizeof(void*) * size);
+	listArray->size = size;
+	listArray->length = 0;
+	listArray->arena = arena;
 }
@@ -31,6 +31,8 @@
 
 #include <assert.h>
 
+#include "../lang/arena.h"
+
 // ═══════════════════════════════ Preprocessor ═══════════════════════════════
 
 
@@ -40,9 +42,10 @@ typedef struct ListArray {
 	void **values;
 	uint32_t length;
 	uint32_t size;
+	Arena *arena;                              // NULL when the values come from malloc()
 } ListArray;
 
-static_assert(sizeof(ListArray) == 16, "Check your assumptions");
+static_assert(sizeof(ListArray) == 24, "Check your assumptions");
 
 // ═════════════════════════════ Global Variables ═════════════════════════════
 
@@ -114,6 +117,19 @@ void b196167f_initListArray(ListArray *listArray);
  */
 void b196167f_initListArray_uint32(ListArray *listArray, const uint32_t size);
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    b196167f_initListArray_arena
+ * Description: Initializes a ListArray struct whose values are allocated from the Arena
+ *        NOTE: The values are released along with the Arena
+ *
+ * Parameters:
+ *   listArray  A pointer to the ListArray instance to initalize
+ *   arena      The Arena to allocate the values from
+ *   size       The size of the list to allocate
+ * ----------------------------------------------------------------------------
+ */
+void b196167f_initListArray_arena(ListArray *listArray, Arena *arena, const uint32_t size);
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 /* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
@@ -52,6 +52,7 @@ section .bss                ; RESX directives
 
 ; ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ External Resources ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
+extern  eab6f0ff_realloc
 extern  reallocarray
 extern  malloc
 extern  free
@@ -75,12 +76,13 @@ b196167f_add:
 	mov        r8d, [rdi+12]          ; load listArray->size into r8d
 
 .shouldWeResize:
-	cmp        ecx, r8d               ; if (listArray->length <= listArray->size)
-	jbe        .addElement
+	cmp        ecx, r8d               ; if (listArray->length < listArray->size)
+	jb         .addElement
 
 .resize:
 	shl        r8d, 1                 ; listArray->size *= 2
 	mov        [rdi+12], r8d
+	mov        r10d, ecx              ; original listArray->length
 
 	call       resizeArray
 
@@ -107,6 +109,7 @@ b196167f_addAll:
 ;	ecx : original uint32_t numElements value
 ;	r8d : listArray->size
 ;	r9d : newLength
+;	r10d : original listArray->length
 
 .prologue:                            ; functions typically have a prologue
 	test       rsi, rsi               ; if (elementArray == NULL)
@@ -117,8 +120,9 @@ b196167f_addAll:
 
 	mov        ecx, edx               ; move numElements to ecx
 	mov        r9d, edx               ; move numElements to r9d
+	mov        r10d, [rdi+8]          ; load listArray->length into r10d
 	mov        rdx, [rdi]             ; load listArray->values into rdx
-	add        r9d, [rdi+8]           ; newLength = listArray->length + numElements
+	add        r9d, r10d              ; newLength = listArray->length + numElements
 	mov        r8d, [rdi+12]          ; load listArray->size into r8d
 
 .shouldWeResize:
@@ -135,7 +139,7 @@ b196167f_addAll:
 	call       resizeArray
 
 .addElements:
-	mov        rdi, rdx               ; rdi = listArray->values
+	lea        rdi, [rdx + r10*8]     ; rdi = &listArray->values[length]
 	rep movsq                         ; move ecx quadwords from void **elementArray to listArray->values
 
 .epilogue:                            ; functions typically have an epilogue
@@ -207,6 +211,7 @@ b196167f_initListArray:
 	mov        [rdi], rax                     ; listArray->values
 	mov        [rdi+8], dword 0x00            ; listArray->length = 0
 	mov        [rdi+12], dword DEFAULT_SIZE   ; listArray->size = 8
+	mov        [rdi+16], qword 0x00           ; listArray->arena = NULL
 
 .epilogue:                            ; functions typically have an epilogue
 	ret                               ; pop return address from stack and jump there
@@ -226,11 +231,16 @@ resizeArray:
 ;	rdx : listArray->values
 ;	ecx : listArray->length
 ;	r8d : listArray->size
+;	r10d : original listArray->length
 
 	push       rsi                    ; save void *element
 	push       rcx                    ; save listArray->length
 	push       rdi                    ; save ListArray *listArray
-	sub        rsp, 8                 ; align stack frame before calling reallocarray()
+	push       r10                    ; save original listArray->length (also aligns stack frame)
+
+	mov        rax, [rdi+16]          ; if (listArray->arena != NULL)
+	test       rax, rax
+	jnz        .arenaRealloc
 
 	mov        rdi, rdx               ; reallocarray(values, size, sizeof(void*))
 	mov        esi, r8d
@@ -240,7 +250,8 @@ resizeArray:
 	test       rax, rax               ; if (ptr == NULL)
 	jz         .fatalError
 
-	add        rsp, 8                 ; unalign stack frame after calling reallocarray()
+.restore:
+	pop        r10                    ; retrieve original listArray->length
 	pop        rdi                    ; retrieve ListArray *listArray
 	pop        rcx                    ; retrieve listArray->length
 	pop        rsi                    ; retrieve void *element
@@ -250,5 +261,15 @@ resizeArray:
 	mov        rdx, rax               ; rdx = newPtr
 	ret                               ; pop return address from stack and jump there
 
+.arenaRealloc:                        ; eab6f0ff_realloc(arena, values, length * 8, size * 8)
+	mov        rdi, rax
+	mov        rsi, rdx
+	mov        edx, r10d
+	shl        rdx, 3
+	mov        ecx, r8d
+	shl        rcx, 3
+	call       eab6f0ff_realloc WRT ..plt
+	jmp        .restore
+
 .fatalError:
 	call       abort WRT ..plt
@@ -0,0 +1,293 @@
+/*
+ * ring.c - DevOpsBroker C source file for providing lock-free ring buffers
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+// ════════════════════════════ Feature Test Macros ═══════════════════════════
+
+#define _DEFAULT_SOURCE
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ring.h"
+
+#include "../lang/error.h"
+#include "../lang/memory.h"
+#include "../lang/stringbuilder.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+typedef struct RingSlot {
+	_Atomic size_t sequence;
+	char data[];
+} RingSlot;
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+/*
+ * Static functions in C restrict their scope to the file where they are declared
+ */
+static void *allocRing(const size_t size) {
+	void *ptr;
+	int status = posix_memalign(&ptr, RING_CACHE_LINE_SIZE, size);
+
+	if (status != 0) {
+		StringBuilder errorMessage;
+		c598a24c_initStringBuilder(&errorMessage);
+
+		c598a24c_append_string(&errorMessage, "Cannot allocate ring buffer of size '");
+		c598a24c_append_uint64(&errorMessage, size);
+		c598a24c_append_char(&errorMessage, '\'');
+
+		c7c88e52_printLibError(errorMessage.buffer, status);
+		c598a24c_cleanUpStringBuilder(&errorMessage);
+
+		abort();
+	}
+
+	return ptr;
+}
+
+static inline size_t roundCapacity(const size_t capacity) {
+	register size_t roundedCapacity = 2;
+
+	while (roundedCapacity < capacity) {
+		roundedCapacity <<= 1;
+	}
+
+	return roundedCapacity;
+}
+
+static inline RingSlot *getSlot(register const MPSCRing *ring, const size_t position) {
+	return (RingSlot *) (ring->slots + ((position & ring->mask) * ring->slotSize));
+}
+
+/*
+ * Copies numElements between the ring and a flat array in at most two pieces
+ * when the run wraps around the end of the ring
+ */
+static inline void copyIn(register const SPSCRing *ring, const size_t position, const char *elementArray, const size_t numElements) {
+	const size_t index = position & ring->mask;
+	const size_t firstRun = (numElements < ring->capacity - index) ? numElements : ring->capacity - index;
+
+	memcpy(ring->values + (index * ring->elementSize), elementArray, firstRun * ring->elementSize);
+
+	if (firstRun < numElements) {
+		memcpy(ring->values, elementArray + (firstRun * ring->elementSize), (numElements - firstRun) * ring->elementSize);
+	}
+}
+
+static inline void copyOut(register const SPSCRing *ring, const size_t position, char *elementArray, const size_t numElements) {
+	const size_t index = position & ring->mask;
+	const size_t firstRun = (numElements < ring->capacity - index) ? numElements : ring->capacity - index;
+
+	memcpy(elementArray, ring->values + (index * ring->elementSize), firstRun * ring->elementSize);
+
+	if (firstRun < numElements) {
+		memcpy(elementArray + (firstRun * ring->elementSize), ring->values, (numElements - firstRun) * ring->elementSize);
+	}
+}
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═════════════════════════ Function Implementations ═════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void f885459e_cleanUpMPSCRing(MPSCRing *ring) {
+	free(ring->slots);
+	ring->slots = NULL;
+}
+
+void f885459e_cleanUpSPSCRing(SPSCRing *ring) {
+	free(ring->values);
+	ring->values = NULL;
+}
+
+void f885459e_initMPSCRing(MPSCRing *ring, const size_t elementSize, const size_t capacity) {
+	const size_t roundedCapacity = roundCapacity(capacity);
+	register RingSlot *slot;
+
+	ring->head = 0;
+	ring->capacity = roundedCapacity;
+	ring->mask = roundedCapacity - 1;
+	ring->elementSize = elementSize;
+	ring->slotSize = (sizeof(RingSlot) + elementSize + (sizeof(size_t) - 1)) & ~(sizeof(size_t) - 1);
+	ring->slots = allocRing(roundedCapacity * ring->slotSize);
+
+	// A slot is free for the producer claiming position when sequence == position
+	for (size_t i = 0; i < roundedCapacity; i++) {
+		slot = getSlot(ring, i);
+		atomic_init(&slot->sequence, i);
+	}
+
+	atomic_init(&ring->tail, 0);
+	atomic_thread_fence(memory_order_release);
+}
+
+void f885459e_initSPSCRing(SPSCRing *ring, const size_t elementSize, const size_t capacity) {
+	const size_t roundedCapacity = roundCapacity(capacity);
+
+	ring->cachedHead = 0;
+	ring->cachedTail = 0;
+	ring->capacity = roundedCapacity;
+	ring->mask = roundedCapacity - 1;
+	ring->elementSize = elementSize;
+	ring->values = allocRing(roundedCapacity * elementSize);
+
+	atomic_init(&ring->head, 0);
+	atomic_init(&ring->tail, 0);
+	atomic_thread_fence(memory_order_release);
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+bool f885459e_popMPSC(register MPSCRing *ring, void *element) {
+	const size_t position = ring->head;
+	register RingSlot *slot = getSlot(ring, position);
+
+	// The producer that claimed this position has not published it yet
+	if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != position + 1) {
+		return false;
+	}
+
+	memcpy(element, slot->data, ring->elementSize);
+
+	// Hand the slot to the producer that claims it on the next lap
+	atomic_store_explicit(&slot->sequence, position + ring->capacity, memory_order_release);
+	ring->head = position + 1;
+
+	return true;
+}
+
+size_t f885459e_popBatchMPSC(register MPSCRing *ring, void *elementArray, const size_t maxElements) {
+	register char *element = elementArray;
+	register size_t numPopped = 0;
+
+	while (numPopped < maxElements && f885459e_popMPSC(ring, element)) {
+		element += ring->elementSize;
+		numPopped++;
+	}
+
+	return numPopped;
+}
+
+bool f885459e_popSPSC(register SPSCRing *ring, void *element) {
+	return f885459e_popBatchSPSC(ring, element, 1) == 1;
+}
+
+size_t f885459e_popBatchSPSC(register SPSCRing *ring, void *elementArray, const size_t maxElements) {
+	const size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	register size_t numAvailable = ring->cachedTail - head;
+
+	// Only touch the producer cache line when the cached tail looks empty
+	if (numAvailable < maxElements) {
+		ring->cachedTail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+		numAvailable = ring->cachedTail - head;
+
+		if (numAvailable == 0) {
+			return 0;
+		}
+	}
+
+	const size_t numPopped = (numAvailable < maxElements) ? numAvailable : maxElements;
+
+	copyOut(ring, head, elementArray, numPopped);
+	atomic_store_explicit(&ring->head, head + numPopped, memory_order_release);
+
+	return numPopped;
+}
+
+bool f885459e_pushMPSC(register MPSCRing *ring, const void *element) {
+	return f885459e_pushBatchMPSC(ring, element, 1) == 1;
+}
+
+size_t f885459e_pushBatchMPSC(register MPSCRing *ring, const void *elementArray, const size_t numElements) {
+	size_t position = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	register size_t numClaimed = (numElements < ring->capacity) ? numElements : ring->capacity;
+	register const char *element = elementArray;
+	register RingSlot *slot;
+	intptr_t difference;
+
+	while (numClaimed > 0) {
+		// The consumer frees slots in order, so if the last slot of the run is
+		// free for this lap then every slot before it is free as well
+		slot = getSlot(ring, position + numClaimed - 1);
+		difference = (intptr_t) atomic_load_explicit(&slot->sequence, memory_order_acquire) - (intptr_t) (position + numClaimed - 1);
+
+		if (difference == 0) {
+			if (atomic_compare_exchange_weak_explicit(&ring->tail, &position, position + numClaimed, memory_order_relaxed, memory_order_relaxed)) {
+				break;
+			}
+		} else if (difference < 0) {
+			// Not enough room for the whole run so try a shorter one
+			numClaimed >>= 1;
+		} else {
+			// Another producer claimed this position first
+			position = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+		}
+	}
+
+	for (size_t i = 0; i < numClaimed; i++) {
+		slot = getSlot(ring, position + i);
+
+		memcpy(slot->data, element, ring->elementSize);
+		atomic_store_explicit(&slot->sequence, position + i + 1, memory_order_release);
+
+		element += ring->elementSize;
+	}
+
+	return numClaimed;
+}
+
+bool f885459e_pushSPSC(register SPSCRing *ring, const void *element) {
+	return f885459e_pushBatchSPSC(ring, element, 1) == 1;
+}
+
+size_t f885459e_pushBatchSPSC(register SPSCRing *ring, const void *elementArray, const size_t numElements) {
+	const size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	register size_t numFree = ring->capacity - (tail - ring->cachedHead);
+
+	// Only touch the consumer cache line when the cached head looks full
+	if (numFree < numElements) {
+		ring->cachedHead = atomic_load_explicit(&ring->head, memory_order_acquire);
+		numFree = ring->capacity - (tail - ring->cachedHead);
+
+		if (numFree == 0) {
+			return 0;
+		}
+	}
+
+	const size_t numPushed = (numFree < numElements) ? numFree : numElements;
+
+	copyIn(ring, tail, elementArray, numPushed);
+	atomic_store_explicit(&ring->tail, tail + numPushed, memory_order_release);
+
+	return numPushed;
+}
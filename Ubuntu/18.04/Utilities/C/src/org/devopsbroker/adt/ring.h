@@ -0,0 +1,259 @@
+/*
+ * ring.h - DevOpsBroker C header file for providing lock-free ring buffers
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * Bounded lock-free rings for handing fixed-size elements between threads in a
+ * pipeline, e.g. reader -> parser -> aggregator stages pinned to separate cores:
+ *
+ *   o SPSCRing connects exactly one producer thread to one consumer thread.
+ *     The producer and consumer indexes live on separate cache lines and each
+ *     side caches the other's index, so the shared cache lines are only touched
+ *     when the ring looks full or empty
+ *   o MPSCRing accepts any number of producer threads. Each slot carries a
+ *     sequence number that producers claim with compare-and-swap and the
+ *     single consumer releases in order
+ *
+ * Elements are copied in and out of the ring by value. Push and pop never
+ * block; a full or empty ring is reported to the caller, who decides whether
+ * to spin, yield or do other work.
+ *
+ * echo ORG_DEVOPSBROKER_ADT_RING | md5sum | cut -c 25-32
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef ORG_DEVOPSBROKER_ADT_RING_H
+#define ORG_DEVOPSBROKER_ADT_RING_H
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <assert.h>
+#include <stdatomic.h>
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define RING_CACHE_LINE_SIZE 64
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+typedef struct SPSCRing {
+	// Written by the producer
+	_Atomic size_t tail;
+	size_t cachedHead;
+	char _producerPadding[RING_CACHE_LINE_SIZE - (2 * sizeof(size_t))];
+
+	// Written by the consumer
+	_Atomic size_t head;
+	size_t cachedTail;
+	char _consumerPadding[RING_CACHE_LINE_SIZE - (2 * sizeof(size_t))];
+
+	// Read-only after initialization
+	char *values;
+	size_t mask;
+	size_t capacity;
+	size_t elementSize;
+	char _padding[RING_CACHE_LINE_SIZE - (4 * sizeof(size_t))];
+} __attribute__ ((aligned (RING_CACHE_LINE_SIZE))) SPSCRing;
+
+static_assert(sizeof(SPSCRing) == 192, "Check your assumptions");
+
+typedef struct MPSCRing {
+	// Claimed by producers with compare-and-swap
+	_Atomic size_t tail;
+	char _producerPadding[RING_CACHE_LINE_SIZE - sizeof(size_t)];
+
+	// Owned by the single consumer
+	size_t head;
+	char _consumerPadding[RING_CACHE_LINE_SIZE - sizeof(size_t)];
+
+	// Read-only after initialization
+	char *slots;
+	size_t mask;
+	size_t capacity;
+	size_t elementSize;
+	size_t slotSize;
+	char _padding[RING_CACHE_LINE_SIZE - (5 * sizeof(size_t))];
+} __attribute__ ((aligned (RING_CACHE_LINE_SIZE))) MPSCRing;
+
+static_assert(sizeof(MPSCRing) == 192, "Check your assumptions");
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f885459e_cleanUpMPSCRing
+ * Description: Frees the slots owned by the MPSCRing
+ *
+ * Parameters:
+ *   ring         A pointer to the MPSCRing instance to clean up
+ * ----------------------------------------------------------------------------
+ */
+void f885459e_cleanUpMPSCRing(MPSCRing *ring);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f885459e_cleanUpSPSCRing
+ * Description: Frees the values owned by the SPSCRing
+ *
+ * Parameters:
+ *   ring         A pointer to the SPSCRing instance to clean up
+ * ----------------------------------------------------------------------------
+ */
+void f885459e_cleanUpSPSCRing(SPSCRing *ring);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f885459e_initMPSCRing
+ * Description: Initializes an MPSCRing struct for the specified element size
+ *
+ * Parameters:
+ *   ring         A pointer to the MPSCRing instance to initalize
+ *   elementSize  The size of each element
+ *   capacity     The number of elements the ring can hold (rounded up to a power of two)
+ * ----------------------------------------------------------------------------
+ */
+void f885459e_initMPSCRing(MPSCRing *ring, const size_t elementSize, const size_t capacity);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f885459e_initSPSCRing
+ * Description: Initializes an SPSCRing struct for the specified element size
+ *
+ * Parameters:
+ *   ring         A pointer to the SPSCRing instance to initalize
+ *   elementSize  The size of each element
+ *   capacity     The number of elements the ring can hold (rounded up to a power of two)
+ * ----------------------------------------------------------------------------
+ */
+void f885459e_initSPSCRing(SPSCRing *ring, const size_t elementSize, const size_t capacity);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f885459e_popMPSC
+ * Description: Copies the oldest element out of the MPSCRing
+ *        NOTE: Must only be called from the consumer thread
+ *
+ * Parameters:
+ *   ring         A pointer to the MPSCRing instance
+ *   element      A pointer to the memory to copy the element into
+ * Returns:       True if an element was popped, false if the ring is empty
+ * ----------------------------------------------------------------------------
+ */
+bool f885459e_popMPSC(MPSCRing *ring, void *element);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f885459e_popBatchMPSC
+ * Description: Copies up to maxElements of the oldest elements out of the MPSCRing
+ *        NOTE: Must only be called from the consumer thread
+ *
+ * Parameters:
+ *   ring         A pointer to the MPSCRing instance
+ *   elementArray A pointer to the array to copy the elements into
+ *   maxElements  The maximum number of elements to pop
+ * Returns:       The number of elements popped
+ * ----------------------------------------------------------------------------
+ */
+size_t f885459e_popBatchMPSC(MPSCRing *ring, void *elementArray, const size_t maxElements);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f885459e_popSPSC
+ * Description: Copies the oldest element out of the SPSCRing
+ *
+ * Parameters:
+ *   ring         A pointer to the SPSCRing instance
+ *   element      A pointer to the memory to copy the element into
+ * Returns:       True if an element was popped, false if the ring is empty
+ * ----------------------------------------------------------------------------
+ */
+bool f885459e_popSPSC(SPSCRing *ring, void *element);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f885459e_popBatchSPSC
+ * Description: Copies up to maxElements of the oldest elements out of the SPSCRing
+ *              and releases them to the producer with a single store
+ *
+ * Parameters:
+ *   ring         A pointer to the SPSCRing instance
+ *   elementArray A pointer to the array to copy the elements into
+ *   maxElements  The maximum number of elements to pop
+ * Returns:       The number of elements popped
+ * ----------------------------------------------------------------------------
+ */
+size_t f885459e_popBatchSPSC(SPSCRing *ring, void *elementArray, const size_t maxElements);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f885459e_pushMPSC
+ * Description: Copies the element into the MPSCRing
+ *        NOTE: Safe to call from any number of producer threads
+ *
+ * Parameters:
+ *   ring         A pointer to the MPSCRing instance
+ *   element      A pointer to the element to push
+ * Returns:       True if the element was pushed, false if the ring is full
+ * ----------------------------------------------------------------------------
+ */
+bool f885459e_pushMPSC(MPSCRing *ring, const void *element);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f885459e_pushBatchMPSC
+ * Description: Claims a contiguous run of slots with a single compare-and-swap
+ *              and copies up to numElements elements into the MPSCRing
+ *        NOTE: Safe to call from any number of producer threads
+ *
+ * Parameters:
+ *   ring         A pointer to the MPSCRing instance
+ *   elementArray A pointer to the array of elements to push
+ *   numElements  The number of elements to push
+ * Returns:       The number of elements pushed
+ * ----------------------------------------------------------------------------
+ */
+size_t f885459e_pushBatchMPSC(MPSCRing *ring, const void *elementArray, const size_t numElements);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f885459e_pushSPSC
+ * Description: Copies the element into the SPSCRing
+ *
+ * Parameters:
+ *   ring         A pointer to the SPSCRing instance
+ *   element      A pointer to the element to push
+ * Returns:       True if the element was pushed, false if the ring is full
+ * ----------------------------------------------------------------------------
+ */
+bool f885459e_pushSPSC(SPSCRing *ring, const void *element);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f885459e_pushBatchSPSC
+ * Description: Copies up to numElements elements into the SPSCRing and publishes
+ *              them to the consumer with a single store
+ *
+ * Parameters:
+ *   ring         A pointer to the SPSCRing instance
+ *   elementArray A pointer to the array of elements to push
+ *   numElements  The number of elements to push
+ * Returns:       The number of elements pushed
+ * ----------------------------------------------------------------------------
+ */
+size_t f885459e_pushBatchSPSC(SPSCRing *ring, const void *elementArray, const size_t numElements);
+
+#endif /* ORG_DEVOPSBROKER_ADT_RING_H */
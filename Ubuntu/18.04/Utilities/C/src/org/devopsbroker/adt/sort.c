@@ -0,0 +1,437 @@
+/*
+ * sort.c - DevOpsBroker C source file for sorting arrays of elements
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+// ════════════════════════════ Feature Test Macros ═══════════════════════════
+
+#define _DEFAULT_SOURCE
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include "sort.h"
+
+#include "../lang/memory.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define INSERTION_SORT_THRESHOLD 16
+
+#define RADIX_SIZE 256
+
+#define elementAt(array, index, elementSize) (((char *) (array)) + ((index) * (elementSize)))
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+typedef struct SortTask {
+	char *array;
+	char *dest;
+	size_t numElements;
+	size_t midPoint;
+	size_t elementSize;
+	SortCompareFunction compare;
+	pthread_t thread;
+	bool threadStarted;
+} SortTask;
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+/*
+ * Static functions in C restrict their scope to the file where they are declared
+ */
+static inline void swapElements(register char *foo, register char *bar, register size_t elementSize) {
+	register char ch;
+
+	while (elementSize >= sizeof(uint64_t)) {
+		uint64_t value;
+
+		memcpy(&value, foo, sizeof(uint64_t));
+		memcpy(foo, bar, sizeof(uint64_t));
+		memcpy(bar, &value, sizeof(uint64_t));
+
+		foo += sizeof(uint64_t);
+		bar += sizeof(uint64_t);
+		elementSize -= sizeof(uint64_t);
+	}
+
+	while (elementSize-- > 0) {
+		ch = *foo;
+		*foo++ = *bar;
+		*bar++ = ch;
+	}
+}
+
+static void insertionSort(char *array, const size_t numElements, const size_t elementSize, SortCompareFunction compare) {
+	register char *current, *prev;
+
+	for (size_t i = 1; i < numElements; i++) {
+		current = elementAt(array, i, elementSize);
+		prev = current - elementSize;
+
+		while (current > array && compare(prev, current) > 0) {
+			swapElements(prev, current, elementSize);
+			current = prev;
+			prev -= elementSize;
+		}
+	}
+}
+
+static void siftDown(char *array, size_t root, const size_t numElements, const size_t elementSize, SortCompareFunction compare) {
+	register size_t child;
+
+	while ((child = (root << 1) + 1) < numElements) {
+		if (child + 1 < numElements && compare(elementAt(array, child, elementSize), elementAt(array, child + 1, elementSize)) < 0) {
+			child++;
+		}
+
+		if (compare(elementAt(array, root, elementSize), elementAt(array, child, elementSize)) >= 0) {
+			return;
+		}
+
+		swapElements(elementAt(array, root, elementSize), elementAt(array, child, elementSize), elementSize);
+		root = child;
+	}
+}
+
+static void heapSort(char *array, size_t numElements, const size_t elementSize, SortCompareFunction compare) {
+	for (size_t i = numElements >> 1; i-- > 0; ) {
+		siftDown(array, i, numElements, elementSize, compare);
+	}
+
+	while (numElements > 1) {
+		numElements--;
+		swapElements(array, elementAt(array, numElements, elementSize), elementSize);
+		siftDown(array, 0, numElements, elementSize, compare);
+	}
+}
+
+static void introSort(char *array, size_t numElements, const size_t elementSize, SortCompareFunction compare, uint32_t depthLimit) {
+	register char *low, *high, *mid;
+
+	while (numElements > INSERTION_SORT_THRESHOLD) {
+		if (depthLimit-- == 0) {
+			heapSort(array, numElements, elementSize, compare);
+			return;
+		}
+
+		// Median-of-three moves the pivot to the front of the partition
+		low = array;
+		mid = elementAt(array, numElements >> 1, elementSize);
+		high = elementAt(array, numElements - 1, elementSize);
+
+		if (compare(mid, low) < 0) {
+			swapElements(mid, low, elementSize);
+		}
+
+		if (compare(high, mid) < 0) {
+			swapElements(high, mid, elementSize);
+
+			if (compare(mid, low) < 0) {
+				swapElements(mid, low, elementSize);
+			}
+		}
+
+		swapElements(array, mid, elementSize);
+
+		// Hoare partition around the pivot at array[0]
+		low = array;
+		high = elementAt(array, numElements, elementSize);
+
+		while (true) {
+			do {
+				low += elementSize;
+			} while (low < high && compare(low, array) < 0);
+
+			do {
+				high -= elementSize;
+			} while (compare(high, array) > 0);
+
+			if (low >= high) {
+				break;
+			}
+
+			swapElements(low, high, elementSize);
+		}
+
+		swapElements(array, high, elementSize);
+
+		// Recurse into the smaller side to bound the stack depth
+		const size_t numLeft = (high - array) / elementSize;
+		const size_t numRight = numElements - numLeft - 1;
+
+		if (numLeft < numRight) {
+			introSort(array, numLeft, elementSize, compare, depthLimit);
+			array = high + elementSize;
+			numElements = numRight;
+		} else {
+			introSort(high + elementSize, numRight, elementSize, compare, depthLimit);
+			numElements = numLeft;
+		}
+	}
+
+	insertionSort(array, numElements, elementSize, compare);
+}
+
+static inline uint32_t getDepthLimit(size_t numElements) {
+	register uint32_t depthLimit = 0;
+
+	while (numElements > 1) {
+		numElements >>= 1;
+		depthLimit += 2;
+	}
+
+	return depthLimit;
+}
+
+static void mergeRuns(SortTask *task) {
+	register char *left = task->array;
+	register char *right = elementAt(task->array, task->midPoint, task->elementSize);
+	register char *dest = task->dest;
+	char *const leftEnd = right;
+	char *const rightEnd = elementAt(task->array, task->numElements, task->elementSize);
+	const size_t elementSize = task->elementSize;
+
+	while (left < leftEnd && right < rightEnd) {
+		if (task->compare(right, left) < 0) {
+			memcpy(dest, right, elementSize);
+			right += elementSize;
+		} else {
+			memcpy(dest, left, elementSize);
+			left += elementSize;
+		}
+
+		dest += elementSize;
+	}
+
+	if (left < leftEnd) {
+		memcpy(dest, left, leftEnd - left);
+	} else if (right < rightEnd) {
+		memcpy(dest, right, rightEnd - right);
+	}
+}
+
+static void *sortThread(void *arg) {
+	register SortTask *task = arg;
+
+	if (task->dest == NULL) {
+		e9497a6d_introSort(task->array, task->numElements, task->elementSize, task->compare);
+	} else {
+		mergeRuns(task);
+	}
+
+	return NULL;
+}
+
+/*
+ * Runs every task on its own thread, or on the calling thread if a thread
+ * cannot be created
+ */
+static void runSortTasks(SortTask *taskList, const uint32_t numTasks) {
+	register SortTask *task;
+
+	for (uint32_t i = 1; i < numTasks; i++) {
+		task = &taskList[i];
+		task->threadStarted = (pthread_create(&task->thread, NULL, sortThread, task) == 0);
+
+		if (!task->threadStarted) {
+			sortThread(task);
+		}
+	}
+
+	sortThread(&taskList[0]);
+
+	for (uint32_t i = 1; i < numTasks; i++) {
+		if (taskList[i].threadStarted) {
+			pthread_join(taskList[i].thread, NULL);
+		}
+	}
+}
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═════════════════════════ Function Implementations ═════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void e9497a6d_introSort(void *array, const size_t numElements, const size_t elementSize, SortCompareFunction compare) {
+	if (numElements > 1) {
+		introSort(array, numElements, elementSize, compare, getDepthLimit(numElements));
+	}
+}
+
+void e9497a6d_parallelSort(void *array, const size_t numElements, const size_t elementSize, SortCompareFunction compare, uint32_t numThreads) {
+	if (numThreads == 0) {
+		const long numCPUs = sysconf(_SC_NPROCESSORS_ONLN);
+		numThreads = (numCPUs > 0) ? (uint32_t) numCPUs : 1;
+	}
+
+	// Every chunk should be large enough to be worth a thread
+	while (numThreads > 1 && (numElements / numThreads) < (SORT_PARALLEL_THRESHOLD >> 2)) {
+		numThreads >>= 1;
+	}
+
+	if (numThreads <= 1 || numElements < SORT_PARALLEL_THRESHOLD) {
+		e9497a6d_introSort(array, numElements, elementSize, compare);
+		return;
+	}
+
+	SortTask *taskList = f668c4bd_malloc_size_size(sizeof(SortTask), numThreads);
+	char *scratch = f668c4bd_malloc_size_size(elementSize, numElements);
+	char *source = array;
+	char *dest = scratch;
+	char *swap;
+
+	// 1. Sort one chunk per thread in place
+	const size_t chunkSize = (numElements + numThreads - 1) / numThreads;
+	uint32_t numRuns = 0;
+
+	for (size_t start = 0; start < numElements; start += chunkSize) {
+		taskList[numRuns].array = elementAt(source, start, elementSize);
+		taskList[numRuns].dest = NULL;
+		taskList[numRuns].numElements = (numElements - start < chunkSize) ? numElements - start : chunkSize;
+		taskList[numRuns].elementSize = elementSize;
+		taskList[numRuns].compare = compare;
+		numRuns++;
+	}
+
+	runSortTasks(taskList, numRuns);
+
+	// 2. Merge adjacent runs in parallel, ping-ponging between the two buffers
+	for (size_t runSize = chunkSize; runSize < numElements; runSize <<= 1) {
+		uint32_t numTasks = 0;
+
+		for (size_t start = 0; start < numElements; start += (runSize << 1)) {
+			const size_t remaining = numElements - start;
+
+			taskList[numTasks].array = elementAt(source, start, elementSize);
+			taskList[numTasks].dest = elementAt(dest, start, elementSize);
+			taskList[numTasks].numElements = (remaining < (runSize << 1)) ? remaining : (runSize << 1);
+			taskList[numTasks].midPoint = (remaining < runSize) ? remaining : runSize;
+			taskList[numTasks].elementSize = elementSize;
+			taskList[numTasks].compare = compare;
+			numTasks++;
+		}
+
+		runSortTasks(taskList, numTasks);
+
+		swap = source;
+		source = dest;
+		dest = swap;
+	}
+
+	if (source != array) {
+		f668c4bd_memcopy(source, array, numElements * elementSize);
+	}
+
+	f668c4bd_free(scratch);
+	f668c4bd_free(taskList);
+}
+
+void e9497a6d_radixSort(void *array, const size_t numElements, const size_t elementSize, const size_t keyOffset, const uint32_t keySize, const SortOption options) {
+	if (numElements <= 1 || keySize == 0 || keySize > SORT_MAX_KEY_SIZE) {
+		return;
+	}
+
+	size_t (*countList)[RADIX_SIZE] = f668c4bd_malloc_size_size(sizeof(size_t) * RADIX_SIZE, keySize);
+	char *scratch = f668c4bd_malloc_size_size(elementSize, numElements);
+	const uint8_t flipMask = (options & SORT_DESCENDING) ? 0xFF : 0x00;
+	register const uint8_t *key;
+	char *source = array;
+	char *dest = scratch;
+	char *swap;
+
+	f668c4bd_meminit(countList, sizeof(size_t) * RADIX_SIZE * keySize);
+
+	// 1. Build the histogram for every key byte in a single pass
+	for (size_t i = 0; i < numElements; i++) {
+		key = (const uint8_t *) elementAt(source, i, elementSize) + keyOffset;
+
+		for (uint32_t byte = 0; byte < keySize; byte++) {
+			countList[byte][key[byte] ^ flipMask]++;
+		}
+	}
+
+	// 2. Scatter from the least significant byte to the most significant byte
+	for (uint32_t pass = 0; pass < keySize; pass++) {
+		const uint32_t byte = (options & SORT_NETWORK_ORDER) ? (keySize - 1 - pass) : pass;
+		register size_t *counts = countList[byte];
+		register size_t offset = 0;
+		register size_t count;
+		bool skipPass = false;
+
+		// Every key shares this byte so the order would not change
+		for (uint32_t digit = 0; digit < RADIX_SIZE; digit++) {
+			if (counts[digit] == numElements) {
+				skipPass = true;
+				break;
+			}
+
+			if (counts[digit] != 0) {
+				break;
+			}
+		}
+
+		if (skipPass) {
+			continue;
+		}
+
+		for (uint32_t digit = 0; digit < RADIX_SIZE; digit++) {
+			count = counts[digit];
+			counts[digit] = offset;
+			offset += count;
+		}
+
+		for (size_t i = 0; i < numElements; i++) {
+			const char *element = elementAt(source, i, elementSize);
+			const uint8_t digit = ((const uint8_t *) element)[keyOffset + byte] ^ flipMask;
+
+			memcpy(elementAt(dest, counts[digit]++, elementSize), element, elementSize);
+		}
+
+		swap = source;
+		source = dest;
+		dest = swap;
+	}
+
+	if (source != array) {
+		f668c4bd_memcopy(source, array, numElements * elementSize);
+	}
+
+	f668c4bd_free(scratch);
+	f668c4bd_free(countList);
+}
+
+void e9497a6d_radixSort_uint32(uint32_t *array, const size_t numElements) {
+	e9497a6d_radixSort(array, numElements, sizeof(uint32_t), 0, sizeof(uint32_t), SORT_ASCENDING);
+}
+
+void e9497a6d_radixSort_uint64(uint64_t *array, const size_t numElements) {
+	e9497a6d_radixSort(array, numElements, sizeof(uint64_t), 0, sizeof(uint64_t), SORT_ASCENDING);
+}
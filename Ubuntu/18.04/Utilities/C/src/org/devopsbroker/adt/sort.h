@@ -0,0 +1,134 @@
+/*
+ * sort.h - DevOpsBroker C header file for sorting arrays of elements
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * Three sorting strategies are provided for arrays of fixed-size elements:
+ *
+ *   o e9497a6d_radixSort() is a stable LSD radix sort on an unsigned integer
+ *     key embedded in each element (counts, ports, binary IPv4/IPv6 addresses)
+ *     and runs in O(n) per key byte, skipping bytes shared by every key
+ *   o e9497a6d_introSort() is an in-place comparison sort for everything else
+ *     that falls back to heapsort to guarantee O(n log n)
+ *   o e9497a6d_parallelSort() introsorts one chunk per thread and merges the
+ *     sorted chunks pairwise in parallel for large arrays
+ *
+ * echo ORG_DEVOPSBROKER_ADT_SORT | md5sum | cut -c 25-32
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef ORG_DEVOPSBROKER_ADT_SORT_H
+#define ORG_DEVOPSBROKER_ADT_SORT_H
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define SORT_MAX_KEY_SIZE 16
+
+#define SORT_PARALLEL_THRESHOLD 65536
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+typedef enum SortOption {
+	SORT_ASCENDING = 0x00,
+	SORT_DESCENDING = 0x01,
+	SORT_NETWORK_ORDER = 0x02          // Key bytes are big-endian, like in6_addr
+} SortOption;
+
+typedef int (*SortCompareFunction)(const void *foo, const void *bar);
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e9497a6d_introSort
+ * Description: Sorts the array in place with an introspective quicksort
+ *        NOTE: The sort is not stable
+ *
+ * Parameters:
+ *   array          The array of elements to sort
+ *   numElements    The number of elements in the array
+ *   elementSize    The size of each element
+ *   compare        Returns <0, 0, >0 when foo sorts before, with or after bar
+ * ----------------------------------------------------------------------------
+ */
+void e9497a6d_introSort(void *array, const size_t numElements, const size_t elementSize, SortCompareFunction compare);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e9497a6d_parallelSort
+ * Description: Sorts the array using up to numThreads threads, falling back to
+ *              e9497a6d_introSort() below SORT_PARALLEL_THRESHOLD elements
+ *        NOTE: The sort is not stable
+ *
+ * Parameters:
+ *   array          The array of elements to sort
+ *   numElements    The number of elements in the array
+ *   elementSize    The size of each element
+ *   compare        Returns <0, 0, >0 when foo sorts before, with or after bar
+ *   numThreads     The number of threads to use (0 for one per online CPU)
+ * ----------------------------------------------------------------------------
+ */
+void e9497a6d_parallelSort(void *array, const size_t numElements, const size_t elementSize, SortCompareFunction compare, uint32_t numThreads);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e9497a6d_radixSort
+ * Description: Performs a stable LSD radix sort on an unsigned integer key
+ *              located at keyOffset within each element
+ *
+ * Parameters:
+ *   array          The array of elements to sort
+ *   numElements    The number of elements in the array
+ *   elementSize    The size of each element
+ *   keyOffset      The offset of the key within each element (see offsetof)
+ *   keySize        The size of the key in bytes (1 - SORT_MAX_KEY_SIZE)
+ *   options        A bitwise OR of SortOption values
+ * ----------------------------------------------------------------------------
+ */
+void e9497a6d_radixSort(void *array, const size_t numElements, const size_t elementSize, const size_t keyOffset, const uint32_t keySize, const SortOption options);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e9497a6d_radixSort_uint32
+ * Description: Sorts an array of uint32_t values in ascending order
+ *
+ * Parameters:
+ *   array          The array of values to sort
+ *   numElements    The number of values in the array
+ * ----------------------------------------------------------------------------
+ */
+void e9497a6d_radixSort_uint32(uint32_t *array, const size_t numElements);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e9497a6d_radixSort_uint64
+ * Description: Sorts an array of uint64_t values in ascending order
+ *
+ * Parameters:
+ *   array          The array of values to sort
+ *   numElements    The number of values in the array
+ * ----------------------------------------------------------------------------
+ */
+void e9497a6d_radixSort_uint64(uint64_t *array, const size_t numElements);
+
+#endif /* ORG_DEVOPSBROKER_ADT_SORT_H */
@@ -0,0 +1,106 @@
+/*
+ * vector.c - DevOpsBroker C source file for providing typed inline-storage vectors
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+// ════════════════════════════ Feature Test Macros ═══════════════════════════
+
+#define _DEFAULT_SOURCE
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdlib.h>
+
+#include "vector.h"
+
+#include "../lang/memory.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═════════════════════════ Function Implementations ═════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void eef902a2_cleanUpVector(Vector *vector) {
+	if (vector->arena == NULL) {
+		f668c4bd_free(vector->values);
+	}
+
+	vector->values = NULL;
+	vector->length = 0;
+	vector->size = 0;
+}
+
+void eef902a2_initVector(Vector *vector, const size_t elementSize, const uint32_t size) {
+	vector->values = f668c4bd_malloc_size_size(elementSize, size);
+	vector->length = 0;
+	vector->size = size;
+	vector->arena = NULL;
+}
+
+void eef902a2_initVector_arena(Vector *vector, Arena *arena, const size_t elementSize, const uint32_t size) {
+	vector->values = eab6f0ff_alloc(arena, elementSize * size);
+	vector->length = 0;
+	vector->size = size;
+	vector->arena = arena;
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void eef902a2_addAll(register Vector *vector, const size_t elementSize, const void *elementArray, const uint32_t numElements) {
+	if (numElements > 0) {
+		eef902a2_reserve(vector, elementSize, vector->length + numElements);
+
+		f668c4bd_memcopy((void *) elementArray, ((char *) vector->values) + (elementSize * vector->length), elementSize * numElements);
+		vector->length += numElements;
+	}
+}
+
+void eef902a2_reserve(register Vector *vector, const size_t elementSize, const uint32_t size) {
+	register uint32_t newSize = (vector->size == 0) ? VECTOR_DEFAULT_SIZE : vector->size;
+
+	if (size <= vector->size) {
+		return;
+	}
+
+	while (newSize < size) {
+		newSize <<= 1;
+	}
+
+	if (vector->arena == NULL) {
+		vector->values = f668c4bd_realloc_void_size_size(vector->values, elementSize, newSize);
+	} else {
+		vector->values = eab6f0ff_realloc(vector->arena, vector->values, elementSize * vector->length, elementSize * newSize);
+	}
+
+	vector->size = newSize;
+}
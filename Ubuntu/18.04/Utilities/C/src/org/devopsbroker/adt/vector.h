@@ -0,0 +1,193 @@
+/*
+ * vector.h - DevOpsBroker C header file for providing typed inline-storage vectors
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * A Vector stores its elements by value in one contiguous array rather than
+ * as an array of pointers to separately allocated objects like ListArray. A
+ * scan over the elements becomes a linear memory stream the hardware prefetcher
+ * can follow instead of one dependent pointer load per element.
+ *
+ * Typed vectors are declared with the VECTOR_OF() macro and manipulated with
+ * the vector*() macros, which pass the element size through to the untyped
+ * eef902a2_* functions:
+ *
+ *   typedef VECTOR_OF(LogLine) LogLineVector;
+ *
+ *   LogLineVector logLines;
+ *   vectorInit(&logLines, 64);
+ *
+ *   LogLine *logLine = vectorEmplace(&logLines);
+ *
+ * echo ORG_DEVOPSBROKER_ADT_VECTOR | md5sum | cut -c 25-32
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef ORG_DEVOPSBROKER_ADT_VECTOR_H
+#define ORG_DEVOPSBROKER_ADT_VECTOR_H
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <assert.h>
+
+#include "../lang/arena.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define VECTOR_DEFAULT_SIZE 8
+
+/*
+ * Declares an anonymous union overlaying the untyped Vector with a typed view
+ * of the same fields so the typed values pointer can be indexed directly
+ */
+#define VECTOR_OF(Type) union { \
+	Vector vector; \
+	struct { \
+		Type *values; \
+		uint32_t length; \
+		uint32_t size; \
+		Arena *arena; \
+	}; \
+}
+
+#define vectorElementSize(v) sizeof(*(v)->values)
+
+#define vectorInit(v, size) eef902a2_initVector(&(v)->vector, vectorElementSize(v), (size))
+
+#define vectorInit_arena(v, arena, size) eef902a2_initVector_arena(&(v)->vector, (arena), vectorElementSize(v), (size))
+
+#define vectorCleanUp(v) eef902a2_cleanUpVector(&(v)->vector)
+
+#define vectorClear(v) ((v)->length = 0)
+
+#define vectorReserve(v, size) eef902a2_reserve(&(v)->vector, vectorElementSize(v), (size))
+
+#define vectorEmplace(v) ((__typeof__((v)->values)) eef902a2_emplace(&(v)->vector, vectorElementSize(v)))
+
+#define vectorAdd(v, element) (*vectorEmplace(v) = (element))
+
+#define vectorAddAll(v, elements, numElements) eef902a2_addAll(&(v)->vector, vectorElementSize(v), (elements), (numElements))
+
+#define vectorGet(v, index) (&(v)->values[(index)])
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+typedef struct Vector {
+	void *values;
+	uint32_t length;
+	uint32_t size;
+	Arena *arena;                              // NULL when the values come from malloc()
+} Vector;
+
+static_assert(sizeof(Vector) == 24, "Check your assumptions");
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    eef902a2_cleanUpVector
+ * Description: Frees the values owned by the Vector unless they belong to an Arena
+ *
+ * Parameters:
+ *   vector     A pointer to the Vector instance to clean up
+ * ----------------------------------------------------------------------------
+ */
+void eef902a2_cleanUpVector(Vector *vector);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    eef902a2_initVector
+ * Description: Initializes a Vector struct with the specified capacity
+ *
+ * Parameters:
+ *   vector         A pointer to the Vector instance to initalize
+ *   elementSize    The size of each element
+ *   size           The number of elements to allocate room for
+ * ----------------------------------------------------------------------------
+ */
+void eef902a2_initVector(Vector *vector, const size_t elementSize, const uint32_t size);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    eef902a2_initVector_arena
+ * Description: Initializes a Vector struct whose values are allocated from the Arena
+ *        NOTE: The values are released along with the Arena
+ *
+ * Parameters:
+ *   vector         A pointer to the Vector instance to initalize
+ *   arena          The Arena to allocate the values from
+ *   elementSize    The size of each element
+ *   size           The number of elements to allocate room for
+ * ----------------------------------------------------------------------------
+ */
+void eef902a2_initVector_arena(Vector *vector, Arena *arena, const size_t elementSize, const uint32_t size);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    eef902a2_addAll
+ * Description: Copies all of the elements onto the end of the Vector instance
+ *              with at most one reallocation
+ *
+ * Parameters:
+ *   vector         The Vector instance
+ *   elementSize    The size of each element
+ *   elementArray   A contiguous array of elements to append
+ *   numElements    The number of elements to append
+ * ----------------------------------------------------------------------------
+ */
+void eef902a2_addAll(Vector *vector, const size_t elementSize, const void *elementArray, const uint32_t numElements);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    eef902a2_reserve
+ * Description: Ensures the Vector has room for at least the specified number of
+ *              elements, doubling the capacity so appends stay amortized O(1)
+ *
+ * Parameters:
+ *   vector         The Vector instance
+ *   elementSize    The size of each element
+ *   size           The minimum number of elements to make room for
+ * ----------------------------------------------------------------------------
+ */
+void eef902a2_reserve(Vector *vector, const size_t elementSize, const uint32_t size);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    eef902a2_emplace
+ * Description: Appends an uninitialized element to the Vector instance
+ *        NOTE: The returned pointer is invalidated by the next append
+ *
+ * Parameters:
+ *   vector         The Vector instance
+ *   elementSize    The size of each element
+ * Returns:         A pointer to the new element to construct in place
+ * ----------------------------------------------------------------------------
+ */
+static inline void *eef902a2_emplace(register Vector *vector, const size_t elementSize) {
+	if (vector->length == vector->size) {
+		eef902a2_reserve(vector, elementSize, vector->length + 1);
+	}
+
+	return ((char *) vector->values) + (elementSize * vector->length++);
+}
+
+#endif /* ORG_DEVOPSBROKER_ADT_VECTOR_H */
@@ -0,0 +1,209 @@
+/*
+ * dir.c - DevOpsBroker C source file for the org.devopsbroker.io.Directory struct
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+// ════════════════════════════ Feature Test Macros ═══════════════════════════
+
+#define _DEFAULT_SOURCE
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#include "dir.h"
+#include "file.h"
+
+#include "../lang/error.h"
+#include "../lang/memory.h"
+#include "../lang/stringbuilder.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+/*
+ * Static functions in C restrict their scope to the file where they are declared
+ */
+static void printDirectoryError(const char *message, const char *pathName) {
+	StringBuilder errorMessage;
+	c598a24c_initStringBuilder(&errorMessage);
+
+	c598a24c_append_string(&errorMessage, message);
+	c598a24c_append_string(&errorMessage, pathName);
+	c598a24c_append_char(&errorMessage, '\'');
+
+	c7c88e52_printLibError(errorMessage.buffer, errno);
+	c598a24c_cleanUpStringBuilder(&errorMessage);
+}
+
+static bool fillBuffer(register Directory *directory) {
+	register long numBytes;
+
+	// glibc 2.27 has no getdents64() wrapper
+	do {
+		numBytes = syscall(SYS_getdents64, directory->fd, directory->buffer, DIRECTORY_BUFFER_SIZE);
+	} while (numBytes == SYSTEM_ERROR_CODE && errno == EINTR);
+
+	if (numBytes == SYSTEM_ERROR_CODE) {
+		printDirectoryError("Cannot read directory '", directory->pathName);
+		exit(EXIT_FAILURE);
+	}
+
+	directory->position = 0;
+	directory->length = numBytes;
+
+	return numBytes != END_OF_FILE;
+}
+
+static inline bool isDotEntry(register const char *name) {
+	return name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+}
+
+static uint8_t resolveType(const Directory *directory, const DirEntry *entry) {
+	FileStatus fileStatus;
+
+	// The entry may have been removed since getdents64 returned it
+	if (fstatat(directory->fd, entry->name, &fileStatus, AT_SYMLINK_NOFOLLOW) == SYSTEM_ERROR_CODE) {
+		return DT_UNKNOWN;
+	}
+
+	return IFTODT(fileStatus.st_mode);
+}
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═════════════════════════ Function Implementations ═════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void a07b2d4c_openDirectory(Directory *directory, const char *pathName) {
+	directory->fd = open(pathName, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+	if (directory->fd == SYSTEM_ERROR_CODE) {
+		printDirectoryError("Cannot open directory '", pathName);
+		exit(EXIT_FAILURE);
+	}
+
+	directory->buffer = f668c4bd_malloc(DIRECTORY_BUFFER_SIZE);
+	directory->pathName = pathName;
+	directory->filter = NULL;
+	directory->context = NULL;
+	directory->typeMask = 0;
+	directory->position = 0;
+	directory->length = 0;
+}
+
+void a07b2d4c_closeDirectory(Directory *directory) {
+	e2f74138_closeFile(directory->fd, directory->pathName);
+	f668c4bd_free(directory->buffer);
+
+	directory->fd = SYSTEM_ERROR_CODE;
+	directory->buffer = NULL;
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void a07b2d4c_filterDirectory(Directory *directory, const uint32_t typeMask, DirFilter filter, void *context) {
+	directory->typeMask = typeMask;
+	directory->filter = filter;
+	directory->context = context;
+}
+
+bool a07b2d4c_isIndexed(const DirEntry *entry, void *context) {
+	register const char *prefix = context;
+	register const char *name = entry->name;
+
+	while (*prefix != '\0') {
+		if (*(name++) != *(prefix++)) {
+			return false;
+		}
+	}
+
+	// At least one digit must follow the prefix
+	if (*name == '\0') {
+		return false;
+	}
+
+	do {
+		if (*name < '0' || *name > '9') {
+			return false;
+		}
+	} while (*(++name) != '\0');
+
+	return true;
+}
+
+DirEntry *a07b2d4c_nextEntry(register Directory *directory) {
+	register DirEntry *entry;
+
+	while (true) {
+		if (directory->position == directory->length && !fillBuffer(directory)) {
+			return NULL;
+		}
+
+		entry = (DirEntry *) (directory->buffer + directory->position);
+		directory->position += entry->recordLength;
+
+		if (isDotEntry(entry->name)) {
+			continue;
+		}
+
+		if (directory->typeMask != 0) {
+			// Only pay for fstatat() when the filesystem does not report d_type
+			if (entry->type == DT_UNKNOWN) {
+				entry->type = resolveType(directory, entry);
+			}
+
+			if ((directory->typeMask & DIRECTORY_TYPE_MASK(entry->type)) == 0) {
+				continue;
+			}
+		}
+
+		if (directory->filter == NULL || directory->filter(entry, directory->context)) {
+			return entry;
+		}
+	}
+}
+
+void a07b2d4c_rewindDirectory(Directory *directory) {
+	if (lseek(directory->fd, 0, SEEK_SET) == SYSTEM_ERROR_CODE) {
+		printDirectoryError("Cannot rewind directory '", directory->pathName);
+		exit(EXIT_FAILURE);
+	}
+
+	directory->position = 0;
+	directory->length = 0;
+}
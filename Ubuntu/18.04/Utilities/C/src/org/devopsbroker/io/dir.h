@@ -0,0 +1,170 @@
+/*
+ * dir.h - DevOpsBroker C header file for the org.devopsbroker.io.Directory struct
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * A Directory enumerates its entries with the raw getdents64 system call into
+ * one large buffer, and hands back pointers to the kernel records in place so
+ * no entry is ever allocated or copied. The "." and ".." entries are skipped.
+ *
+ * Entries can be narrowed with a d_type mask, which costs nothing when the
+ * filesystem fills in d_type (sysfs, procfs, ext4, xfs, tmpfs...), and with an
+ * optional DirFilter function for name matching. A DirEntry is only valid until
+ * the next call to a07b2d4c_nextEntry().
+ *
+ * echo ORG_DEVOPSBROKER_IO_DIR | md5sum | cut -c 25-32
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef ORG_DEVOPSBROKER_IO_DIR_H
+#define ORG_DEVOPSBROKER_IO_DIR_H
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <assert.h>
+#include <dirent.h>
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define DIRECTORY_BUFFER_SIZE 32768
+
+// Builds the d_type mask accepted by a07b2d4c_filterDirectory()
+#define DIRECTORY_TYPE_MASK(type) (1U << (type))
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+typedef enum DirEntryType {                                      // dirent.h
+	DIRENTRY_UNKNOWN = DT_UNKNOWN,
+	DIRENTRY_FIFO = DT_FIFO,
+	DIRENTRY_CHAR_DEVICE = DT_CHR,
+	DIRENTRY_DIRECTORY = DT_DIR,
+	DIRENTRY_BLOCK_DEVICE = DT_BLK,
+	DIRENTRY_FILE = DT_REG,
+	DIRENTRY_LINK = DT_LNK,
+	DIRENTRY_SOCKET = DT_SOCK
+} DirEntryType;
+
+// Same layout as the linux_dirent64 records returned by getdents64
+typedef struct DirEntry {
+	uint64_t inode;
+	int64_t offset;
+	uint16_t recordLength;
+	uint8_t type;
+	char name[];
+} DirEntry;
+
+static_assert(sizeof(DirEntry) == 24, "Check your assumptions");
+
+typedef bool (*DirFilter)(const DirEntry *entry, void *context);
+
+typedef struct Directory {
+	char *buffer;
+	const char *pathName;
+	DirFilter filter;
+	void *context;
+	int fd;
+	uint32_t typeMask;               // Zero accepts every d_type
+	uint32_t position;
+	uint32_t length;
+} Directory;
+
+static_assert(sizeof(Directory) == 48, "Check your assumptions");
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    a07b2d4c_openDirectory
+ * Description: Opens the directory for enumeration with a07b2d4c_nextEntry()
+ *
+ * Parameters:
+ *   directory      A pointer to the Directory instance to initalize
+ *   pathName       The name of the directory to open
+ * ----------------------------------------------------------------------------
+ */
+void a07b2d4c_openDirectory(Directory *directory, const char *pathName);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    a07b2d4c_closeDirectory
+ * Description: Closes the directory and frees its entry buffer
+ *
+ * Parameters:
+ *   directory      A pointer to the Directory instance to close
+ * ----------------------------------------------------------------------------
+ */
+void a07b2d4c_closeDirectory(Directory *directory);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    a07b2d4c_filterDirectory
+ * Description: Restricts the entries returned by a07b2d4c_nextEntry()
+ *        NOTE: Entries reported as DIRENTRY_UNKNOWN are resolved with fstatat()
+ *              only when a type mask is in effect
+ *
+ * Parameters:
+ *   directory      A pointer to the Directory instance
+ *   typeMask       The DIRECTORY_TYPE_MASK() values to accept (zero for all)
+ *   filter         The DirFilter function to apply (may be NULL)
+ *   context        The user-defined context passed to the filter
+ * ----------------------------------------------------------------------------
+ */
+void a07b2d4c_filterDirectory(Directory *directory, const uint32_t typeMask, DirFilter filter, void *context);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    a07b2d4c_isIndexed
+ * Description: DirFilter that accepts entries named prefix followed only by
+ *              decimal digits, such as cpu0, rx-3 or card1
+ *
+ * Parameters:
+ *   entry          The DirEntry to test
+ *   context        The char* prefix to match
+ * Returns:         True if the entry name matches, false otherwise
+ * ----------------------------------------------------------------------------
+ */
+bool a07b2d4c_isIndexed(const DirEntry *entry, void *context);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    a07b2d4c_nextEntry
+ * Description: Returns the next entry of the directory that passes the filters
+ *
+ * Parameters:
+ *   directory      A pointer to the Directory instance
+ * Returns:         The next DirEntry, or NULL when the directory is exhausted
+ * ----------------------------------------------------------------------------
+ */
+DirEntry *a07b2d4c_nextEntry(Directory *directory);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    a07b2d4c_rewindDirectory
+ * Description: Restarts the enumeration from the first entry
+ *
+ * Parameters:
+ *   directory      A pointer to the Directory instance
+ * ----------------------------------------------------------------------------
+ */
+void a07b2d4c_rewindDirectory(Directory *directory);
+
+#endif /* ORG_DEVOPSBROKER_IO_DIR_H */
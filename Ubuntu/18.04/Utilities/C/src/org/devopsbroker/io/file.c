@@ -219,3 +219,35 @@ char *e2f74138_realpath(const char *pathName) {
 
 	return realPathName;
 }
+
+ssize_t e2f74138_writeFile(const int fd, const void *buffer, size_t count, const char *pathName) {
+	register const char *source = buffer;
+	register size_t remaining = count;
+	ssize_t numBytes;
+
+	while (remaining > 0) {
+		numBytes = write(fd, source, remaining);
+
+		if (numBytes == SYSTEM_ERROR_CODE) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			StringBuilder *errorMessage = c598a24c_createStringBuilder();
+
+			c598a24c_append_string(errorMessage, "Cannot write to file '");
+			c598a24c_append_string(errorMessage, pathName);
+			c598a24c_append_char(errorMessage, '\'');
+
+			c7c88e52_printLibError(errorMessage->buffer, errno);
+			c598a24c_destroyStringBuilder(errorMessage);
+
+			exit(EXIT_FAILURE);
+		}
+
+		source += numBytes;
+		remaining -= numBytes;
+	}
+
+	return count;
+}
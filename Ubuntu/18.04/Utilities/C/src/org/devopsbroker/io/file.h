@@ -229,4 +229,19 @@ uint64_t e2f74138_read_uint64(const char *pathName);
  */
 char *e2f74138_realpath(const char *pathName);
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e2f74138_writeFile
+ * Description: Writes all count bytes from the buffer to the file descriptor,
+ *              retrying on partial writes and EINTR
+ *
+ * Parameters:
+ *   fd             The file descriptor of the file to write
+ *   buffer         The buffer to write from
+ *   count          The number of bytes to write
+ *   pathName       The name of the file to write (used for error handling)
+ * Returns:         The number of bytes written
+ * ----------------------------------------------------------------------------
+ */
+ssize_t e2f74138_writeFile(const int fd, const void *buffer, size_t count, const char *pathName);
+
 #endif /* ORG_DEVOPSBROKER_IO_FILE_H */
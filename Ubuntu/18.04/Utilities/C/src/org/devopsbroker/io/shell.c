@@ -27,9 +27,14 @@
 
 // ═════════════════════════════════ Includes ═════════════════════════════════
 
+#include <stdlib.h>
+
+#include <sys/wait.h>
+
 #include "shell.h"
 
 #include "../lang/error.h"
+#include "../lang/system.h"
 
 // ═══════════════════════════════ Preprocessor ═══════════════════════════════
 
@@ -55,10 +60,43 @@ void f6843e7e_openShellForRead(Shell *shell, const char *command) {
 
 	// TODO: I can get the file descriptor for an existing stream, but not the existing stream from a file descriptor
 	shell->fd = fileno(shell->file);
+	shell->pid = 0;
+}
+
+void f6843e7e_openExecForRead(Shell *shell, const char *path, char *const argv[], bool quiet) {
+	ExecuteOptions options = { .discardStderr = quiet };
+	Pipe pipe;
+
+	shell->pid = c16819a0_execute_pipe_options(path, argv, &pipe, &options);
+	shell->fd = *pipe.read;
+
+	// Wrap the read end of the pipe so the fscanf()-based functions still work
+	shell->file = fdopen(shell->fd, "r");
+
+	if (shell->file == NULL) {
+		c7c88e52_printLibError("Cannot open file", errno);
+		exit(EXIT_FAILURE);
+	}
 }
 
-void f6843e7e_closeShell(Shell *shell) {
-	pclose(shell->file);
+int f6843e7e_closeShell(Shell *shell) {
+	int status;
+
+	if (shell->pid == 0) {
+		status = pclose(shell->file);
+
+		return (status != SYSTEM_ERROR_CODE && WIFEXITED(status)) ? WEXITSTATUS(status) : SYSTEM_ERROR_CODE;
+	}
+
+	fclose(shell->file);
+
+	return c16819a0_waitForExitStatus(shell->pid);
+}
+
+int f6843e7e_execute(const char *path, char *const argv[]) {
+	const pid_t child = c16819a0_spawn(path, argv, NULL);
+
+	return c16819a0_waitForExitStatus(child);
 }
 
 int f6843e7e_readInt(Shell *shell) {
@@ -27,9 +27,11 @@
 
 // ═════════════════════════════════ Includes ═════════════════════════════════
 
+#include <stdbool.h>
 #include <stdio.h>
 
 #include <assert.h>
+#include <sys/types.h>
 
 // ═══════════════════════════════ Preprocessor ═══════════════════════════════
 
@@ -39,6 +41,7 @@
 typedef struct Shell {
 	FILE *file;
 	int fd;
+	pid_t pid;                       // Zero when opened with popen()
 } Shell;
 
 static_assert(sizeof(Shell) == 16, "Check your assumptions");
@@ -59,15 +62,47 @@ static_assert(sizeof(Shell) == 16, "Check your assumptions");
  */
 void f6843e7e_openShellForRead(Shell *shell, const char *command);
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f6843e7e_openExecForRead
+ * Description: Executes the specified file directly, without an intermediate
+ *              /bin/sh, and opens its STDOUT for reading; the output can be
+ *              read either through the Shell functions or from shell->fd with
+ *              a LineBuffer
+ *        NOTE: Terminate the argv[] array with NULL as the last value
+ *
+ * Parameters:
+ *   shell	    A pointer to the Shell instance to initalize
+ *   path       The name of the file to execute
+ *   argv       The argument list available to the new program
+ *   quiet      Whether to discard the STDERR output of the program
+ * ----------------------------------------------------------------------------
+ */
+void f6843e7e_openExecForRead(Shell *shell, const char *path, char *const argv[], bool quiet);
+
 /* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
  * Function:    f6843e7e_closeShell
- * Description: Closes the shell pipe
+ * Description: Closes the shell pipe and waits for the command to complete
  *
  * Parameters:
  *   shell	    A pointer to the Shell instance
+ * Returns:     The exit status of the command
+ * ----------------------------------------------------------------------------
+ */
+int f6843e7e_closeShell(Shell *shell);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f6843e7e_execute
+ * Description: Executes the specified file directly, without an intermediate
+ *              /bin/sh, and waits for it to complete
+ *        NOTE: Terminate the argv[] array with NULL as the last value
+ *
+ * Parameters:
+ *   path       The name of the file to execute
+ *   argv       The argument list available to the new program
+ * Returns:     The exit status of the program
  * ----------------------------------------------------------------------------
  */
-void f6843e7e_closeShell(Shell *shell);
+int f6843e7e_execute(const char *path, char *const argv[]);
 
 /* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
  * Function:    f6843e7e_readInt
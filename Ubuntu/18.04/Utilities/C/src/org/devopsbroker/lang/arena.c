@@ -0,0 +1,237 @@
+/*
+ * arena.c - DevOpsBroker C source file for the Arena struct
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-15
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+// ════════════════════════════ Feature Test Macros ═══════════════════════════
+
+#define _DEFAULT_SOURCE
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+#include "memory.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define alignPointer(ptr, alignment) ((char *) (((uintptr_t) (ptr) + ((alignment) - 1)) & ~((uintptr_t) (alignment) - 1)))
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+/*
+ * Static functions in C restrict their scope to the file where they are declared
+ */
+static void addArenaBlock(register Arena *arena) {
+	register ArenaBlock *block = f668c4bd_malloc(sizeof(ArenaBlock) + arena->blockSize);
+
+	block->prev = arena->block;
+	block->size = arena->blockSize;
+
+	arena->block = block;
+	arena->position = block->data;
+	arena->end = block->data + block->size;
+}
+
+static void *allocLargeObject(register Arena *arena, const size_t size, const size_t alignment) {
+	// malloc() already returns memory aligned to ARENA_DEFAULT_ALIGNMENT
+	const size_t padding = (alignment > ARENA_DEFAULT_ALIGNMENT) ? alignment - 1 : 0;
+	register ArenaLargeObject *largeObject = f668c4bd_malloc(sizeof(ArenaLargeObject) + size + padding);
+
+	largeObject->prev = arena->largeObjects;
+	largeObject->size = size;
+	arena->largeObjects = largeObject;
+
+	// The last allocation can no longer be grown in place
+	arena->lastAlloc = NULL;
+
+	return alignPointer(largeObject + 1, alignment);
+}
+
+static void freeArenaBlocks(register ArenaBlock *block, register const ArenaBlock *stop) {
+	register ArenaBlock *prev;
+
+	while (block != stop) {
+		prev = block->prev;
+		free(block);
+		block = prev;
+	}
+}
+
+static void freeLargeObjects(register ArenaLargeObject *largeObject, register const ArenaLargeObject *stop) {
+	register ArenaLargeObject *prev;
+
+	while (largeObject != stop) {
+		prev = largeObject->prev;
+		free(largeObject);
+		largeObject = prev;
+	}
+}
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═════════════════════════ Function Implementations ═════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Create/Destroy Functions ~~~~~~~~~~~~~~~~~~~~~~~~~
+
+Arena *eab6f0ff_createArena() {
+	register Arena *arena = f668c4bd_malloc(sizeof(Arena));
+
+	eab6f0ff_initArena_size(arena, ARENA_DEFAULT_BLOCK_SIZE);
+
+	return arena;
+}
+
+Arena *eab6f0ff_createArena_size(const size_t blockSize) {
+	register Arena *arena = f668c4bd_malloc(sizeof(Arena));
+
+	eab6f0ff_initArena_size(arena, blockSize);
+
+	return arena;
+}
+
+void eab6f0ff_destroyArena(Arena *arena) {
+	eab6f0ff_cleanUpArena(arena);
+	free(arena);
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void eab6f0ff_cleanUpArena(Arena *arena) {
+	freeLargeObjects(arena->largeObjects, NULL);
+	freeArenaBlocks(arena->block, NULL);
+
+	arena->block = NULL;
+	arena->largeObjects = NULL;
+	arena->position = NULL;
+	arena->end = NULL;
+	arena->lastAlloc = NULL;
+}
+
+void eab6f0ff_initArena(Arena *arena) {
+	eab6f0ff_initArena_size(arena, ARENA_DEFAULT_BLOCK_SIZE);
+}
+
+void eab6f0ff_initArena_size(Arena *arena, const size_t blockSize) {
+	arena->block = NULL;
+	arena->largeObjects = NULL;
+	arena->lastAlloc = NULL;
+	arena->blockSize = blockSize;
+
+	addArenaBlock(arena);
+}
+
+void eab6f0ff_resetArena(Arena *arena) {
+	register ArenaBlock *first = arena->block;
+
+	while (first->prev != NULL) {
+		first = first->prev;
+	}
+
+	freeLargeObjects(arena->largeObjects, NULL);
+	freeArenaBlocks(arena->block, first);
+
+	arena->block = first;
+	arena->largeObjects = NULL;
+	arena->position = first->data;
+	arena->end = first->data + first->size;
+	arena->lastAlloc = NULL;
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void *eab6f0ff_alloc(Arena *arena, const size_t size) {
+	return eab6f0ff_alloc_align(arena, size, ARENA_DEFAULT_ALIGNMENT);
+}
+
+void *eab6f0ff_alloc_align(register Arena *arena, const size_t size, const size_t alignment) {
+	// Large objects bypass the blocks so they do not waste the remaining space
+	if (size >= (arena->blockSize >> 2) || alignment >= (arena->blockSize >> 2)) {
+		return allocLargeObject(arena, size, alignment);
+	}
+
+	register char *ptr = alignPointer(arena->position, alignment);
+
+	if (ptr + size > arena->end) {
+		addArenaBlock(arena);
+		ptr = alignPointer(arena->position, alignment);
+	}
+
+	arena->position = ptr + size;
+	arena->lastAlloc = ptr;
+
+	return ptr;
+}
+
+void eab6f0ff_mark(const Arena *arena, ArenaMark *mark) {
+	mark->block = arena->block;
+	mark->largeObjects = arena->largeObjects;
+	mark->position = arena->position;
+	mark->end = arena->end;
+}
+
+void *eab6f0ff_realloc(register Arena *arena, void *ptr, const size_t origSize, const size_t newSize) {
+	if (ptr == NULL) {
+		return eab6f0ff_alloc(arena, newSize);
+	}
+
+	// Grow or shrink the most recent allocation in place
+	if (ptr == arena->lastAlloc && ((char *) ptr) + newSize <= arena->end) {
+		arena->position = ((char *) ptr) + newSize;
+		return ptr;
+	}
+
+	if (newSize <= origSize) {
+		return ptr;
+	}
+
+	void *newPtr = eab6f0ff_alloc(arena, newSize);
+	memcpy(newPtr, ptr, origSize);
+
+	return newPtr;
+}
+
+void eab6f0ff_rewind(register Arena *arena, register const ArenaMark *mark) {
+	freeLargeObjects(arena->largeObjects, mark->largeObjects);
+	freeArenaBlocks(arena->block, mark->block);
+
+	arena->block = mark->block;
+	arena->largeObjects = mark->largeObjects;
+	arena->position = mark->position;
+	arena->end = mark->end;
+	arena->lastAlloc = NULL;
+}
+
+char *eab6f0ff_strdup(Arena *arena, const char *source, const size_t length) {
+	register char *string = eab6f0ff_alloc_align(arena, length + 1, 1);
+
+	memcpy(string, source, length);
+	string[length] = '\0';
+
+	return string;
+}
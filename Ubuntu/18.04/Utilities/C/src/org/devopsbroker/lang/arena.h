@@ -0,0 +1,246 @@
+/*
+ * arena.h - DevOpsBroker C header file for the Arena struct
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-15
+ *
+ * An Arena is a bump allocator for allocations that share a single lifetime.
+ * Memory is carved out of large blocks by advancing a pointer and is only ever
+ * given back all at once, either by rewinding to a previously saved ArenaMark
+ * or by cleaning up the whole Arena. Allocations of a quarter block or more
+ * are passed through to malloc() and tracked so they are released alongside
+ * the blocks.
+ *
+ * echo ORG_DEVOPSBROKER_LANG_ARENA | md5sum | cut -c 17-24
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef ORG_DEVOPSBROKER_LANG_ARENA_H
+#define ORG_DEVOPSBROKER_LANG_ARENA_H
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <assert.h>
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define ARENA_DEFAULT_BLOCK_SIZE 65536
+
+#define ARENA_DEFAULT_ALIGNMENT 16
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+typedef struct ArenaBlock {
+	struct ArenaBlock *prev;
+	size_t size;
+	char data[];
+} ArenaBlock;
+
+static_assert(sizeof(ArenaBlock) == 16, "Check your assumptions");
+
+typedef struct ArenaLargeObject {
+	struct ArenaLargeObject *prev;
+	size_t size;
+} ArenaLargeObject;
+
+static_assert(sizeof(ArenaLargeObject) == 16, "Check your assumptions");
+
+typedef struct Arena {
+	ArenaBlock *block;
+	ArenaLargeObject *largeObjects;
+	char *position;
+	char *end;
+	char *lastAlloc;
+	size_t blockSize;
+} Arena;
+
+static_assert(sizeof(Arena) == 48, "Check your assumptions");
+
+typedef struct ArenaMark {
+	ArenaBlock *block;
+	ArenaLargeObject *largeObjects;
+	char *position;
+	char *end;
+} ArenaMark;
+
+static_assert(sizeof(ArenaMark) == 32, "Check your assumptions");
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Create/Destroy Functions ~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    eab6f0ff_createArena
+ * Description: Creates an Arena struct with the default block size
+ *
+ * Returns:     An Arena struct with the default block size
+ * ----------------------------------------------------------------------------
+ */
+Arena *eab6f0ff_createArena();
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    eab6f0ff_createArena_size
+ * Description: Creates an Arena struct with the specified block size
+ *
+ * Parameters:
+ *   blockSize      The number of bytes to allocate for each block
+ * Returns:         An Arena struct with the specified block size
+ * ----------------------------------------------------------------------------
+ */
+Arena *eab6f0ff_createArena_size(const size_t blockSize);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    eab6f0ff_destroyArena
+ * Description: Releases every allocation made from the Arena and frees the
+ *              memory allocated to the Arena struct pointer
+ *
+ * Parameters:
+ *   arena          A pointer to the Arena instance to destroy
+ * ----------------------------------------------------------------------------
+ */
+void eab6f0ff_destroyArena(Arena *arena);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    eab6f0ff_cleanUpArena
+ * Description: Releases every allocation made from the Arena in one shot
+ *
+ * Parameters:
+ *   arena          A pointer to the Arena instance to clean up
+ * ----------------------------------------------------------------------------
+ */
+void eab6f0ff_cleanUpArena(Arena *arena);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    eab6f0ff_initArena
+ * Description: Initializes an existing Arena struct with the default block size
+ *
+ * Parameters:
+ *   arena          A pointer to the Arena instance to initalize
+ * ----------------------------------------------------------------------------
+ */
+void eab6f0ff_initArena(Arena *arena);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    eab6f0ff_initArena_size
+ * Description: Initializes an existing Arena struct with the specified block size
+ *
+ * Parameters:
+ *   arena          A pointer to the Arena instance to initalize
+ *   blockSize      The number of bytes to allocate for each block
+ * ----------------------------------------------------------------------------
+ */
+void eab6f0ff_initArena_size(Arena *arena, const size_t blockSize);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    eab6f0ff_resetArena
+ * Description: Releases every allocation made from the Arena but keeps the
+ *              first block for reuse
+ *
+ * Parameters:
+ *   arena          A pointer to the Arena instance to reset
+ * ----------------------------------------------------------------------------
+ */
+void eab6f0ff_resetArena(Arena *arena);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    eab6f0ff_alloc
+ * Description: Allocates size bytes from the Arena aligned to ARENA_DEFAULT_ALIGNMENT
+ *
+ * Parameters:
+ *   arena          A pointer to the Arena instance
+ *   size           The number of bytes to allocate
+ * Returns:         A pointer to the allocated memory
+ * ----------------------------------------------------------------------------
+ */
+void *eab6f0ff_alloc(Arena *arena, const size_t size);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    eab6f0ff_alloc_align
+ * Description: Allocates size bytes from the Arena with the specified alignment
+ *
+ * Parameters:
+ *   arena          A pointer to the Arena instance
+ *   size           The number of bytes to allocate
+ *   alignment      The alignment of the allocation (must be a power of two)
+ * Returns:         A pointer to the allocated memory
+ * ----------------------------------------------------------------------------
+ */
+void *eab6f0ff_alloc_align(Arena *arena, const size_t size, const size_t alignment);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    eab6f0ff_mark
+ * Description: Saves the current Arena position so it can be rewound later
+ *
+ * Parameters:
+ *   arena          A pointer to the Arena instance
+ *   mark           A pointer to the ArenaMark instance to populate
+ * ----------------------------------------------------------------------------
+ */
+void eab6f0ff_mark(const Arena *arena, ArenaMark *mark);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    eab6f0ff_realloc
+ * Description: Resizes an allocation made from the Arena. The most recent
+ *              allocation is grown in place when the current block has room;
+ *              otherwise the contents are copied into a new allocation
+ *
+ * Parameters:
+ *   arena          A pointer to the Arena instance
+ *   ptr            The pointer to the allocation to resize (may be NULL)
+ *   origSize       The current size of the allocation
+ *   newSize        The new size of the allocation
+ * Returns:         A pointer to the resized allocation
+ * ----------------------------------------------------------------------------
+ */
+void *eab6f0ff_realloc(Arena *arena, void *ptr, const size_t origSize, const size_t newSize);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    eab6f0ff_rewind
+ * Description: Releases every allocation made from the Arena after the mark
+ *
+ * Parameters:
+ *   arena          A pointer to the Arena instance
+ *   mark           A pointer to the ArenaMark to rewind to
+ * ----------------------------------------------------------------------------
+ */
+void eab6f0ff_rewind(Arena *arena, const ArenaMark *mark);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    eab6f0ff_strdup
+ * Description: Copies length chars of the string into the Arena and
+ *              NUL-terminates the copy
+ *
+ * Parameters:
+ *   arena          A pointer to the Arena instance
+ *   source         The char* string to copy
+ *   length         The number of chars to copy
+ * Returns:         A pointer to the copied string
+ * ----------------------------------------------------------------------------
+ */
+char *eab6f0ff_strdup(Arena *arena, const char *source, const size_t length);
+
+#endif /* ORG_DEVOPSBROKER_LANG_ARENA_H */
@@ -0,0 +1,356 @@
+/*
+ * chunkbuilder.c - DevOpsBroker C source file for the ChunkBuilder struct
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-15
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+// ════════════════════════════ Feature Test Macros ═══════════════════════════
+
+#define _DEFAULT_SOURCE
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <errno.h>
+#include <unistd.h>
+
+#include "chunkbuilder.h"
+#include "error.h"
+#include "memory.h"
+#include "stringbuilder.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define END_OF_FILE 0
+
+// Number of iovec entries handed to each writev() system call
+#define CHUNKBUILDER_IOV_BATCH 64
+
+// Start a new chunk rather than issue a read() smaller than this
+#define CHUNKBUILDER_MIN_READ 512
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+/*
+ * Static functions in C restrict their scope to the file where they are declared
+ */
+static inline BuilderChunk *createBuilderChunk(Arena *arena, const uint32_t size) {
+	register BuilderChunk *chunk;
+
+	if (arena == NULL) {
+		chunk = f668c4bd_malloc(sizeof(BuilderChunk) + size);
+	} else {
+		chunk = eab6f0ff_alloc(arena, sizeof(BuilderChunk) + size);
+	}
+
+	chunk->next = NULL;
+	chunk->length = 0;
+	chunk->size = size;
+
+	return chunk;
+}
+
+static inline BuilderChunk *addBuilderChunk(register ChunkBuilder *chunkBuilder, const size_t minSize) {
+	const uint32_t size = (minSize > chunkBuilder->chunkSize) ? minSize : chunkBuilder->chunkSize;
+	register BuilderChunk *chunk = createBuilderChunk(chunkBuilder->arena, size);
+
+	chunkBuilder->tail->next = chunk;
+	chunkBuilder->tail = chunk;
+	chunkBuilder->numChunks++;
+
+	return chunk;
+}
+
+static void freeBuilderChunks(register BuilderChunk *chunk) {
+	register BuilderChunk *next;
+
+	while (chunk != NULL) {
+		next = chunk->next;
+		free(chunk);
+		chunk = next;
+	}
+}
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═════════════════════════ Function Implementations ═════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Create/Destroy Functions ~~~~~~~~~~~~~~~~~~~~~~~~~
+
+ChunkBuilder *f485dc30_createChunkBuilder() {
+	register ChunkBuilder *chunkBuilder = f668c4bd_malloc(sizeof(ChunkBuilder));
+
+	f485dc30_initChunkBuilder_uint32(chunkBuilder, CHUNKBUILDER_DEFAULT_CHUNK_SIZE);
+
+	return chunkBuilder;
+}
+
+ChunkBuilder *f485dc30_createChunkBuilder_uint32(const uint32_t chunkSize) {
+	register ChunkBuilder *chunkBuilder = f668c4bd_malloc(sizeof(ChunkBuilder));
+
+	f485dc30_initChunkBuilder_uint32(chunkBuilder, chunkSize);
+
+	return chunkBuilder;
+}
+
+void f485dc30_destroyChunkBuilder(ChunkBuilder *chunkBuilder) {
+	f485dc30_cleanUpChunkBuilder(chunkBuilder);
+	free(chunkBuilder);
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void f485dc30_cleanUpChunkBuilder(ChunkBuilder *chunkBuilder) {
+	if (chunkBuilder->arena == NULL) {
+		freeBuilderChunks(chunkBuilder->head);
+	}
+}
+
+void f485dc30_initChunkBuilder(ChunkBuilder *chunkBuilder) {
+	f485dc30_initChunkBuilder_uint32(chunkBuilder, CHUNKBUILDER_DEFAULT_CHUNK_SIZE);
+}
+
+void f485dc30_initChunkBuilder_uint32(ChunkBuilder *chunkBuilder, const uint32_t chunkSize) {
+	chunkBuilder->head = createBuilderChunk(NULL, chunkSize);
+	chunkBuilder->tail = chunkBuilder->head;
+	chunkBuilder->length = 0;
+	chunkBuilder->numChunks = 1;
+	chunkBuilder->chunkSize = chunkSize;
+	chunkBuilder->arena = NULL;
+}
+
+void f485dc30_initChunkBuilder_arena(ChunkBuilder *chunkBuilder, Arena *arena, const uint32_t chunkSize) {
+	chunkBuilder->head = createBuilderChunk(arena, chunkSize);
+	chunkBuilder->tail = chunkBuilder->head;
+	chunkBuilder->length = 0;
+	chunkBuilder->numChunks = 1;
+	chunkBuilder->chunkSize = chunkSize;
+	chunkBuilder->arena = arena;
+}
+
+void f485dc30_resetChunkBuilder(ChunkBuilder *chunkBuilder) {
+	register BuilderChunk *head = chunkBuilder->head;
+
+	// Chunks allocated from an Arena are reclaimed when the Arena is reset
+	if (chunkBuilder->arena == NULL) {
+		freeBuilderChunks(head->next);
+	}
+
+	head->next = NULL;
+	head->length = 0;
+
+	chunkBuilder->tail = head;
+	chunkBuilder->length = 0;
+	chunkBuilder->numChunks = 1;
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void f485dc30_append_char(register ChunkBuilder *chunkBuilder, const char ch) {
+	register BuilderChunk *chunk = chunkBuilder->tail;
+
+	if (chunk->length == chunk->size) {
+		chunk = addBuilderChunk(chunkBuilder, 1);
+	}
+
+	chunk->data[chunk->length++] = ch;
+	chunkBuilder->length++;
+}
+
+void f485dc30_append_string(ChunkBuilder *chunkBuilder, const char *source) {
+	f485dc30_append_string_size(chunkBuilder, source, strlen(source));
+}
+
+void f485dc30_append_string_size(register ChunkBuilder *chunkBuilder, register const char *source, register size_t length) {
+	register BuilderChunk *chunk = chunkBuilder->tail;
+	register uint32_t numBytes = chunk->size - chunk->length;
+
+	chunkBuilder->length += length;
+
+	// Fill the remaining space in the tail chunk
+	if (numBytes > length) {
+		numBytes = length;
+	}
+
+	memcpy(chunk->data + chunk->length, source, numBytes);
+	chunk->length += numBytes;
+	source += numBytes;
+	length -= numBytes;
+
+	// Place whatever is left into a single new chunk
+	if (length > 0) {
+		chunk = addBuilderChunk(chunkBuilder, length);
+
+		memcpy(chunk->data, source, length);
+		chunk->length = length;
+	}
+}
+
+uint32_t f485dc30_getIOVec(const ChunkBuilder *chunkBuilder, register struct iovec *iov, register uint32_t iovLen) {
+	register const BuilderChunk *chunk = chunkBuilder->head;
+	register uint32_t numVecs = 0;
+
+	while (chunk != NULL && numVecs < iovLen) {
+		if (chunk->length > 0) {
+			iov[numVecs].iov_base = (void *) chunk->data;
+			iov[numVecs].iov_len = chunk->length;
+			numVecs++;
+		}
+
+		chunk = chunk->next;
+	}
+
+	return numVecs;
+}
+
+size_t f485dc30_readFile(register ChunkBuilder *chunkBuilder, const int fd, const char *pathName) {
+	register BuilderChunk *chunk = chunkBuilder->tail;
+	register ssize_t numBytes;
+	size_t totalBytes = 0;
+
+	while (true) {
+		if ((chunk->size - chunk->length) < CHUNKBUILDER_MIN_READ) {
+			chunk = addBuilderChunk(chunkBuilder, 0);
+		}
+
+		numBytes = read(fd, chunk->data + chunk->length, chunk->size - chunk->length);
+
+		if (numBytes == END_OF_FILE) {
+			return totalBytes;
+		}
+
+		if (numBytes == SYSTEM_ERROR_CODE) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			StringBuilder errorMessage;
+			c598a24c_initStringBuilder(&errorMessage);
+
+			c598a24c_append_string(&errorMessage, "Cannot read from file '");
+			c598a24c_append_string(&errorMessage, pathName);
+			c598a24c_append_char(&errorMessage, '\'');
+
+			c7c88e52_printLibError(errorMessage.buffer, errno);
+			c598a24c_cleanUpStringBuilder(&errorMessage);
+
+			exit(EXIT_FAILURE);
+		}
+
+		chunk->length += numBytes;
+		chunkBuilder->length += numBytes;
+		totalBytes += numBytes;
+	}
+}
+
+char *f485dc30_toString(const ChunkBuilder *chunkBuilder) {
+	char *string = f668c4bd_malloc(chunkBuilder->length + 1);
+	register char *target = string;
+	register const BuilderChunk *chunk = chunkBuilder->head;
+
+	while (chunk != NULL) {
+		memcpy(target, chunk->data, chunk->length);
+		target += chunk->length;
+		chunk = chunk->next;
+	}
+
+	*target = '\0';
+
+	return string;
+}
+
+size_t f485dc30_writeFile(const ChunkBuilder *chunkBuilder, const int fd, const char *pathName) {
+	struct iovec iov[CHUNKBUILDER_IOV_BATCH];
+	register const BuilderChunk *chunk = chunkBuilder->head;
+	register const BuilderChunk *next;
+	register uint32_t numVecs;
+	register size_t offset = 0;
+	size_t nextOffset, available;
+	ssize_t numBytes;
+	size_t totalBytes = 0;
+
+	while (chunk != NULL) {
+		// Gather the next batch of chunks, starting at the current offset
+		next = chunk;
+		nextOffset = offset;
+		numVecs = 0;
+
+		while (next != NULL && numVecs < CHUNKBUILDER_IOV_BATCH) {
+			if (next->length > nextOffset) {
+				iov[numVecs].iov_base = (void *) (next->data + nextOffset);
+				iov[numVecs].iov_len = next->length - nextOffset;
+				numVecs++;
+			}
+
+			next = next->next;
+			nextOffset = 0;
+		}
+
+		if (numVecs == 0) {
+			break;
+		}
+
+		numBytes = writev(fd, iov, numVecs);
+
+		if (numBytes == SYSTEM_ERROR_CODE) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			StringBuilder errorMessage;
+			c598a24c_initStringBuilder(&errorMessage);
+
+			c598a24c_append_string(&errorMessage, "Cannot write to file '");
+			c598a24c_append_string(&errorMessage, pathName);
+			c598a24c_append_char(&errorMessage, '\'');
+
+			c7c88e52_printLibError(errorMessage.buffer, errno);
+			c598a24c_cleanUpStringBuilder(&errorMessage);
+
+			exit(EXIT_FAILURE);
+		}
+
+		totalBytes += numBytes;
+
+		// Advance past the bytes written, which may end partway through a chunk
+		while (chunk != NULL && numBytes > 0) {
+			available = chunk->length - offset;
+
+			if ((size_t) numBytes < available) {
+				offset += numBytes;
+				numBytes = 0;
+			} else {
+				numBytes -= available;
+				chunk = chunk->next;
+				offset = 0;
+			}
+		}
+	}
+
+	return totalBytes;
+}
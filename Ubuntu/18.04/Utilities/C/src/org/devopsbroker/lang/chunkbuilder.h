@@ -0,0 +1,255 @@
+/*
+ * chunkbuilder.h - DevOpsBroker C header file for the ChunkBuilder struct
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-15
+ *
+ * A ChunkBuilder is a segmented string builder: a linked list of fixed-size
+ * chunks that is only ever appended to. Existing data is never moved or
+ * copied when the builder grows, which makes it suitable for capturing very
+ * large process outputs. The contents can be written directly to a file
+ * descriptor with writev() or exported as an iovec array.
+ *
+ * echo ORG_DEVOPSBROKER_LANG_CHUNKBUILDER | md5sum | cut -c 25-32
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef ORG_DEVOPSBROKER_LANG_CHUNKBUILDER_H
+#define ORG_DEVOPSBROKER_LANG_CHUNKBUILDER_H
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <assert.h>
+#include <sys/uio.h>
+
+#include "arena.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define CHUNKBUILDER_DEFAULT_CHUNK_SIZE 16384
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+typedef struct BuilderChunk {
+	struct BuilderChunk *next;
+	uint32_t length;
+	uint32_t size;
+	char data[];
+} BuilderChunk;
+
+static_assert(sizeof(BuilderChunk) == 16, "Check your assumptions");
+
+typedef struct ChunkBuilder {
+	BuilderChunk *head;
+	BuilderChunk *tail;
+	size_t length;
+	uint32_t numChunks;
+	uint32_t chunkSize;
+	Arena *arena;                    // NULL when the chunks come from malloc()
+} ChunkBuilder;
+
+static_assert(sizeof(ChunkBuilder) == 40, "Check your assumptions");
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Create/Destroy Functions ~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f485dc30_createChunkBuilder
+ * Description: Creates a ChunkBuilder struct with the default chunk size
+ *
+ * Returns:     A ChunkBuilder struct with the default chunk size
+ * ----------------------------------------------------------------------------
+ */
+ChunkBuilder *f485dc30_createChunkBuilder();
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f485dc30_createChunkBuilder_uint32
+ * Description: Creates a ChunkBuilder struct with the specified chunk size
+ *
+ * Parameters:
+ *   chunkSize      The number of data bytes to allocate for each chunk
+ * Returns:         A ChunkBuilder struct with the specified chunk size
+ * ----------------------------------------------------------------------------
+ */
+ChunkBuilder *f485dc30_createChunkBuilder_uint32(const uint32_t chunkSize);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f485dc30_destroyChunkBuilder
+ * Description: Frees the memory allocated to the ChunkBuilder struct pointer
+ *              and all of its chunks
+ *
+ * Parameters:
+ *   chunkBuilder   A pointer to the ChunkBuilder instance to destroy
+ * ----------------------------------------------------------------------------
+ */
+void f485dc30_destroyChunkBuilder(ChunkBuilder *chunkBuilder);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f485dc30_cleanUpChunkBuilder
+ * Description: Frees all chunks allocated within the ChunkBuilder instance
+ *
+ * Parameters:
+ *   chunkBuilder   A pointer to the ChunkBuilder instance to clean up
+ * ----------------------------------------------------------------------------
+ */
+void f485dc30_cleanUpChunkBuilder(ChunkBuilder *chunkBuilder);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f485dc30_initChunkBuilder
+ * Description: Initializes an existing ChunkBuilder struct with the default chunk size
+ *
+ * Parameters:
+ *   chunkBuilder   A pointer to the ChunkBuilder instance to initalize
+ * ----------------------------------------------------------------------------
+ */
+void f485dc30_initChunkBuilder(ChunkBuilder *chunkBuilder);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f485dc30_initChunkBuilder_uint32
+ * Description: Initializes an existing ChunkBuilder struct with the specified chunk size
+ *
+ * Parameters:
+ *   chunkBuilder   A pointer to the ChunkBuilder instance to initalize
+ *   chunkSize      The number of data bytes to allocate for each chunk
+ * ----------------------------------------------------------------------------
+ */
+void f485dc30_initChunkBuilder_uint32(ChunkBuilder *chunkBuilder, const uint32_t chunkSize);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f485dc30_initChunkBuilder_arena
+ * Description: Initializes an existing ChunkBuilder struct whose chunks are
+ *              allocated from the Arena
+ *        NOTE: The chunks are released along with the Arena, so never free() them
+ *
+ * Parameters:
+ *   chunkBuilder   A pointer to the ChunkBuilder instance to initalize
+ *   arena          The Arena to allocate the chunks from
+ *   chunkSize      The number of data bytes to allocate for each chunk
+ * ----------------------------------------------------------------------------
+ */
+void f485dc30_initChunkBuilder_arena(ChunkBuilder *chunkBuilder, Arena *arena, const uint32_t chunkSize);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f485dc30_resetChunkBuilder
+ * Description: Resets an existing ChunkBuilder instance to the empty state,
+ *              keeping the first chunk for reuse
+ *
+ * Parameters:
+ *   chunkBuilder   A pointer to the ChunkBuilder instance to reset
+ * ----------------------------------------------------------------------------
+ */
+void f485dc30_resetChunkBuilder(ChunkBuilder *chunkBuilder);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f485dc30_append_char
+ * Description: Appends a char to the ChunkBuilder instance
+ *
+ * Parameters:
+ *   chunkBuilder   A pointer to the ChunkBuilder instance
+ *   ch             The char to append
+ * ----------------------------------------------------------------------------
+ */
+void f485dc30_append_char(ChunkBuilder *chunkBuilder, const char ch);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f485dc30_append_string
+ * Description: Appends a char* string to the ChunkBuilder instance
+ *
+ * Parameters:
+ *   chunkBuilder   A pointer to the ChunkBuilder instance
+ *   source         The char* string to append
+ * ----------------------------------------------------------------------------
+ */
+void f485dc30_append_string(ChunkBuilder *chunkBuilder, const char *source);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f485dc30_append_string_size
+ * Description: Appends length bytes of the char* string to the ChunkBuilder instance
+ *
+ * Parameters:
+ *   chunkBuilder   A pointer to the ChunkBuilder instance
+ *   source         The char* string to append
+ *   length         The number of bytes to append
+ * ----------------------------------------------------------------------------
+ */
+void f485dc30_append_string_size(ChunkBuilder *chunkBuilder, const char *source, size_t length);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f485dc30_getIOVec
+ * Description: Populates the iovec array with one entry per non-empty chunk
+ *
+ * Parameters:
+ *   chunkBuilder   A pointer to the ChunkBuilder instance
+ *   iov            The iovec array to populate
+ *   iovLen         The number of entries available in the iovec array
+ * Returns:         The number of iovec entries populated
+ * ----------------------------------------------------------------------------
+ */
+uint32_t f485dc30_getIOVec(const ChunkBuilder *chunkBuilder, struct iovec *iov, uint32_t iovLen);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f485dc30_readFile
+ * Description: Reads from the file descriptor until end-of-file directly into
+ *              the spare capacity of the ChunkBuilder chunks
+ *
+ * Parameters:
+ *   chunkBuilder   A pointer to the ChunkBuilder instance
+ *   fd             The file descriptor to read from
+ *   pathName       The name of the file to read (used for error handling)
+ * Returns:         The total number of bytes read
+ * ----------------------------------------------------------------------------
+ */
+size_t f485dc30_readFile(ChunkBuilder *chunkBuilder, const int fd, const char *pathName);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f485dc30_toString
+ * Description: Copies the ChunkBuilder contents into a single NUL-terminated
+ *              char* string which the caller must free()
+ *
+ * Parameters:
+ *   chunkBuilder   A pointer to the ChunkBuilder instance
+ * Returns:         The ChunkBuilder contents as a char* string
+ * ----------------------------------------------------------------------------
+ */
+char *f485dc30_toString(const ChunkBuilder *chunkBuilder);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f485dc30_writeFile
+ * Description: Writes the entire ChunkBuilder contents to the file descriptor
+ *              using writev(), retrying on partial writes
+ *
+ * Parameters:
+ *   chunkBuilder   A pointer to the ChunkBuilder instance
+ *   fd             The file descriptor to write to
+ *   pathName       The name of the file to write (used for error handling)
+ * Returns:         The total number of bytes written
+ * ----------------------------------------------------------------------------
+ */
+size_t f485dc30_writeFile(const ChunkBuilder *chunkBuilder, const int fd, const char *pathName);
+
+#endif /* ORG_DEVOPSBROKER_LANG_CHUNKBUILDER_H */
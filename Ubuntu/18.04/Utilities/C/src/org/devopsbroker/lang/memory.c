@@ -25,17 +25,56 @@
 
 #define _DEFAULT_SOURCE
 
+// Keep memory.h from redirecting the allocation functions defined here
+#define ORG_DEVOPSBROKER_LANG_MEMORY_IMPL
+
 // ═════════════════════════════════ Includes ═════════════════════════════════
 
+#ifdef MEMPROFILE
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+#include <sys/mman.h>
+
 #include "error.h"
 #include "memory.h"
 #include "stringbuilder.h"
 
 // ═══════════════════════════════ Preprocessor ═══════════════════════════════
 
+#ifdef MEMPROFILE
+#define MEMPROFILE_SIGNAL           SIGUSR2
+#define MEMPROFILE_MAX_CALL_SITES   1024
+#define MEMPROFILE_REPORT_SITES     32
+#define MEMPROFILE_NUM_BUCKETS      25
+#endif
 
 // ═════════════════════════════════ Typedefs ═════════════════════════════════
 
+#ifdef MEMPROFILE
+typedef struct CallSite {
+	const void *key;
+	const char *location;
+	uint64_t numAllocs;
+	uint64_t numBytes;
+} CallSite;
+
+typedef struct MemoryProfile {
+	uint64_t numMallocs;
+	uint64_t numCallocs;
+	uint64_t numReallocs;
+	uint64_t numFrees;
+	uint64_t totalBytes;
+	uint64_t liveBytes;
+	uint64_t peakBytes;
+	uint64_t histogram[MEMPROFILE_NUM_BUCKETS];
+	CallSite callSites[MEMPROFILE_MAX_CALL_SITES];
+} MemoryProfile;
+#endif
 
 // ═══════════════════════════ Function Declarations ══════════════════════════
 
@@ -51,18 +90,176 @@ static void printErrorMessage(register const size_t size) {
 	c598a24c_append_char(&errorMessage, '\'');
 
 	c7c88e52_printLibError(errorMessage.buffer, errno);
-	c598a24c_destroyStringBuilder(&errorMessage);
+	c598a24c_cleanUpStringBuilder(&errorMessage);
+}
+
+static inline size_t getMapSize(const size_t size, const MapBufferOption options) {
+	const size_t pageSize = (options & (MAP_BUFFER_HUGETLB | MAP_BUFFER_HUGEPAGE)) ? F668C4BD_HUGE_PAGE_SIZE : 4096;
+
+	return (size + (pageSize - 1)) & ~(pageSize - 1);
+}
+
+static void *mapAlignedBuffer(const size_t mapSize, const int flags) {
+	// Over-allocate so the buffer can start on a huge page boundary
+	const size_t padSize = mapSize + F668C4BD_HUGE_PAGE_SIZE;
+	char *region = mmap(NULL, padSize, PROT_READ | PROT_WRITE, flags, -1, 0);
+
+	if (region == MAP_FAILED) {
+		printErrorMessage(mapSize);
+		abort();
+	}
+
+	char *buffer = (char *) (((uintptr_t) region + (F668C4BD_HUGE_PAGE_SIZE - 1)) & ~((uintptr_t) F668C4BD_HUGE_PAGE_SIZE - 1));
+	char *end = buffer + mapSize;
+
+	if (buffer > region) {
+		munmap(region, buffer - region);
+	}
+
+	if (end < region + padSize) {
+		munmap(end, (region + padSize) - end);
+	}
+
+	return buffer;
 }
 
 // ═════════════════════════════ Global Variables ═════════════════════════════
 
+#ifdef MEMPROFILE
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t numBlocks, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+// Start of the executable image, provided by the default linker script
+extern const char __executable_start;
+
+static MemoryProfile memoryProfile;
+static atomic_flag profileLock = ATOMIC_FLAG_INIT;
+static __thread const char *nextCallSite;
+
+/*
+ * Profiler implementation
+ */
+static void recordAlloc(uint64_t *counter, register const void *key, register const size_t size) {
+	register CallSite *callSite;
+	register uint32_t index = (((uintptr_t) key) >> 3) & (MEMPROFILE_MAX_CALL_SITES - 1);
+	register uint32_t bucket = (size > 1) ? 64 - __builtin_clzl(size - 1) : 0;
+	const char *location = nextCallSite;
+
+	if (location != NULL) {
+		key = location;
+		index = (((uintptr_t) key) >> 3) & (MEMPROFILE_MAX_CALL_SITES - 1);
+		nextCallSite = NULL;
+	}
+
+	if (bucket >= MEMPROFILE_NUM_BUCKETS) {
+		bucket = MEMPROFILE_NUM_BUCKETS - 1;
+	}
+
+	while (atomic_flag_test_and_set_explicit(&profileLock, memory_order_acquire));
+
+	(*counter)++;
+	memoryProfile.totalBytes += size;
+	memoryProfile.liveBytes += size;
+	memoryProfile.histogram[bucket]++;
+
+	if (memoryProfile.liveBytes > memoryProfile.peakBytes) {
+		memoryProfile.peakBytes = memoryProfile.liveBytes;
+	}
+
+	// Linear probing; once the table is full everything lands in the last slot
+	for (register uint32_t i = 0; i < MEMPROFILE_MAX_CALL_SITES; i++) {
+		callSite = &memoryProfile.callSites[index];
+
+		if (callSite->key == key || callSite->key == NULL) {
+			break;
+		}
+
+		index = (index + 1) & (MEMPROFILE_MAX_CALL_SITES - 1);
+	}
+
+	callSite->key = key;
+	callSite->location = location;
+	callSite->numAllocs++;
+	callSite->numBytes += size;
+
+	atomic_flag_clear_explicit(&profileLock, memory_order_release);
+}
+
+static void recordFree(uint64_t *counter, register const size_t size) {
+	while (atomic_flag_test_and_set_explicit(&profileLock, memory_order_acquire));
+
+	if (counter != NULL) {
+		(*counter)++;
+	}
+
+	memoryProfile.liveBytes -= size;
+
+	atomic_flag_clear_explicit(&profileLock, memory_order_release);
+}
+
+static char *appendString(register char *buffer, register const char *source) {
+	while (*source) {
+		*buffer++ = *source++;
+	}
+
+	return buffer;
+}
+
+static char *appendUint64(register char *buffer, register uint64_t value, register int width) {
+	char digits[24];
+	register int numDigits = 0;
+
+	do {
+		digits[numDigits++] = '0' + (value % 10);
+		value /= 10;
+	} while (value > 0);
+
+	while (width-- > numDigits) {
+		*buffer++ = ' ';
+	}
+
+	while (numDigits > 0) {
+		*buffer++ = digits[--numDigits];
+	}
+
+	return buffer;
+}
+
+static char *appendHex(register char *buffer, register uint64_t value) {
+	char digits[16];
+	register int numDigits = 0;
+
+	do {
+		digits[numDigits++] = "0123456789abcdef"[value & 0x0F];
+		value >>= 4;
+	} while (value > 0);
+
+	buffer = appendString(buffer, "0x");
+
+	while (numDigits > 0) {
+		*buffer++ = digits[--numDigits];
+	}
+
+	return buffer;
+}
+
+static void writeLine(const int fd, const char *line, char *end) {
+	*end++ = '\n';
+
+	if (write(fd, line, end - line) == -1) {
+		// Nothing sensible to do when the report itself cannot be written
+	}
+}
+#endif
+
 
 // ═════════════════════════ Function Implementations ═════════════════════════
 
 void f668c4bd_free(void *ptr) {
-	if (malloc_usable_size(ptr) > 0) {
-		free(ptr);
-	}
+	// free(NULL) is a no-op so there is no need to ask malloc_usable_size()
+	free(ptr);
 }
 
 void *f668c4bd_malloc_size_size(const size_t typeSize, const size_t numBlocks) {
@@ -77,6 +274,45 @@ void *f668c4bd_malloc_size_size(const size_t typeSize, const size_t numBlocks) {
 	return buffer;
 }
 
+void *f668c4bd_mapBuffer(const size_t size, const MapBufferOption options) {
+	const size_t mapSize = getMapSize(size, options);
+	const int populate = (options & MAP_BUFFER_POPULATE) ? MAP_POPULATE : 0;
+	char *buffer;
+
+	if (options & MAP_BUFFER_HUGETLB) {
+		buffer = mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | populate, -1, 0);
+
+		if (buffer != MAP_FAILED) {
+			return buffer;
+		}
+	}
+
+	if ((options & (MAP_BUFFER_HUGETLB | MAP_BUFFER_HUGEPAGE)) == 0) {
+		buffer = mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | populate, -1, 0);
+
+		if (buffer == MAP_FAILED) {
+			printErrorMessage(mapSize);
+			abort();
+		}
+
+		return buffer;
+	}
+
+	// MAP_POPULATE would fault in small pages before madvise() takes effect
+	buffer = mapAlignedBuffer(mapSize, MAP_PRIVATE | MAP_ANONYMOUS);
+
+	// Not fatal; THP may simply be disabled on this system
+	madvise(buffer, mapSize, MADV_HUGEPAGE);
+
+	if (populate) {
+		for (register size_t offset = 0; offset < mapSize; offset += 4096) {
+			((volatile char *) buffer)[offset] = 0;
+		}
+	}
+
+	return buffer;
+}
+
 void *f668c4bd_realloc_void_size(void *ptr, const size_t newSize) {
 	void *buffer = realloc(ptr, newSize);
 
@@ -99,3 +335,170 @@ void *f668c4bd_realloc_void_size_size(void *ptr, const size_t typeSize, const si
 
 	return buffer;
 }
+
+void f668c4bd_unmapBuffer(void *buffer, const size_t size, const MapBufferOption options) {
+	munmap(buffer, getMapSize(size, options));
+}
+
+#ifdef MEMPROFILE
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Profile Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void f668c4bd_printProfile(int fd) {
+	char line[256];
+	register char *end;
+	uint32_t order[MEMPROFILE_REPORT_SITES];
+	uint32_t numSites = 0;
+	register const CallSite *callSite;
+
+	writeLine(fd, line, appendString(line, "═══════════════════════════ Memory Profile ═══════════════════════════"));
+
+	end = appendString(line, "malloc: ");
+	end = appendUint64(end, memoryProfile.numMallocs, 0);
+	end = appendString(end, "  calloc: ");
+	end = appendUint64(end, memoryProfile.numCallocs, 0);
+	end = appendString(end, "  realloc: ");
+	end = appendUint64(end, memoryProfile.numReallocs, 0);
+	end = appendString(end, "  free: ");
+	end = appendUint64(end, memoryProfile.numFrees, 0);
+	writeLine(fd, line, end);
+
+	end = appendString(line, "total bytes: ");
+	end = appendUint64(end, memoryProfile.totalBytes, 0);
+	end = appendString(end, "  live bytes: ");
+	end = appendUint64(end, memoryProfile.liveBytes, 0);
+	end = appendString(end, "  peak bytes: ");
+	end = appendUint64(end, memoryProfile.peakBytes, 0);
+	writeLine(fd, line, end);
+
+	writeLine(fd, line, appendString(line, "\nSize histogram (bytes <= bucket):"));
+
+	for (register uint32_t i = 0; i < MEMPROFILE_NUM_BUCKETS; i++) {
+		if (memoryProfile.histogram[i] > 0) {
+			end = appendString(line, "  ");
+
+			if (i == MEMPROFILE_NUM_BUCKETS - 1) {
+				end = appendString(end, "     larger");
+			} else {
+				end = appendUint64(end, 1UL << i, 11);
+			}
+
+			end = appendUint64(end, memoryProfile.histogram[i], 12);
+			writeLine(fd, line, end);
+		}
+	}
+
+	// Selection of the call sites with the most bytes allocated
+	for (register uint32_t i = 0; i < MEMPROFILE_MAX_CALL_SITES; i++) {
+		callSite = &memoryProfile.callSites[i];
+
+		if (callSite->key == NULL) {
+			continue;
+		}
+
+		register uint32_t j = (numSites < MEMPROFILE_REPORT_SITES) ? numSites++ : MEMPROFILE_REPORT_SITES;
+
+		while (j > 0 && memoryProfile.callSites[order[j - 1]].numBytes < callSite->numBytes) {
+			if (j < MEMPROFILE_REPORT_SITES) {
+				order[j] = order[j - 1];
+			}
+
+			j--;
+		}
+
+		if (j < MEMPROFILE_REPORT_SITES) {
+			order[j] = i;
+		}
+	}
+
+	writeLine(fd, line, appendString(line, "\nCall sites (addresses are offsets for addr2line -f -e <program>):"));
+	writeLine(fd, line, appendString(line, "        allocs           bytes  location"));
+
+	for (register uint32_t i = 0; i < numSites; i++) {
+		callSite = &memoryProfile.callSites[order[i]];
+
+		end = appendUint64(line, callSite->numAllocs, 14);
+		end = appendUint64(end, callSite->numBytes, 16);
+		end = appendString(end, "  ");
+
+		if (callSite->location != NULL) {
+			end = appendString(end, callSite->location);
+		} else {
+			end = appendHex(end, ((uintptr_t) callSite->key) - ((uintptr_t) &__executable_start));
+		}
+
+		writeLine(fd, line, end);
+	}
+}
+
+void f668c4bd_setCallSite(const char *callSite) {
+	nextCallSite = callSite;
+}
+
+// The report is only wired up in profiling builds so regular builds keep the
+// default SIGUSR2 disposition and exit path
+static void printProfileAtExit() {
+	f668c4bd_printProfile(STDERR_FILENO);
+}
+
+static void printProfileOnSignal(int signum) {
+	f668c4bd_printProfile(STDERR_FILENO);
+}
+
+__attribute__((constructor)) static void initMemoryProfile() {
+	signal(MEMPROFILE_SIGNAL, printProfileOnSignal);
+	atexit(printProfileAtExit);
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Linker Wrappers ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void *__wrap_malloc(size_t size) {
+	void *ptr = __real_malloc(size);
+
+	if (ptr != NULL) {
+		recordAlloc(&memoryProfile.numMallocs, __builtin_return_address(0), malloc_usable_size(ptr));
+	}
+
+	return ptr;
+}
+
+void *__wrap_calloc(size_t numBlocks, size_t size) {
+	void *ptr = __real_calloc(numBlocks, size);
+
+	if (ptr != NULL) {
+		recordAlloc(&memoryProfile.numCallocs, __builtin_return_address(0), malloc_usable_size(ptr));
+	}
+
+	return ptr;
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+	const size_t origSize = malloc_usable_size(ptr);
+	void *newPtr;
+
+	// realloc(ptr, 0) releases the block, so account it as a free
+	if (ptr != NULL && size == 0) {
+		recordFree(&memoryProfile.numFrees, origSize);
+		__real_free(ptr);
+
+		return NULL;
+	}
+
+	newPtr = __real_realloc(ptr, size);
+
+	if (newPtr != NULL) {
+		recordFree(NULL, origSize);
+		recordAlloc(&memoryProfile.numReallocs, __builtin_return_address(0), malloc_usable_size(newPtr));
+	}
+
+	return newPtr;
+}
+
+void __wrap_free(void *ptr) {
+	if (ptr != NULL) {
+		recordFree(&memoryProfile.numFrees, malloc_usable_size(ptr));
+		__real_free(ptr);
+	}
+}
+
+#endif /* MEMPROFILE */
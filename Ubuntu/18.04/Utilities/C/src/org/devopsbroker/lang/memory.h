@@ -31,9 +31,28 @@
 
 // ═══════════════════════════════ Preprocessor ═══════════════════════════════
 
+/*
+ * Building with -DMEMPROFILE (make MEMPROFILE=1) turns on the allocation
+ * profiler implemented in memory.c. Every malloc(), calloc(), realloc() and
+ * free() made by the executable is counted when it is linked with:
+ *
+ *   -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free
+ *
+ * Calls through the f668c4bd_* allocation functions are attributed to their
+ * source file and line; any other call is attributed to its return address.
+ * The report is written to stderr at exit and whenever SIGUSR2 is received.
+ */
+
+#define F668C4BD_HUGE_PAGE_SIZE 2097152
 
 // ═════════════════════════════════ Typedefs ═════════════════════════════════
 
+typedef enum MapBufferOption {
+	MAP_BUFFER_DEFAULT = 0x00,
+	MAP_BUFFER_HUGETLB = 0x01,        // Reserved huge pages, falling back to THP
+	MAP_BUFFER_HUGEPAGE = 0x02,       // Transparent huge pages via madvise()
+	MAP_BUFFER_POPULATE = 0x04        // Pre-fault every page up front
+} MapBufferOption;
 
 // ═════════════════════════════ Global Variables ═════════════════════════════
 
@@ -54,6 +73,9 @@ void f668c4bd_free(void *ptr);
  * Function:    f668c4bd_meminit
  * Description: Initializes the block of memory to zeroes
  *
+ * NOTE: Blocks larger than the last level cache are cleared with non-temporal
+ *       stores and will not be resident in the cache afterwards
+ *
  * Parameters:
  *   ptr        A pointer to the memory block to initialize
  *   size       The size of the memory block to initialize
@@ -65,6 +87,9 @@ void f668c4bd_meminit(void *ptr, size_t size);
  * Function:    f668c4bd_memcopy
  * Description: Copies numBytes from source to destination
  *
+ * NOTE: The source and destination must not overlap. Copies larger than the
+ *       last level cache use non-temporal stores and bypass the cache
+ *
  * Parameters:
  *   source     A pointer to the source memory block
  *   dest       A pointer to the destination memory block
@@ -96,6 +121,24 @@ void *f668c4bd_malloc(size_t size);
  */
 void *f668c4bd_malloc_size_size(const size_t typeSize, const size_t numBlocks);
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f668c4bd_mapBuffer
+ * Description: Maps an anonymous buffer for large, long-lived data that can be
+ *              backed by huge pages and pre-faulted to avoid TLB misses and
+ *              page fault storms on first use
+ *
+ * NOTE: Huge page buffers are rounded up to F668C4BD_HUGE_PAGE_SIZE and
+ *       aligned to it. MAP_BUFFER_HUGETLB needs pages reserved through
+ *       vm.nr_hugepages and quietly falls back to MAP_BUFFER_HUGEPAGE
+ *
+ * Parameters:
+ *   size       The size of the buffer to map
+ *   options    A bitwise OR of MapBufferOption values
+ * Returns:     A pointer to the zero-filled buffer
+ * ----------------------------------------------------------------------------
+ */
+void *f668c4bd_mapBuffer(const size_t size, const MapBufferOption options);
+
 /* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
  * Function:    f668c4bd_realloc
  * Description: Performs a 16-byte aligned realloc() operation
@@ -134,4 +177,65 @@ void *f668c4bd_realloc_void_size(void *ptr, const size_t newSize);
  */
 void *f668c4bd_realloc_void_size_size(void *ptr, const size_t typeSize, const size_t numBlocks);
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f668c4bd_unmapBuffer
+ * Description: Unmaps a buffer returned by f668c4bd_mapBuffer()
+ *
+ * Parameters:
+ *   buffer     A pointer to the buffer to unmap
+ *   size       The size passed to f668c4bd_mapBuffer()
+ *   options    The options passed to f668c4bd_mapBuffer()
+ * ----------------------------------------------------------------------------
+ */
+void f668c4bd_unmapBuffer(void *buffer, const size_t size, const MapBufferOption options);
+
+#ifdef MEMPROFILE
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f668c4bd_printProfile
+ * Description: Writes the allocation profile report to the file descriptor
+ *
+ * NOTE: Only uses write() so it is safe to call from a signal handler
+ *
+ * Parameters:
+ *   fd         The file descriptor to write the report to
+ * ----------------------------------------------------------------------------
+ */
+void f668c4bd_printProfile(int fd);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f668c4bd_setCallSite
+ * Description: Attributes the next allocation made by this thread to callSite
+ *
+ * Parameters:
+ *   callSite   A string literal identifying the call site
+ * ----------------------------------------------------------------------------
+ */
+void f668c4bd_setCallSite(const char *callSite);
+
+#ifndef ORG_DEVOPSBROKER_LANG_MEMORY_IMPL
+
+#define F668C4BD_STRINGIFY(x) F668C4BD_STRINGIFY_LINE(x)
+#define F668C4BD_STRINGIFY_LINE(x) #x
+#define F668C4BD_CALL_SITE __FILE__ ":" F668C4BD_STRINGIFY(__LINE__)
+
+#define f668c4bd_malloc(size) \
+	(f668c4bd_setCallSite(F668C4BD_CALL_SITE), f668c4bd_malloc(size))
+
+#define f668c4bd_malloc_size_size(typeSize, numBlocks) \
+	(f668c4bd_setCallSite(F668C4BD_CALL_SITE), f668c4bd_malloc_size_size(typeSize, numBlocks))
+
+#define f668c4bd_realloc(ptr, origSize, newSize) \
+	(f668c4bd_setCallSite(F668C4BD_CALL_SITE), f668c4bd_realloc(ptr, origSize, newSize))
+
+#define f668c4bd_realloc_void_size(ptr, newSize) \
+	(f668c4bd_setCallSite(F668C4BD_CALL_SITE), f668c4bd_realloc_void_size(ptr, newSize))
+
+#define f668c4bd_realloc_void_size_size(ptr, typeSize, numBlocks) \
+	(f668c4bd_setCallSite(F668C4BD_CALL_SITE), f668c4bd_realloc_void_size_size(ptr, typeSize, numBlocks))
+
+#endif /* ORG_DEVOPSBROKER_LANG_MEMORY_IMPL */
+
+#endif /* MEMPROFILE */
+
 #endif /* ORG_DEVOPSBROKER_LANG_MEMORY_H */
@@ -26,6 +26,19 @@
 ;   o void f668c4bd_memcopy(void *source, void *dest, size_t numBytes);
 ;   o void f668c4bd_meminit(void *ptr, size_t size);
 ;   o void *f668c4bd_realloc(void *ptr, size_t origSize, size_t newSize);
+;
+; f668c4bd_memcopy() and f668c4bd_meminit() pick a strategy by size class:
+;
+;   o 0-16 bytes: jump table of exact-size scalar moves
+;   o 17-32 bytes: two overlapping 16-byte SSE2 moves
+;   o Up to 2 KiB: AVX2 loop (SSE2 when AVX2 is not available) finished by
+;     an overlapping tail move
+;   o 2 KiB up to the last level cache size: rep movsb/stosb when the CPU
+;     reports ERMS or FSRM, otherwise the vector loop
+;   o Larger than the last level cache: non-temporal streaming stores so the
+;     buffer does not evict the working set from the cache
+;
+; The CPU features and cache size are detected with cpuid on first use.
 ; -----------------------------------------------------------------------------
 ;
 
@@ -34,11 +47,24 @@
 
 ; ═══════════════════════════════ Preprocessor ═══════════════════════════════
 
+%define FEATURE_INITIALIZED        0x80000000
+%define FEATURE_AVX2               0x01
+%define FEATURE_ERMS               0x02
+%define FEATURE_FSRM               0x04
+
+%define REP_MOVSB_THRESHOLD        2048
+%define DEFAULT_NT_THRESHOLD       0x800000   ; 8 MiB when cpuid reports no cache
+
+%define VECTOR_PREFETCH_DISTANCE   256        ; four cache lines ahead
+%define NT_PREFETCH_DISTANCE       1024       ; sixteen lines ahead to hide DRAM latency
 
 ; ═════════════════════════════ Initialized Data ═════════════════════════════
 
 section .data               ; DX directives
 
+memFeatures:     dd 0       ; FEATURE_* bits, zero until detected
+ntThreshold:     dq 0       ; size above which non-temporal stores are used
+
 ; ════════════════════════════ Uninitialized Data ════════════════════════════
 
 section .bss                ; RESX directives
@@ -85,98 +111,377 @@ f668c4bd_malloc:
 
 	global  f668c4bd_memcopy:function
 f668c4bd_memcopy:
+; Parameters:
+;	rdi : void *source
+;	rsi : void *dest
+;	rdx : size_t numBytes
 
 .prologue:                            ; functions typically have a prologue
-	cmp        rdx, 0x08
-	jae        .eightBytes
-	cmp        dl, 0x04
-	jae        .fourBytes
-	jnz        .bytes
-	jz         .epilogue
-
-.eightBytes:
-	mov        rcx, [rdi]
-	mov        [rsi], rcx
-
-	sub        rdx, 0x08
-	jz         .epilogue
-
-	add        rdi, 0x08
-	add        rsi, 0x08
-
-	cmp        rdx, 0x08
-	jae        .eightBytes
-	cmp        dl, 0x04
-	jb         .bytes
-
-.fourBytes:
-	mov        ecx, [rdi]
-	mov        [rsi], ecx
-
-	sub        sil, 0x04
-	jz         .epilogue
-
-	add        rdi, 0x04
-	add        rsi, 0x04
-
-.bytes:
-	mov        cl, [rdi]
-	mov        [rsi], cl
-
-	inc        rdi
-	inc        rsi
-	dec        cl
-
-	jnz        .bytes
-
-.epilogue:                            ; functions typically have an epilogue
-	ret                               ; pop return address from stack and jump there
+	cmp        rdx, 0x10              ; if (numBytes > 16)
+	ja         .above16
+
+	lea        r8, [rel .smallCopyTable]
+	movsxd     rcx, dword [r8+rdx*4]
+	add        rcx, r8
+	jmp        rcx                    ; goto smallCopyTable[numBytes]
+
+.copy0:
+	ret
+
+.copy1:
+	mov        al, [rdi]
+	mov        [rsi], al
+	ret
+
+.copy2:
+	mov        ax, [rdi]
+	mov        [rsi], ax
+	ret
+
+.copy3:
+	mov        ax, [rdi]
+	mov        cl, [rdi+2]
+	mov        [rsi], ax
+	mov        [rsi+2], cl
+	ret
+
+.copy4to7:                            ; two overlapping four-byte moves
+	mov        eax, [rdi]
+	mov        ecx, [rdi+rdx-4]
+	mov        [rsi], eax
+	mov        [rsi+rdx-4], ecx
+	ret
+
+.copy8to15:                           ; two overlapping eight-byte moves
+	mov        rax, [rdi]
+	mov        rcx, [rdi+rdx-8]
+	mov        [rsi], rax
+	mov        [rsi+rdx-8], rcx
+	ret
+
+.copy16:
+	movdqu     xmm0, [rdi]
+	movdqu     [rsi], xmm0
+	ret
+
+	align 4
+.smallCopyTable:
+	dd         .copy0 - .smallCopyTable
+	dd         .copy1 - .smallCopyTable
+	dd         .copy2 - .smallCopyTable
+	dd         .copy3 - .smallCopyTable
+	times 4 dd .copy4to7 - .smallCopyTable
+	times 8 dd .copy8to15 - .smallCopyTable
+	dd         .copy16 - .smallCopyTable
+
+.above16:
+	cmp        rdx, 0x20              ; if (numBytes > 32)
+	ja         .above32
+
+	movdqu     xmm0, [rdi]            ; two overlapping 16-byte moves
+	movdqu     xmm1, [rdi+rdx-16]
+	movdqu     [rsi], xmm0
+	movdqu     [rsi+rdx-16], xmm1
+	ret
+
+.above32:
+	mov        eax, [rel memFeatures]
+	test       eax, eax               ; if (memFeatures == 0)
+	jnz        .selectPath
+	call       initMemFeatures
+
+.selectPath:
+	cmp        rdx, [rel ntThreshold] ; if (numBytes >= ntThreshold)
+	jae        .nonTemporal
+
+	cmp        rdx, REP_MOVSB_THRESHOLD
+	jb         .vector
+
+	test       eax, FEATURE_ERMS | FEATURE_FSRM
+	jz         .vector
+
+.repMovsb:                            ; rep movsb copies rsi -> rdi
+	mov        rcx, rdx
+	xchg       rdi, rsi
+	rep movsb
+	ret
+
+.vector:
+	test       eax, FEATURE_AVX2
+	jz         .sse2
+
+	cmp        rdx, 0x40              ; if (numBytes > 64)
+	ja         .avx2Loop
+
+	vmovdqu    ymm0, [rdi]            ; two overlapping 32-byte moves
+	vmovdqu    ymm1, [rdi+rdx-32]
+	vmovdqu    [rsi], ymm0
+	vmovdqu    [rsi+rdx-32], ymm1
+	vzeroupper
+	ret
+
+.avx2Loop:
+	lea        r8, [rdi+rdx]          ; r8 = end of source
+	lea        r9, [rsi+rdx]          ; r9 = end of dest
+	vmovdqu    ymm2, [r8-64]          ; load the final 64 bytes up front
+	vmovdqu    ymm3, [r8-32]
+
+.avx2Next:
+	prefetcht0 [rdi+VECTOR_PREFETCH_DISTANCE]
+	vmovdqu    ymm0, [rdi]
+	vmovdqu    ymm1, [rdi+32]
+	vmovdqu    [rsi], ymm0
+	vmovdqu    [rsi+32], ymm1
+
+	add        rdi, 0x40
+	add        rsi, 0x40
+	sub        rdx, 0x40
+	cmp        rdx, 0x40              ; while (numBytes > 64)
+	ja         .avx2Next
+
+	vmovdqu    [r9-64], ymm2          ; overlapping tail move
+	vmovdqu    [r9-32], ymm3
+	vzeroupper
+	ret
+
+.sse2:
+	lea        r8, [rdi+rdx]          ; r8 = end of source
+	lea        r9, [rsi+rdx]          ; r9 = end of dest
+	movdqu     xmm2, [r8-32]          ; load the final 32 bytes up front
+	movdqu     xmm3, [r8-16]
+
+.sse2Next:
+	prefetcht0 [rdi+VECTOR_PREFETCH_DISTANCE]
+	movdqu     xmm0, [rdi]
+	movdqu     xmm1, [rdi+16]
+	movdqu     [rsi], xmm0
+	movdqu     [rsi+16], xmm1
+
+	add        rdi, 0x20
+	add        rsi, 0x20
+	sub        rdx, 0x20
+	cmp        rdx, 0x20              ; while (numBytes > 32)
+	ja         .sse2Next
+
+	movdqu     [r9-32], xmm2          ; overlapping tail move
+	movdqu     [r9-16], xmm3
+	ret
+
+.nonTemporal:
+	lea        r8, [rdi+rdx]          ; r8 = end of source
+	lea        r9, [rsi+rdx]          ; r9 = end of dest
+
+	movdqu     xmm0, [rdi]            ; copy the unaligned head
+	movdqu     xmm1, [rdi+16]
+	movdqu     xmm2, [rdi+32]
+	movdqu     xmm3, [rdi+48]
+	movdqu     [rsi], xmm0
+	movdqu     [rsi+16], xmm1
+	movdqu     [rsi+32], xmm2
+	movdqu     [rsi+48], xmm3
+
+	mov        rcx, rsi               ; rcx = bytes until dest is 64-byte aligned
+	neg        rcx
+	and        ecx, 0x3F
+	add        rdi, rcx
+	add        rsi, rcx
+	sub        rdx, rcx
+
+.ntNext:
+	prefetchnta [rdi+NT_PREFETCH_DISTANCE]
+	movdqu     xmm0, [rdi]
+	movdqu     xmm1, [rdi+16]
+	movdqu     xmm2, [rdi+32]
+	movdqu     xmm3, [rdi+48]
+	movntdq    [rsi], xmm0
+	movntdq    [rsi+16], xmm1
+	movntdq    [rsi+32], xmm2
+	movntdq    [rsi+48], xmm3
+
+	add        rdi, 0x40
+	add        rsi, 0x40
+	sub        rdx, 0x40
+	cmp        rdx, 0x40              ; while (numBytes >= 64)
+	jae        .ntNext
+
+	sfence                            ; order the streaming stores
+
+	movdqu     xmm0, [r8-64]          ; overlapping tail move
+	movdqu     xmm1, [r8-48]
+	movdqu     xmm2, [r8-32]
+	movdqu     xmm3, [r8-16]
+	movdqu     [r9-64], xmm0
+	movdqu     [r9-48], xmm1
+	movdqu     [r9-32], xmm2
+	movdqu     [r9-16], xmm3
+	ret
 
 ; ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ f668c4bd_meminit ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 	global  f668c4bd_meminit:function
 f668c4bd_meminit:
+; Parameters:
+;	rdi : void *ptr
+;	rsi : size_t size
 
 .prologue:                            ; functions typically have a prologue
-	xor        rax, rax               ; zero out rax for memory initialization
+	xor        eax, eax               ; zero out rax for memory initialization
+	cmp        rsi, 0x10              ; if (size > 16)
+	ja         .above16
 
-	cmp        rsi, 0x08
-	jae        .eightBytes
-	cmp        sil, 0x04
-	jae        .fourBytes
-	jnz        .bytes
-	jz         .epilogue
+	lea        r8, [rel .smallInitTable]
+	movsxd     rcx, dword [r8+rsi*4]
+	add        rcx, r8
+	jmp        rcx                    ; goto smallInitTable[size]
 
-.eightBytes:
-	mov        [rdi], rax
+.init0:
+	ret
 
-	sub        rsi, 0x08
-	jz         .epilogue
+.init1:
+	mov        [rdi], al
+	ret
 
-	add        rdi, 0x08
+.init2:
+	mov        [rdi], ax
+	ret
 
-	cmp        rsi, 0x08
-	jae        .eightBytes
-	cmp        sil, 0x04
-	jb         .bytes
+.init3:
+	mov        [rdi], ax
+	mov        [rdi+2], al
+	ret
 
-.fourBytes:
+.init4to7:                            ; two overlapping four-byte stores
 	mov        [rdi], eax
+	mov        [rdi+rsi-4], eax
+	ret
 
-	sub        sil, 0x04
-	jz         .epilogue
-
-	add        rdi, 0x04
-
-.bytes:
-	mov        [rdi], al
-	inc        rdi
-	dec        sil
-
-	jnz        .bytes
+.init8to15:                           ; two overlapping eight-byte stores
+	mov        [rdi], rax
+	mov        [rdi+rsi-8], rax
+	ret
 
-.epilogue:                            ; functions typically have an epilogue
-	ret                               ; pop return address from stack and jump there
+.init16:
+	mov        [rdi], rax
+	mov        [rdi+8], rax
+	ret
+
+	align 4
+.smallInitTable:
+	dd         .init0 - .smallInitTable
+	dd         .init1 - .smallInitTable
+	dd         .init2 - .smallInitTable
+	dd         .init3 - .smallInitTable
+	times 4 dd .init4to7 - .smallInitTable
+	times 8 dd .init8to15 - .smallInitTable
+	dd         .init16 - .smallInitTable
+
+.above16:
+	pxor       xmm0, xmm0
+	cmp        rsi, 0x20              ; if (size > 32)
+	ja         .above32
+
+	movdqu     [rdi], xmm0            ; two overlapping 16-byte stores
+	movdqu     [rdi+rsi-16], xmm0
+	ret
+
+.above32:
+	mov        eax, [rel memFeatures]
+	test       eax, eax               ; if (memFeatures == 0)
+	jnz        .selectPath
+	call       initMemFeatures
+
+.selectPath:
+	cmp        rsi, [rel ntThreshold] ; if (size >= ntThreshold)
+	jae        .nonTemporal
+
+	cmp        rsi, REP_MOVSB_THRESHOLD
+	jb         .vector
+
+	test       eax, FEATURE_ERMS | FEATURE_FSRM
+	jz         .vector
+
+.repStosb:                            ; rep stosb stores al to rdi
+	mov        rcx, rsi
+	xor        eax, eax
+	rep stosb
+	ret
+
+.vector:
+	lea        r9, [rdi+rsi]          ; r9 = end of ptr
+
+	test       eax, FEATURE_AVX2
+	jz         .sse2
+
+	vpxor      ymm0, ymm0, ymm0
+	cmp        rsi, 0x40              ; if (size > 64)
+	ja         .avx2Next
+
+	vmovdqu    [rdi], ymm0            ; two overlapping 32-byte stores
+	vmovdqu    [r9-32], ymm0
+	vzeroupper
+	ret
+
+.avx2Next:
+	vmovdqu    [rdi], ymm0
+	vmovdqu    [rdi+32], ymm0
+
+	add        rdi, 0x40
+	sub        rsi, 0x40
+	cmp        rsi, 0x40              ; while (size > 64)
+	ja         .avx2Next
+
+	vmovdqu    [r9-64], ymm0          ; overlapping tail store
+	vmovdqu    [r9-32], ymm0
+	vzeroupper
+	ret
+
+.sse2Next:
+	movdqu     [rdi], xmm0
+	movdqu     [rdi+16], xmm0
+
+	add        rdi, 0x20
+	sub        rsi, 0x20
+
+.sse2:
+	cmp        rsi, 0x20              ; while (size > 32)
+	ja         .sse2Next
+
+	movdqu     [r9-32], xmm0          ; overlapping tail store
+	movdqu     [r9-16], xmm0
+	ret
+
+.nonTemporal:
+	lea        r9, [rdi+rsi]          ; r9 = end of ptr
+
+	movdqu     [rdi], xmm0            ; clear the unaligned head
+	movdqu     [rdi+16], xmm0
+	movdqu     [rdi+32], xmm0
+	movdqu     [rdi+48], xmm0
+
+	mov        rcx, rdi               ; rcx = bytes until ptr is 64-byte aligned
+	neg        rcx
+	and        ecx, 0x3F
+	add        rdi, rcx
+	sub        rsi, rcx
+
+.ntNext:
+	movntdq    [rdi], xmm0
+	movntdq    [rdi+16], xmm0
+	movntdq    [rdi+32], xmm0
+	movntdq    [rdi+48], xmm0
+
+	add        rdi, 0x40
+	sub        rsi, 0x40
+	cmp        rsi, 0x40              ; while (size >= 64)
+	jae        .ntNext
+
+	sfence                            ; order the streaming stores
+
+	movdqu     [r9-64], xmm0          ; overlapping tail store
+	movdqu     [r9-48], xmm0
+	movdqu     [r9-32], xmm0
+	movdqu     [r9-16], xmm0
+	ret
 
 ; ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ f668c4bd_realloc ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
@@ -190,57 +495,35 @@ f668c4bd_realloc:
 ;	rax : void *newPtr
 
 .prologue:                            ; functions typically have a prologue
-	mov        eax, 0x0F              ; rax = 15
-
-.align:
-	add        rsi, rax               ; origSize = ((origSize + 15) / 16) * 16
-	add        rdx, rax               ; newSize = ((newSize + 15) / 16) * 16
-
-	shr        rsi, 4
-	shr        rdx, 4
-
-	shl        rsi, 4
-	shl        rdx, 4
-
-.malloc:
 	cmp        rsi, rdx               ; if (origSize > newSize)
 	ja         .fatalError
 
 	push       rdi                    ; save void *ptr
 	push       rsi                    ; save size_t origSize
-	sub        rsp, 8                 ; align stack frame before calling malloc()
 
-	mov        rdi, rax               ; set size parameter for malloc() call
+.malloc:
+	add        rdx, 0x0F              ; newSize = ((newSize + 15) / 16) * 16
+	and        rdx, -16
+
+	sub        rsp, 8                 ; align stack frame before calling malloc()
+	mov        rdi, rdx               ; set size parameter for malloc() call
 	call       malloc WRT ..plt
 
-	test       rax, rax               ; if (ptr == NULL)
+	test       rax, rax               ; if (newPtr == NULL)
 	je         .fatalError
 
 	add        rsp, 8
-	pop        rsi                    ; retrieve size_t origSize
+	pop        rdx                    ; retrieve size_t origSize
 	pop        rdi                    ; retrieve void *ptr
 	push       rax                    ; save void *newPtr
+	push       rdi                    ; save void *ptr
 
-.copy:
-	prefetcht0 [rdi]                  ; prefetch the pointer data into the CPU cache
-	mov        rcx, rdi               ; save void *ptr
-	shl        rsi, 4                 ; rsi = numCopies
-	mov        edx, 0x10              ; rdx = 16
-
-.whileData:
-	movdqa     xmm0, [rdi]            ; newPtr[data] = ptr[data]
-	movdqa     [rax], xmm0
-
-	dec        rsi                    ; numCopies--
-	test       rsi, rsi               ; if (numCopies == 0)
-	jz         .free
-
-	add        rdi, rdx               ; ptr += 16
-	add        rax, rdx               ; newPtr += 16
-	jmp        .whileData
+.copy:                                ; f668c4bd_memcopy(ptr, newPtr, origSize)
+	mov        rsi, rax
+	call       f668c4bd_memcopy
 
 .free:
-	mov        rdi, rcx               ; set ptr parameter for free() call
+	pop        rdi                    ; set ptr parameter for free() call
 	call       free WRT ..plt
 
 .epilogue:                            ; functions typically have an epilogue
@@ -251,3 +534,130 @@ f668c4bd_realloc:
 	call       abort WRT ..plt
 
 ; ═════════════════════════════ Private Routines ═════════════════════════════
+
+; ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ initMemFeatures ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+initMemFeatures:
+; Returns:
+;	eax : FEATURE_* bits
+; Local Variables:
+;	r8d : FEATURE_* bits
+;	r9d : maximum basic cpuid leaf
+;	r10 : last level cache size
+; NOTE: Preserves rdi, rsi and rdx for the caller
+
+.prologue:                            ; functions typically have a prologue
+	push       rbx                    ; cpuid clobbers rbx
+	push       rdi
+	push       rsi
+	push       rdx
+
+	mov        r8d, FEATURE_INITIALIZED
+	xor        r10d, r10d
+
+	xor        eax, eax               ; cpuid leaf 0: maximum basic leaf
+	cpuid
+	mov        r9d, eax
+
+	cmp        r9d, 7
+	jb         .cacheSize
+
+	mov        eax, 1                 ; cpuid leaf 1: OSXSAVE and AVX bits
+	cpuid
+	mov        edi, ecx
+
+	mov        eax, 7                 ; cpuid leaf 7: AVX2, ERMS and FSRM bits
+	xor        ecx, ecx
+	cpuid
+
+	test       ebx, 0x200             ; ERMS is ebx bit 9
+	jz         .checkFSRM
+	or         r8d, FEATURE_ERMS
+
+.checkFSRM:
+	test       edx, 0x10              ; FSRM is edx bit 4
+	jz         .checkAVX2
+	or         r8d, FEATURE_FSRM
+
+.checkAVX2:
+	test       ebx, 0x20              ; AVX2 is ebx bit 5
+	jz         .cacheSize
+
+	and        edi, 0x18000000        ; OSXSAVE and AVX are ecx bits 27 and 28
+	cmp        edi, 0x18000000
+	jne        .cacheSize
+
+	xor        ecx, ecx               ; the OS must save the YMM state
+	xgetbv
+	and        eax, 0x06
+	cmp        eax, 0x06
+	jne        .cacheSize
+	or         r8d, FEATURE_AVX2
+
+.cacheSize:                           ; largest cache from cpuid leaf 4
+	mov        esi, 0x04
+	cmp        r9d, esi
+	jae        .firstCacheLevel
+
+.extendedCacheLeaf:                   ; otherwise try the AMD extended leaf
+	mov        eax, 0x80000000
+	cpuid
+	mov        esi, 0x8000001D
+	cmp        eax, esi
+	jb         .defaultThreshold
+
+.firstCacheLevel:
+	xor        edi, edi               ; edi = cache level subleaf
+
+.nextCacheLevel:
+	mov        eax, esi
+	mov        ecx, edi
+	cpuid
+
+	test       eax, 0x1F              ; cache type of zero means no more caches
+	jz         .setThreshold
+
+	mov        eax, ebx               ; ways = ebx[31:22] + 1
+	shr        eax, 22
+	inc        eax
+
+	mov        edx, ebx               ; partitions = ebx[21:12] + 1
+	shr        edx, 12
+	and        edx, 0x3FF
+	inc        edx
+	imul       rax, rdx
+
+	and        ebx, 0xFFF             ; line size = ebx[11:0] + 1
+	inc        ebx
+	imul       rax, rbx
+
+	inc        ecx                    ; sets = ecx + 1
+	imul       rax, rcx
+
+	cmp        rax, r10               ; if (cacheSize > lastLevelCacheSize)
+	cmova      r10, rax
+
+	inc        edi
+	cmp        edi, 0x10
+	jb         .nextCacheLevel
+
+.setThreshold:
+	test       r10, r10
+	jnz        .epilogue
+
+	cmp        esi, 0x04              ; AMD reports no caches through leaf 4
+	je         .extendedCacheLeaf
+
+.defaultThreshold:
+	mov        r10d, DEFAULT_NT_THRESHOLD
+
+.epilogue:                            ; functions typically have an epilogue
+	mov        [rel ntThreshold], r10
+	mov        [rel memFeatures], r8d
+	mov        eax, r8d
+
+	pop        rdx
+	pop        rsi
+	pop        rdi
+	pop        rbx
+	ret                               ; pop return address from stack and jump there
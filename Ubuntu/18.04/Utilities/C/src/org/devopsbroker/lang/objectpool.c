@@ -0,0 +1,200 @@
+/*
+ * objectpool.c - DevOpsBroker C source file for the ObjectPool struct
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-15
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+// ════════════════════════════ Feature Test Macros ═══════════════════════════
+
+#define _DEFAULT_SOURCE
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdlib.h>
+
+#include "objectpool.h"
+#include "error.h"
+#include "memory.h"
+#include "stringbuilder.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+/*
+ * Static functions in C restrict their scope to the file where they are declared
+ */
+static size_t computeStride(register const size_t objectSize) {
+	register size_t stride = sizeof(PoolObject);
+
+	if (objectSize >= OBJECTPOOL_CACHE_LINE_SIZE) {
+		return (objectSize + (OBJECTPOOL_CACHE_LINE_SIZE - 1)) & ~((size_t) OBJECTPOOL_CACHE_LINE_SIZE - 1);
+	}
+
+	while (stride < objectSize) {
+		stride <<= 1;
+	}
+
+	return stride;
+}
+
+static void addPoolSlab(register ObjectPool *objectPool) {
+	const size_t size = sizeof(PoolSlab) + (objectPool->stride * objectPool->objectsPerSlab);
+	void *ptr;
+	int status = posix_memalign(&ptr, OBJECTPOOL_CACHE_LINE_SIZE, size);
+
+	if (status != 0) {
+		StringBuilder errorMessage;
+		c598a24c_initStringBuilder(&errorMessage);
+
+		c598a24c_append_string(&errorMessage, "Cannot allocate object pool slab of size '");
+		c598a24c_append_uint64(&errorMessage, size);
+		c598a24c_append_char(&errorMessage, '\'');
+
+		c7c88e52_printLibError(errorMessage.buffer, status);
+		c598a24c_cleanUpStringBuilder(&errorMessage);
+
+		abort();
+	}
+
+	register PoolSlab *slab = ptr;
+
+	slab->next = objectPool->slabs;
+
+	objectPool->slabs = slab;
+	objectPool->position = slab->data;
+	objectPool->end = slab->data + (objectPool->stride * objectPool->objectsPerSlab);
+	objectPool->numSlabs++;
+}
+
+static void freePoolSlabs(register PoolSlab *slab) {
+	register PoolSlab *next;
+
+	while (slab != NULL) {
+		next = slab->next;
+		free(slab);
+		slab = next;
+	}
+}
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═════════════════════════ Function Implementations ═════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Create/Destroy Functions ~~~~~~~~~~~~~~~~~~~~~~~~~
+
+ObjectPool *e744848d_createObjectPool(const size_t objectSize) {
+	register ObjectPool *objectPool = f668c4bd_malloc(sizeof(ObjectPool));
+
+	e744848d_initObjectPool(objectPool, objectSize);
+
+	return objectPool;
+}
+
+ObjectPool *e744848d_createObjectPool_uint32(const size_t objectSize, const uint32_t objectsPerSlab) {
+	register ObjectPool *objectPool = f668c4bd_malloc(sizeof(ObjectPool));
+
+	e744848d_initObjectPool_uint32(objectPool, objectSize, objectsPerSlab);
+
+	return objectPool;
+}
+
+void e744848d_destroyObjectPool(ObjectPool *objectPool) {
+	freePoolSlabs(objectPool->slabs);
+	free(objectPool);
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void e744848d_cleanUpObjectPool(ObjectPool *objectPool) {
+	freePoolSlabs(objectPool->slabs);
+
+	objectPool->slabs = NULL;
+	objectPool->freeList = NULL;
+	objectPool->position = NULL;
+	objectPool->end = NULL;
+	objectPool->numSlabs = 0;
+	objectPool->numAllocated = 0;
+}
+
+void e744848d_initObjectPool(ObjectPool *objectPool, const size_t objectSize) {
+	const size_t stride = computeStride(objectSize);
+	uint32_t objectsPerSlab = (OBJECTPOOL_DEFAULT_SLAB_SIZE - sizeof(PoolSlab)) / stride;
+
+	if (objectsPerSlab == 0) {
+		objectsPerSlab = 1;
+	}
+
+	e744848d_initObjectPool_uint32(objectPool, objectSize, objectsPerSlab);
+}
+
+void e744848d_initObjectPool_uint32(ObjectPool *objectPool, const size_t objectSize, const uint32_t objectsPerSlab) {
+	objectPool->slabs = NULL;
+	objectPool->freeList = NULL;
+	objectPool->position = NULL;
+	objectPool->end = NULL;
+	objectPool->objectSize = objectSize;
+	objectPool->stride = computeStride(objectSize);
+	objectPool->objectsPerSlab = objectsPerSlab;
+	objectPool->numSlabs = 0;
+	objectPool->numAllocated = 0;
+
+	// Slabs are added lazily so an unused pool costs nothing
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void *e744848d_alloc(register ObjectPool *objectPool) {
+	register PoolObject *object = objectPool->freeList;
+
+	objectPool->numAllocated++;
+
+	// Most recently released objects are reused first while still hot in cache
+	if (object != NULL) {
+		objectPool->freeList = object->next;
+		return object;
+	}
+
+	// Carve the next untouched object from the current slab
+	if (objectPool->position == objectPool->end) {
+		addPoolSlab(objectPool);
+	}
+
+	object = (PoolObject *) objectPool->position;
+	objectPool->position += objectPool->stride;
+
+	return object;
+}
+
+void e744848d_free(register ObjectPool *objectPool, void *ptr) {
+	register PoolObject *object = ptr;
+
+	if (object != NULL) {
+		object->next = objectPool->freeList;
+		objectPool->freeList = object;
+		objectPool->numAllocated--;
+	}
+}
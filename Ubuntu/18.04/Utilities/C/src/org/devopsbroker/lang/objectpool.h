@@ -0,0 +1,186 @@
+/*
+ * objectpool.h - DevOpsBroker C header file for the ObjectPool struct
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-15
+ *
+ * An ObjectPool hands out fixed-size objects carved from cache-line aligned
+ * slabs. Released objects are pushed onto an intrusive free list and reused by
+ * the next allocation, so a create/destroy heavy workload settles into a fixed
+ * set of slabs instead of calling malloc() and free() for every struct.
+ *
+ * Objects smaller than a cache line are spaced at the next power of two so no
+ * object ever straddles two cache lines; larger objects are spaced at a whole
+ * multiple of the cache line size.
+ *
+ * echo ORG_DEVOPSBROKER_LANG_OBJECTPOOL | md5sum | cut -c 25-32
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef ORG_DEVOPSBROKER_LANG_OBJECTPOOL_H
+#define ORG_DEVOPSBROKER_LANG_OBJECTPOOL_H
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <assert.h>
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define OBJECTPOOL_CACHE_LINE_SIZE 64
+
+#define OBJECTPOOL_DEFAULT_SLAB_SIZE 65536
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+typedef struct PoolSlab {
+	struct PoolSlab *next;
+	char _padding[OBJECTPOOL_CACHE_LINE_SIZE - sizeof(void*)];
+	char data[];
+} PoolSlab;
+
+static_assert(sizeof(PoolSlab) == OBJECTPOOL_CACHE_LINE_SIZE, "Check your assumptions");
+
+typedef struct PoolObject {
+	struct PoolObject *next;
+} PoolObject;
+
+static_assert(sizeof(PoolObject) == 8, "Check your assumptions");
+
+typedef struct ObjectPool {
+	PoolSlab *slabs;
+	PoolObject *freeList;
+	char *position;
+	char *end;
+	size_t objectSize;
+	size_t stride;
+	uint32_t objectsPerSlab;
+	uint32_t numSlabs;
+	uint32_t numAllocated;
+	char _padding[4];
+} ObjectPool;
+
+static_assert(sizeof(ObjectPool) == 64, "Check your assumptions");
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Create/Destroy Functions ~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e744848d_createObjectPool
+ * Description: Creates an ObjectPool struct for objects of the specified size
+ *              using the default slab size
+ *
+ * Parameters:
+ *   objectSize     The size of each object handed out by the pool
+ * Returns:         An ObjectPool struct for objects of the specified size
+ * ----------------------------------------------------------------------------
+ */
+ObjectPool *e744848d_createObjectPool(const size_t objectSize);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e744848d_createObjectPool_uint32
+ * Description: Creates an ObjectPool struct for objects of the specified size
+ *              with the specified number of objects per slab
+ *
+ * Parameters:
+ *   objectSize     The size of each object handed out by the pool
+ *   objectsPerSlab The number of objects to carve from each slab
+ * Returns:         An ObjectPool struct for objects of the specified size
+ * ----------------------------------------------------------------------------
+ */
+ObjectPool *e744848d_createObjectPool_uint32(const size_t objectSize, const uint32_t objectsPerSlab);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e744848d_destroyObjectPool
+ * Description: Releases every slab owned by the ObjectPool and frees the
+ *              memory allocated to the ObjectPool struct pointer
+ *
+ * Parameters:
+ *   objectPool     A pointer to the ObjectPool instance to destroy
+ * ----------------------------------------------------------------------------
+ */
+void e744848d_destroyObjectPool(ObjectPool *objectPool);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e744848d_cleanUpObjectPool
+ * Description: Releases every slab owned by the ObjectPool in one shot
+ *
+ * Parameters:
+ *   objectPool     A pointer to the ObjectPool instance to clean up
+ * ----------------------------------------------------------------------------
+ */
+void e744848d_cleanUpObjectPool(ObjectPool *objectPool);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e744848d_initObjectPool
+ * Description: Initializes an existing ObjectPool struct for objects of the
+ *              specified size using the default slab size
+ *
+ * Parameters:
+ *   objectPool     A pointer to the ObjectPool instance to initalize
+ *   objectSize     The size of each object handed out by the pool
+ * ----------------------------------------------------------------------------
+ */
+void e744848d_initObjectPool(ObjectPool *objectPool, const size_t objectSize);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e744848d_initObjectPool_uint32
+ * Description: Initializes an existing ObjectPool struct for objects of the
+ *              specified size with the specified number of objects per slab
+ *
+ * Parameters:
+ *   objectPool     A pointer to the ObjectPool instance to initalize
+ *   objectSize     The size of each object handed out by the pool
+ *   objectsPerSlab The number of objects to carve from each slab
+ * ----------------------------------------------------------------------------
+ */
+void e744848d_initObjectPool_uint32(ObjectPool *objectPool, const size_t objectSize, const uint32_t objectsPerSlab);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e744848d_alloc
+ * Description: Allocates one object from the ObjectPool, reusing a released
+ *              object if one is available
+ *
+ * Parameters:
+ *   objectPool     A pointer to the ObjectPool instance
+ * Returns:         A pointer to the allocated object (contents are undefined)
+ * ----------------------------------------------------------------------------
+ */
+void *e744848d_alloc(ObjectPool *objectPool);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e744848d_free
+ * Description: Returns an object to the ObjectPool free list
+ *
+ * Parameters:
+ *   objectPool     A pointer to the ObjectPool instance
+ *   ptr            A pointer to an object allocated from this pool (may be NULL)
+ * ----------------------------------------------------------------------------
+ */
+void e744848d_free(ObjectPool *objectPool, void *ptr);
+
+#endif /* ORG_DEVOPSBROKER_LANG_OBJECTPOOL_H */
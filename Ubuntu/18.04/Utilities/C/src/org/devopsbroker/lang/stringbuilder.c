@@ -33,15 +33,32 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include <errno.h>
+#include <unistd.h>
+
+#include "error.h"
 #include "integer.h"
 #include "long.h"
 #include "memory.h"
+#include "string.h"
 #include "stringbuilder.h"
 
 // ═══════════════════════════════ Preprocessor ═══════════════════════════════
 
 #define STRINGBUILDER_DEFAULT_SIZE 64
 
+#define STRINGFORMAT_DEFAULT_SIZE 8
+
+#define STRINGBUILDER_MIN_READ 4096
+
+#define END_OF_FILE 0
+
+// Large enough for any uint64_t, int64_t or fast-path double conversion
+#define FORMAT_NUMBER_BUFSIZE 48
+
+// Maximum %f precision supported by the fast-path double conversion
+#define FORMAT_MAX_PRECISION 9
+
 // ═════════════════════════════════ Typedefs ═════════════════════════════════
 
 
@@ -53,9 +70,19 @@
 /*
  * Static functions in C restrict their scope to the file where they are declared
  */
+static inline void reallocBuffer(register StringBuilder* strBuilder, const uint32_t origSize) {
+	if (strBuilder->arena == NULL) {
+		strBuilder->buffer = f668c4bd_realloc_void_size_size(strBuilder->buffer, sizeof(char), strBuilder->size);
+	} else {
+		strBuilder->buffer = eab6f0ff_realloc(strBuilder->arena, strBuilder->buffer, origSize, strBuilder->size);
+	}
+}
+
 static inline char *resizeStringBuilder(StringBuilder* strBuilder) {
+	const uint32_t origSize = strBuilder->size;
+
 	strBuilder->size <<= 1;
-	strBuilder->buffer = f668c4bd_realloc_void_size_size(strBuilder->buffer, sizeof(char), strBuilder->size);
+	reallocBuffer(strBuilder, origSize);
 
 	return strBuilder->buffer + strBuilder->length;
 }
@@ -69,6 +96,338 @@ static inline void appendNull(StringBuilder* strBuilder, char *target) {
 	*target = '\0';
 }
 
+static inline char *ensureCapacity(StringBuilder* strBuilder, const uint32_t numChars) {
+	// Leave room for the null-termination character
+	const uint32_t newLength = strBuilder->length + numChars;
+
+	if (newLength >= strBuilder->size) {
+		register uint32_t size = strBuilder->size;
+
+		do {
+			size <<= 1;
+		} while (newLength >= size);
+
+		const uint32_t origSize = strBuilder->size;
+
+		strBuilder->size = size;
+		reallocBuffer(strBuilder, origSize);
+	}
+
+	return strBuilder->buffer + strBuilder->length;
+}
+
+static inline char *formatUint64(register char *target, register uint64_t value) {
+	register uint32_t remainder;
+
+	// Convert two digits at a time, from right to left
+	while (value >= 100) {
+		remainder = value % 100;
+		value /= 100;
+		(*--target) = f6215943_digitOnes[remainder];
+		(*--target) = f6215943_digitTens[remainder];
+	}
+
+	if (value < 10) {
+		(*--target) = '0' + value;
+	} else {
+		(*--target) = f6215943_digitOnes[value];
+		(*--target) = f6215943_digitTens[value];
+	}
+
+	return target;
+}
+
+static inline char *formatInt64(register char *target, register const int64_t value) {
+	if (value < 0) {
+		// Negate as unsigned to handle INT64_MIN properly
+		target = formatUint64(target, ~((uint64_t) value) + 1);
+		(*--target) = '-';
+
+		return target;
+	}
+
+	return formatUint64(target, value);
+}
+
+static inline char *formatHex64(register char *target, register uint64_t value) {
+	do {
+		(*--target) = f6215943_digitHex[value & 0x0F];
+		value >>= 4;
+	} while (value);
+
+	return target;
+}
+
+static char *formatDouble(register char *target, double value, const uint32_t precision) {
+	static const uint32_t powersOfTen[FORMAT_MAX_PRECISION + 1] = { 1, 10, 100, 1000, 10000,
+		100000, 1000000, 10000000, 100000000, 1000000000 };
+
+	const bool sign = (value < 0.0);
+
+	if (sign) {
+		value = -value;
+	}
+
+	const uint32_t scale = powersOfTen[precision];
+	uint64_t intPart = (uint64_t) value;
+	uint64_t fracPart = (uint64_t) ((value - intPart) * scale + 0.5);
+
+	// Rounding may carry over into the integer part
+	if (fracPart >= scale) {
+		fracPart -= scale;
+		intPart++;
+	}
+
+	if (precision > 0) {
+		register char *end = target - precision;
+
+		target = formatUint64(target, fracPart);
+
+		while (target != end) {
+			(*--target) = '0';
+		}
+
+		(*--target) = '.';
+	}
+
+	target = formatUint64(target, intPart);
+
+	if (sign) {
+		(*--target) = '-';
+	}
+
+	return target;
+}
+
+static inline void appendChars(register StringBuilder *strBuilder, register const char *source, const uint32_t length) {
+	register char *target = ensureCapacity(strBuilder, length);
+	register const char *end = source + length;
+
+	strBuilder->length += length;
+
+	while (source != end) {
+		*(target++) = *(source++);
+	}
+
+	*target = '\0';
+}
+
+static void appendField(StringBuilder *strBuilder, register const char *source, uint32_t length, const FormatSpec *spec) {
+	register uint32_t padding = (spec->width > length) ? spec->width - length : 0;
+	register char *target = ensureCapacity(strBuilder, length + padding);
+	register const char *end;
+
+	strBuilder->length += length + padding;
+
+	if (!spec->leftAlign) {
+		register const char padChar = (spec->zeroPad) ? '0' : ' ';
+
+		// Zero padding goes between the sign and the digits
+		if (spec->zeroPad && padding > 0 && *source == '-') {
+			*(target++) = *(source++);
+			length--;
+		}
+
+		while (padding) {
+			*(target++) = padChar;
+			padding--;
+		}
+	}
+
+	end = source + length;
+	while (source != end) {
+		*(target++) = *(source++);
+	}
+
+	while (padding) {
+		*(target++) = ' ';
+		padding--;
+	}
+
+	*target = '\0';
+}
+
+static const char *parseFormatSpec(register const char *format, register FormatSpec *spec) {
+	register const char *start = format;
+	register char ch = *format;
+
+	f668c4bd_meminit(spec, sizeof(FormatSpec));
+
+	// Literal text runs until the next conversion
+	if (ch != '%') {
+		do {
+			ch = *(++format);
+		} while (ch && ch != '%');
+
+		spec->literal = start;
+		spec->length = format - start;
+
+		return format;
+	}
+
+	ch = *(++format);
+
+	// %% emits a single percent sign
+	if (ch == '%') {
+		spec->literal = format;
+		spec->length = 1;
+
+		return format + 1;
+	}
+
+	// Flags
+	while (ch == '-' || ch == '0') {
+		if (ch == '-') {
+			spec->leftAlign = true;
+		} else {
+			spec->zeroPad = true;
+		}
+
+		ch = *(++format);
+	}
+
+	// Minimum field width
+	while (ch >= '0' && ch <= '9') {
+		spec->width = (spec->width * 10) + (ch - '0');
+		ch = *(++format);
+	}
+
+	// Precision
+	spec->precision = 6;
+	if (ch == '.') {
+		register uint32_t precision = 0;
+
+		ch = *(++format);
+		while (ch >= '0' && ch <= '9') {
+			precision = (precision * 10) + (ch - '0');
+			ch = *(++format);
+		}
+
+		spec->precision = (precision > FORMAT_MAX_PRECISION) ? FORMAT_MAX_PRECISION : precision;
+	}
+
+	// Length modifiers
+	bool isLong = false;
+	while (ch == 'l' || ch == 'z') {
+		isLong = true;
+		ch = *(++format);
+	}
+
+	switch (ch) {
+		case 'c':
+			spec->type = FORMAT_CHAR;
+			break;
+		case 's':
+			spec->type = FORMAT_STRING;
+			break;
+		case 'S':
+			spec->type = FORMAT_STRING_OBJ;
+			break;
+		case 'd':
+		case 'i':
+			spec->type = (isLong) ? FORMAT_INT64 : FORMAT_INT32;
+			break;
+		case 'u':
+			spec->type = (isLong) ? FORMAT_UINT64 : FORMAT_UINT32;
+			break;
+		case 'x':
+			spec->type = (isLong) ? FORMAT_HEX64 : FORMAT_HEX32;
+			break;
+		case 'f':
+			spec->type = FORMAT_DOUBLE;
+			break;
+		default:
+			// Unsupported conversions are emitted verbatim
+			spec->type = FORMAT_LITERAL;
+			spec->literal = start;
+			spec->length = format - start;
+			spec->width = 0;
+
+			return format;
+	}
+
+	// Left-justified fields are always padded with spaces
+	if (spec->leftAlign) {
+		spec->zeroPad = false;
+	}
+
+	return format + 1;
+}
+
+static void appendFormatSpec(register StringBuilder *strBuilder, register const FormatSpec *spec, va_list *argList) {
+	char numBuffer[FORMAT_NUMBER_BUFSIZE];
+	register char *end = numBuffer + FORMAT_NUMBER_BUFSIZE;
+	register char *start;
+
+	switch (spec->type) {
+		case FORMAT_LITERAL:
+			appendChars(strBuilder, spec->literal, spec->length);
+			return;
+		case FORMAT_CHAR:
+			numBuffer[0] = (char) va_arg(*argList, int);
+			appendField(strBuilder, numBuffer, 1, spec);
+			return;
+		case FORMAT_STRING: {
+			const char *string = va_arg(*argList, const char *);
+
+			if (string == NULL) {
+				string = "(null)";
+			}
+
+			appendField(strBuilder, string, f6215943_getLength(string), spec);
+			return;
+		}
+		case FORMAT_STRING_OBJ: {
+			const String *string = va_arg(*argList, const String *);
+
+			if (string == NULL) {
+				appendField(strBuilder, "(null)", 6, spec);
+				return;
+			}
+
+			appendField(strBuilder, string->value, string->length, spec);
+			return;
+		}
+		case FORMAT_INT32:
+			start = formatInt64(end, va_arg(*argList, int32_t));
+			break;
+		case FORMAT_INT64:
+			start = formatInt64(end, va_arg(*argList, int64_t));
+			break;
+		case FORMAT_UINT32:
+			start = formatUint64(end, va_arg(*argList, uint32_t));
+			break;
+		case FORMAT_UINT64:
+			start = formatUint64(end, va_arg(*argList, uint64_t));
+			break;
+		case FORMAT_HEX32:
+			start = formatHex64(end, va_arg(*argList, uint32_t));
+			break;
+		case FORMAT_HEX64:
+			start = formatHex64(end, va_arg(*argList, uint64_t));
+			break;
+		case FORMAT_DOUBLE: {
+			const double value = va_arg(*argList, double);
+
+			// NaN, infinity and anything beyond uint64_t are left to the C library
+			if (!(value > -1.0e18 && value < 1.0e18)) {
+				char bigBuffer[352];
+				const int length = snprintf(bigBuffer, sizeof(bigBuffer), "%.*f", spec->precision, value);
+
+				appendField(strBuilder, bigBuffer, length, spec);
+				return;
+			}
+
+			start = formatDouble(end, value, spec->precision);
+			break;
+		}
+		default:
+			return;
+	}
+
+	appendField(strBuilder, start, end - start, spec);
+}
+
 // ═════════════════════════════ Global Variables ═════════════════════════════
 
 
@@ -83,6 +442,7 @@ StringBuilder *c598a24c_createStringBuilder() {
 	strBuilder->buffer[0] = '\0';
 	strBuilder->length = 0;
 	strBuilder->size = STRINGBUILDER_DEFAULT_SIZE;
+	strBuilder->arena = NULL;
 
 	return strBuilder;
 }
@@ -94,6 +454,7 @@ StringBuilder *c598a24c_createStringBuilder_uint32(const uint32_t bufSize) {
 	strBuilder->buffer[0] = '\0';
 	strBuilder->length = 0;
 	strBuilder->size = bufSize;
+	strBuilder->arena = NULL;
 
 	return strBuilder;
 }
@@ -106,7 +467,9 @@ void c598a24c_destroyStringBuilder(StringBuilder *strBuilder) {
 // ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~
 
 void c598a24c_cleanUpStringBuilder(StringBuilder *strBuilder) {
-	free(strBuilder->buffer);
+	if (strBuilder->arena == NULL) {
+		free(strBuilder->buffer);
+	}
 }
 
 void c598a24c_initStringBuilder(StringBuilder *strBuilder) {
@@ -114,6 +477,7 @@ void c598a24c_initStringBuilder(StringBuilder *strBuilder) {
 	strBuilder->buffer[0] = '\0';
 	strBuilder->length = 0;
 	strBuilder->size = STRINGBUILDER_DEFAULT_SIZE;
+	strBuilder->arena = NULL;
 }
 
 void c598a24c_initStringBuilder_uint32(StringBuilder *strBuilder, const uint32_t bufSize) {
@@ -121,6 +485,34 @@ void c598a24c_initStringBuilder_uint32(StringBuilder *strBuilder, const uint32_t
 	strBuilder->buffer[0] = '\0';
 	strBuilder->length = 0;
 	strBuilder->size = bufSize;
+	strBuilder->arena = NULL;
+}
+
+void c598a24c_initStringBuilder_arena(StringBuilder *strBuilder, Arena *arena, const uint32_t bufSize) {
+	strBuilder->buffer = eab6f0ff_alloc_align(arena, bufSize, 1);
+	strBuilder->buffer[0] = '\0';
+	strBuilder->length = 0;
+	strBuilder->size = bufSize;
+	strBuilder->arena = arena;
+}
+
+void c598a24c_cleanUpStringFormat(StringFormat *strFormat) {
+	f668c4bd_free(strFormat->specs);
+}
+
+void c598a24c_initStringFormat(StringFormat *strFormat, register const char *format) {
+	strFormat->specs = f668c4bd_malloc_size_size(sizeof(FormatSpec), STRINGFORMAT_DEFAULT_SIZE);
+	strFormat->length = 0;
+	strFormat->size = STRINGFORMAT_DEFAULT_SIZE;
+
+	while (*format) {
+		if (strFormat->length == strFormat->size) {
+			strFormat->size <<= 1;
+			strFormat->specs = f668c4bd_realloc_void_size_size(strFormat->specs, sizeof(FormatSpec), strFormat->size);
+		}
+
+		format = parseFormatSpec(format, &strFormat->specs[strFormat->length++]);
+	}
 }
 
 void c598a24c_resetStringBuilder(StringBuilder *strBuilder) {
@@ -143,36 +535,65 @@ void c598a24c_append_char(register StringBuilder *strBuilder, register const cha
 	*target = '\0';
 }
 
-void c598a24c_append_int(StringBuilder *strBuilder, int signedInt) {
-	register char* signedIntStr = f45efac2_toString_int32(signedInt);
+void c598a24c_append_format(StringBuilder *strBuilder, const char *format, ...) {
+	va_list argList;
 
-	c598a24c_append_string(strBuilder, signedIntStr);
+	va_start(argList, format);
+	c598a24c_append_format_va_list(strBuilder, format, &argList);
+	va_end(argList);
+}
 
-	f668c4bd_free(signedIntStr);
+void c598a24c_append_format_va_list(register StringBuilder *strBuilder, register const char *format, va_list *argList) {
+	FormatSpec spec;
+
+	while (*format) {
+		format = parseFormatSpec(format, &spec);
+		appendFormatSpec(strBuilder, &spec, argList);
+	}
 }
 
-void c598a24c_append_int64(register StringBuilder *strBuilder, register const int64_t signedLong) {
-	register char* signedLongStr = db0acb04_toString_int64(signedLong);
+void c598a24c_append_stringFormat(register StringBuilder *strBuilder, const StringFormat *strFormat, ...) {
+	register const FormatSpec *spec = strFormat->specs;
+	register const FormatSpec *end = spec + strFormat->length;
+	va_list argList;
+
+	va_start(argList, strFormat);
+	while (spec != end) {
+		appendFormatSpec(strBuilder, spec++, &argList);
+	}
+	va_end(argList);
+}
 
-	c598a24c_append_string(strBuilder, signedLongStr);
+void c598a24c_append_int(register StringBuilder *strBuilder, register int signedInt) {
+	char numBuffer[FORMAT_NUMBER_BUFSIZE];
+	register char *end = numBuffer + FORMAT_NUMBER_BUFSIZE;
+	register char *start = formatInt64(end, signedInt);
 
-	f668c4bd_free(signedLongStr);
+	appendChars(strBuilder, start, end - start);
 }
 
-void c598a24c_append_uint(StringBuilder *strBuilder, uint32_t unsignedInt) {
-	register char* unsignedIntStr = f45efac2_toString_uint32(unsignedInt);
+void c598a24c_append_int64(register StringBuilder *strBuilder, register const int64_t signedLong) {
+	char numBuffer[FORMAT_NUMBER_BUFSIZE];
+	register char *end = numBuffer + FORMAT_NUMBER_BUFSIZE;
+	register char *start = formatInt64(end, signedLong);
 
-	c598a24c_append_string(strBuilder, unsignedIntStr);
+	appendChars(strBuilder, start, end - start);
+}
 
-	free(unsignedIntStr);
+void c598a24c_append_uint(register StringBuilder *strBuilder, register uint32_t unsignedInt) {
+	char numBuffer[FORMAT_NUMBER_BUFSIZE];
+	register char *end = numBuffer + FORMAT_NUMBER_BUFSIZE;
+	register char *start = formatUint64(end, unsignedInt);
+
+	appendChars(strBuilder, start, end - start);
 }
 
 void c598a24c_append_uint64(register StringBuilder *strBuilder, register const uint64_t unsignedLong) {
-	register char* unsignedLongStr = db0acb04_toString_uint64(unsignedLong);
-
-	c598a24c_append_string(strBuilder, unsignedLongStr);
+	char numBuffer[FORMAT_NUMBER_BUFSIZE];
+	register char *end = numBuffer + FORMAT_NUMBER_BUFSIZE;
+	register char *start = formatUint64(end, unsignedLong);
 
-	f668c4bd_free(unsignedLongStr);
+	appendChars(strBuilder, start, end - start);
 }
 
 void c598a24c_append_string(StringBuilder *strBuilder, const char *source) {
@@ -285,15 +706,9 @@ void c598a24c_append_stringArray(register StringBuilder *strBuilder, register ch
 }
 
 void c598a24c_append_string_uint32(register StringBuilder *strBuilder, register const char *source, const uint32_t length) {
-	register char* target = strBuilder->buffer + strBuilder->length;
-	register const char* end = source + length;
-
 	// Resize strBuilder->buffer if necessary
-	const uint32_t newLength = strBuilder->length + length;
-	if ((newLength + 1) >= strBuilder->size) {
-		strBuilder->size = (newLength >> 2) * 3;
-		target = resizeStringBuilder(strBuilder);
-	}
+	register char* target = ensureCapacity(strBuilder, length);
+	register const char* end = source + length;
 
 	strBuilder->length += length;
 
@@ -303,3 +718,41 @@ void c598a24c_append_string_uint32(register StringBuilder *strBuilder, register
 
 	*target = '\0';
 }
+
+size_t c598a24c_readFile(register StringBuilder *strBuilder, const int fd, const char *pathName) {
+	register ssize_t numBytes;
+	size_t totalBytes = 0;
+
+	while (true) {
+		// ensureCapacity() always leaves room for the null-termination character
+		register char *target = ensureCapacity(strBuilder, STRINGBUILDER_MIN_READ);
+
+		numBytes = read(fd, target, strBuilder->size - strBuilder->length - 1);
+
+		if (numBytes == END_OF_FILE) {
+			*target = '\0';
+			return totalBytes;
+		}
+
+		if (numBytes == SYSTEM_ERROR_CODE) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			StringBuilder errorMessage;
+			c598a24c_initStringBuilder(&errorMessage);
+
+			c598a24c_append_string(&errorMessage, "Cannot read from file '");
+			c598a24c_append_string(&errorMessage, pathName);
+			c598a24c_append_char(&errorMessage, '\'');
+
+			c7c88e52_printLibError(errorMessage.buffer, errno);
+			c598a24c_cleanUpStringBuilder(&errorMessage);
+
+			exit(EXIT_FAILURE);
+		}
+
+		strBuilder->length += numBytes;
+		totalBytes += numBytes;
+	}
+}
@@ -28,10 +28,13 @@
 // ═════════════════════════════════ Includes ═════════════════════════════════
 
 #include <stdlib.h>
+#include <stdarg.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <assert.h>
 
+#include "arena.h"
 #include "memory.h"
 
 #include "../adt/vararg.h"
@@ -45,9 +48,60 @@ typedef struct StringBuilder {
 	char *buffer;                              // Glibc provides aligned_alloc()
 	uint32_t length;
 	uint32_t size;
+	Arena *arena;                              // NULL when the buffer comes from malloc()
 } StringBuilder;
 
-static_assert(sizeof(StringBuilder) == 16, "Check your assumptions");
+static_assert(sizeof(StringBuilder) == 24, "Check your assumptions");
+
+/*
+ * Supported conversions for c598a24c_append_format():
+ *
+ *   %c              char
+ *   %s              char* string
+ *   %S              String* string
+ *   %d %i           int32_t           (%ld %lld %zd -> int64_t)
+ *   %u              uint32_t          (%lu %llu %zu -> uint64_t)
+ *   %x              uint32_t as hex   (%lx %llx %zx -> uint64_t)
+ *   %f              double            (precision defaults to 6, maximum of 9)
+ *   %%              literal percent sign
+ *
+ * Each conversion accepts the '-' (left-justify) and '0' (zero-pad) flags
+ * along with a minimum field width
+ */
+typedef enum FormatSpecType {
+	FORMAT_LITERAL = 0,
+	FORMAT_CHAR,
+	FORMAT_STRING,
+	FORMAT_STRING_OBJ,
+	FORMAT_INT32,
+	FORMAT_INT64,
+	FORMAT_UINT32,
+	FORMAT_UINT64,
+	FORMAT_HEX32,
+	FORMAT_HEX64,
+	FORMAT_DOUBLE
+} FormatSpecType;
+
+typedef struct FormatSpec {
+	const char *literal;                       // Literal text (FORMAT_LITERAL only)
+	uint32_t length;                           // Length of the literal text
+	uint16_t width;                            // Minimum field width
+	uint8_t precision;                         // Digits after the decimal point (%f only)
+	uint8_t type;                              // FormatSpecType
+	bool leftAlign;
+	bool zeroPad;
+	char _padding[6];
+} FormatSpec;
+
+static_assert(sizeof(FormatSpec) == 24, "Check your assumptions");
+
+typedef struct StringFormat {
+	FormatSpec *specs;
+	uint32_t length;
+	uint32_t size;
+} StringFormat;
+
+static_assert(sizeof(StringFormat) == 16, "Check your assumptions");
 
 // ════════════════════════════════ Structures ════════════════════════════════
 
@@ -123,6 +177,42 @@ void c598a24c_initStringBuilder(StringBuilder *strBuilder);
  */
 void c598a24c_initStringBuilder_uint32(StringBuilder *strBuilder, const uint32_t bufSize);
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c598a24c_initStringBuilder_arena
+ * Description: Initializes an existing StringBuilder struct whose buffer is
+ *              allocated from the Arena
+ *        NOTE: The buffer is released along with the Arena, so never free() it
+ *
+ * Parameters:
+ *   strBuilder     A pointer to the StringBuilder instance to initalize
+ *   arena          The Arena to allocate the buffer from
+ *   bufSize        The buffer size to allocate
+ * ----------------------------------------------------------------------------
+ */
+void c598a24c_initStringBuilder_arena(StringBuilder *strBuilder, Arena *arena, const uint32_t bufSize);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c598a24c_cleanUpStringFormat
+ * Description: Frees dynamically allocated memory within the StringFormat instance
+ *
+ * Parameters:
+ *   strFormat      A pointer to the StringFormat instance to clean up
+ * ----------------------------------------------------------------------------
+ */
+void c598a24c_cleanUpStringFormat(StringFormat *strFormat);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c598a24c_initStringFormat
+ * Description: Parses the string format once into a reusable StringFormat instance
+ *        NOTE: The literal text is not copied so the format must outlive the StringFormat
+ *
+ * Parameters:
+ *   strFormat      A pointer to the StringFormat instance to initialize
+ *   format         The string format to parse
+ * ----------------------------------------------------------------------------
+ */
+void c598a24c_initStringFormat(StringFormat *strFormat, const char *format);
+
 /* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
  * Function:    c598a24c_resetStringBuilder
  * Description: Resets an existing StringBuilder instance to the empty state
@@ -151,10 +241,32 @@ void c598a24c_append_char(StringBuilder *strBuilder, const char ch);
  *
  * Parameters:
  *   format     The string format to append
- *   varargs    The list of variable arguments to the string format
+ *   ...        The list of variable arguments to the string format
+ * ----------------------------------------------------------------------------
+ */
+void c598a24c_append_format(StringBuilder *strBuilder, const char *format, ...);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c598a24c_append_format_va_list
+ * Description: Appends a formatted string to the StringBuilder instance
+ *
+ * Parameters:
+ *   format     The string format to append
+ *   argList    The variable argument list to the string format
  * ----------------------------------------------------------------------------
  */
-//void c598a24c_append_format(StringBuilder *strBuilder, char *format, Vararg *varargs);
+void c598a24c_append_format_va_list(StringBuilder *strBuilder, const char *format, va_list *argList);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c598a24c_append_stringFormat
+ * Description: Appends a pre-parsed StringFormat to the StringBuilder instance
+ *
+ * Parameters:
+ *   strFormat  The StringFormat initialized by c598a24c_initStringFormat()
+ *   ...        The list of variable arguments to the string format
+ * ----------------------------------------------------------------------------
+ */
+void c598a24c_append_stringFormat(StringBuilder *strBuilder, const StringFormat *strFormat, ...);
 
 /* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
  * Function:    c598a24c_append_int
@@ -252,4 +364,18 @@ void c598a24c_append_stringArray(StringBuilder *strBuilder, char *const array[])
  */
 void c598a24c_append_string_uint32(StringBuilder *strBuilder, const char *source, const uint32_t length);
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c598a24c_readFile
+ * Description: Reads from the file descriptor until end-of-file, directly into
+ *              the spare capacity of the StringBuilder
+ *
+ * Parameters:
+ *   strBuilder     A pointer to the StringBuilder instance
+ *   fd             The file descriptor to read from
+ *   pathName       The name of the file (used for error reporting)
+ * Returns:         The number of bytes read
+ * ----------------------------------------------------------------------------
+ */
+size_t c598a24c_readFile(StringBuilder *strBuilder, const int fd, const char *pathName);
+
 #endif /* ORG_DEVOPSBROKER_LANG_STRINGBUILDER_H */
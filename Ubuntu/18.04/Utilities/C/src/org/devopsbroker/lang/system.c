@@ -24,13 +24,16 @@
 
 // ════════════════════════════ Feature Test Macros ═══════════════════════════
 
-#define _DEFAULT_SOURCE
+#define _GNU_SOURCE
 
 // ═════════════════════════════════ Includes ═════════════════════════════════
 
+#include <fcntl.h>
+#include <spawn.h>
 #include <stdlib.h>
 #include <unistd.h>
 
+#include <sys/epoll.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 
@@ -42,12 +45,228 @@
 
 // ═══════════════════════════════ Preprocessor ═══════════════════════════════
 
+#define EXECUTE_PIPE_SIZE 1048576
+
+#define EXECUTE_ALL_BUFFER_SIZE 65536
+
+#define EXECUTE_ALL_MAX_EVENTS 32
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+#define HAVE_SPAWN_ADDCHDIR 1
+#endif
 
 // ═════════════════════════════════ Typedefs ═════════════════════════════════
 
+typedef struct ChildStdio {
+	int stdoutFd;                    // Duplicated onto STDOUT, or SYSTEM_ERROR_CODE to inherit
+	int stderrFd;                    // Duplicated onto STDERR, or SYSTEM_ERROR_CODE to inherit
+	int closeFd[2];                  // Closed in the child after the duplication, or SYSTEM_ERROR_CODE
+} ChildStdio;
 
 // ═══════════════════════════ Function Declarations ══════════════════════════
 
+/*
+ * Static functions in C restrict their scope to the file where they are declared
+ */
+static void printSpawnError(const char *path, char *const argv[], const int errorNumber) {
+	StringBuilder errorMessage;
+	c598a24c_initStringBuilder_uint32(&errorMessage, 256);
+
+	c598a24c_append_string(&errorMessage, "Attempt to execute() child process '");
+	c598a24c_append_string(&errorMessage, path);
+	c598a24c_append_string(&errorMessage, "' with arguments '");
+	c598a24c_append_stringArray(&errorMessage, argv);
+	c598a24c_append_string(&errorMessage, "' failed");
+
+	c7c88e52_printLibError(errorMessage.buffer, errorNumber);
+	c598a24c_cleanUpStringBuilder(&errorMessage);
+}
+
+static void initChildStdio(ChildStdio *stdio) {
+	stdio->stdoutFd = SYSTEM_ERROR_CODE;
+	stdio->stderrFd = SYSTEM_ERROR_CODE;
+	stdio->closeFd[0] = SYSTEM_ERROR_CODE;
+	stdio->closeFd[1] = SYSTEM_ERROR_CODE;
+}
+
+#ifndef HAVE_SPAWN_ADDCHDIR
+static int redirectChildStdio(const ChildStdio *stdio, const bool discardStderr) {
+	int nullFd;
+
+	// Only async-signal-safe calls may run between fork() and execve()
+	if (stdio->stdoutFd != SYSTEM_ERROR_CODE && dup2(stdio->stdoutFd, STDOUT_FILENO) == SYSTEM_ERROR_CODE) {
+		return SYSTEM_ERROR_CODE;
+	}
+
+	if (stdio->stderrFd != SYSTEM_ERROR_CODE && dup2(stdio->stderrFd, STDERR_FILENO) == SYSTEM_ERROR_CODE) {
+		return SYSTEM_ERROR_CODE;
+	}
+
+	for (int i = 0; i < 2; i++) {
+		if (stdio->closeFd[i] != SYSTEM_ERROR_CODE) {
+			close(stdio->closeFd[i]);
+		}
+	}
+
+	if (discardStderr) {
+		nullFd = open("/dev/null", O_WRONLY);
+
+		if (nullFd == SYSTEM_ERROR_CODE || dup2(nullFd, STDERR_FILENO) == SYSTEM_ERROR_CODE) {
+			return SYSTEM_ERROR_CODE;
+		}
+
+		close(nullFd);
+	}
+
+	return 0;
+}
+
+static int forkChild(const char *path, char *const argv[], char *const envp[], const ChildStdio *stdio, const ExecuteOptions *options, pid_t *child) {
+	int errorPipe[2];
+	int errorNumber;
+	ssize_t numBytes;
+
+	// The child writes the errno of a failed setup or execve() to the pipe;
+	// a successful execve() closes it instead
+	if (pipe2(errorPipe, O_CLOEXEC) == SYSTEM_ERROR_CODE) {
+		return errno;
+	}
+
+	*child = fork();
+
+	if (*child == SYSTEM_ERROR_CODE) {
+		errorNumber = errno;
+		close(errorPipe[0]);
+		close(errorPipe[1]);
+
+		return errorNumber;
+	}
+
+	if (*child == 0) {
+		if (redirectChildStdio(stdio, options->discardStderr) == 0 && chdir(options->workingDir) == 0) {
+			execve(path, argv, envp);
+		}
+
+		errorNumber = errno;
+		numBytes = write(errorPipe[1], &errorNumber, sizeof(int));
+
+		_exit(127);
+	}
+
+	close(errorPipe[1]);
+
+	do {
+		numBytes = read(errorPipe[0], &errorNumber, sizeof(int));
+	} while (numBytes == SYSTEM_ERROR_CODE && errno == EINTR);
+
+	close(errorPipe[0]);
+
+	// Reap the child that never ran so the error is reported like posix_spawn()
+	if (numBytes == sizeof(int)) {
+		waitpid(*child, NULL, 0);
+		return errorNumber;
+	}
+
+	return 0;
+}
+#endif
+
+static int startChild(const char *path, char *const argv[], const ChildStdio *stdio, const ExecuteOptions *options, pid_t *child) {
+	char *const *envp = (options != NULL && options->envp != NULL) ? options->envp : environ;
+	const char *workingDir = (options != NULL) ? options->workingDir : NULL;
+	posix_spawn_file_actions_t fileActions;
+	int status;
+
+#ifndef HAVE_SPAWN_ADDCHDIR
+	// Changing the working directory of the parent around posix_spawn() would
+	// race with every other thread, so only the forked child changes it
+	if (workingDir != NULL) {
+		return forkChild(path, argv, envp, stdio, options, child);
+	}
+#endif
+
+	posix_spawn_file_actions_init(&fileActions);
+
+	if (stdio->stdoutFd != SYSTEM_ERROR_CODE) {
+		posix_spawn_file_actions_adddup2(&fileActions, stdio->stdoutFd, STDOUT_FILENO);
+	}
+
+	if (stdio->stderrFd != SYSTEM_ERROR_CODE) {
+		posix_spawn_file_actions_adddup2(&fileActions, stdio->stderrFd, STDERR_FILENO);
+	}
+
+	for (int i = 0; i < 2; i++) {
+		if (stdio->closeFd[i] != SYSTEM_ERROR_CODE) {
+			posix_spawn_file_actions_addclose(&fileActions, stdio->closeFd[i]);
+		}
+	}
+
+	if (options != NULL && options->discardStderr) {
+		posix_spawn_file_actions_addopen(&fileActions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+	}
+
+#ifdef HAVE_SPAWN_ADDCHDIR
+	if (workingDir != NULL) {
+		posix_spawn_file_actions_addchdir_np(&fileActions, workingDir);
+	}
+#endif
+
+	// glibc reports a failed execve() of the child through the return value
+	status = posix_spawn(child, path, &fileActions, NULL, argv, envp);
+	posix_spawn_file_actions_destroy(&fileActions);
+
+	return status;
+}
+
+static pid_t spawnChild(const char *path, char *const argv[], const ChildStdio *stdio, const ExecuteOptions *options) {
+	pid_t child;
+	int status = startChild(path, argv, stdio, options, &child);
+
+	if (status != 0) {
+		printSpawnError(path, argv, status);
+		exit(EXIT_FAILURE);
+	}
+
+	return child;
+}
+
+static void createPipe_cloexec(int pipeFd[2]) {
+	// Concurrent children must not inherit the pipes of their siblings
+	if (pipe2(pipeFd, O_CLOEXEC) == SYSTEM_ERROR_CODE) {
+		c7c88e52_printLibError("Cannot create pipe", errno);
+		exit(EXIT_FAILURE);
+	}
+}
+
+static void growPipe(const int fd) {
+	// Best effort: unprivileged callers are capped at /proc/sys/fs/pipe-max-size
+	fcntl(fd, F_SETPIPE_SZ, EXECUTE_PIPE_SIZE);
+}
+
+static void copyFile(const int sourceFd, const int targetFd, const char *path, size_t *totalBytes) {
+	char buffer[EXECUTE_ALL_BUFFER_SIZE];
+	register ssize_t numBytes;
+
+	numBytes = e2f74138_readFile(sourceFd, buffer, EXECUTE_ALL_BUFFER_SIZE, path);
+	while (numBytes != END_OF_FILE) {
+		e2f74138_writeFile(targetFd, buffer, numBytes, path);
+		*totalBytes += numBytes;
+
+		numBytes = e2f74138_readFile(sourceFd, buffer, EXECUTE_ALL_BUFFER_SIZE, path);
+	}
+}
+
+static void addEpollFd(const int epollFd, const int fd, const uint64_t data) {
+	struct epoll_event event;
+
+	event.events = EPOLLIN;
+	event.data.u64 = data;
+
+	if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == SYSTEM_ERROR_CODE) {
+		c7c88e52_printLibError("Cannot add pipe to epoll instance", errno);
+		exit(EXIT_FAILURE);
+	}
+}
 
 // ═════════════════════════════ Global Variables ═════════════════════════════
 
@@ -55,93 +274,263 @@
 // ═════════════════════════ Function Implementations ═════════════════════════
 
 StringBuilder *c16819a0_execute(const char *path, char *const argv[]) {
-	// First configure the pipe to caputre output from the process execution
+	return c16819a0_execute_options(path, argv, NULL);
+}
+
+StringBuilder *c16819a0_execute_options(const char *path, char *const argv[], const ExecuteOptions *options) {
 	Pipe pipe;
-	c31ab0c3_createPipe(&pipe);
+	const pid_t child = c16819a0_execute_pipe_options(path, argv, &pipe, options);
+
+	StringBuilder *execOutput = c598a24c_createStringBuilder_uint32(PIPE_BUFFER_LENGTH);
+
+	// Read straight into the spare capacity of the StringBuilder
+	c598a24c_readFile(execOutput, *pipe.read, path);
+	c31ab0c3_closeRead(&pipe);
+
+	c16819a0_waitForChild(child);
 
-	pid_t child = fork();
+	// Program execution succeeded
+	return execOutput;
+}
+
+void c16819a0_initExecuteCommand(ExecuteCommand *command, const char *path, char *const argv[]) {
+	command->path = path;
+	command->argv = argv;
+	command->options = NULL;
+	command->pid = 0;
+	command->exitStatus = 0;
+	command->outputFd = SYSTEM_ERROR_CODE;
+	command->errorFd = SYSTEM_ERROR_CODE;
+
+	c598a24c_initStringBuilder(&command->output);
+	c598a24c_initStringBuilder(&command->error);
+}
+
+void c16819a0_cleanUpExecuteCommand(ExecuteCommand *command) {
+	c598a24c_cleanUpStringBuilder(&command->output);
+	c598a24c_cleanUpStringBuilder(&command->error);
+}
 
-	if (child == SYSTEM_ERROR_CODE) {
-		c7c88e52_printLibError("Attempt to fork() child process failed", errno);
+void c16819a0_executeAll(ExecuteCommand *commands, const uint32_t numCommands) {
+	ChildStdio stdio;
+	struct epoll_event events[EXECUTE_ALL_MAX_EVENTS];
+	char buffer[EXECUTE_ALL_BUFFER_SIZE];
+	int outputPipe[2], errorPipe[2];
+	register ExecuteCommand *command;
+	register ssize_t numBytes;
+	uint32_t numOpenFds = 0;
+	int numEvents;
+
+	int epollFd = epoll_create1(EPOLL_CLOEXEC);
+
+	if (epollFd == SYSTEM_ERROR_CODE) {
+		c7c88e52_printLibError("Cannot create epoll instance", errno);
 		exit(EXIT_FAILURE);
-	} else if (child > 0) {
-		// We are actually in the "parent"
-		c31ab0c3_closeWrite(&pipe);
-
-		StringBuilder *execOutput = c598a24c_createStringBuilder_uint32(PIPE_BUFFER_LENGTH);
-		char buffer[PIPE_BUFFER_LENGTH];
-		register ssize_t numBytes;
-
-		numBytes = e2f74138_readFile(*pipe.read, buffer, PIPE_BUFFER_LENGTH, path);
-		while (numBytes != END_OF_FILE) {
-			c598a24c_append_string_uint32(execOutput, buffer, numBytes);
-			numBytes = e2f74138_readFile(*pipe.read, buffer, PIPE_BUFFER_LENGTH, path);
-		}
-		c31ab0c3_closeRead(&pipe);
+	}
+
+	// Launch every command before reading any output
+	for (uint32_t i = 0; i < numCommands; i++) {
+		command = &commands[i];
 
-		c16819a0_waitForChild(child);
+		createPipe_cloexec(outputPipe);
+		createPipe_cloexec(errorPipe);
+		growPipe(outputPipe[0]);
 
-		// Program execution succeeded
-		return execOutput;
+		initChildStdio(&stdio);
+		stdio.stdoutFd = outputPipe[1];
+		stdio.stderrFd = errorPipe[1];
 
-	} else {
-		// We are actually in the "child"
-		c31ab0c3_redirectToStdout(&pipe);
-		c31ab0c3_closeRead(&pipe);
+		command->pid = spawnChild(command->path, command->argv, &stdio, command->options);
 
-		if (execv(path, argv) == SYSTEM_ERROR_CODE) {
-			register StringBuilder *errorMessage = c598a24c_createStringBuilder_uint32(256);
+		close(outputPipe[1]);
+		close(errorPipe[1]);
 
-			c598a24c_append_string(errorMessage, "Attempt to execute() child process '");
-			c598a24c_append_string(errorMessage, path);
-			c598a24c_append_string(errorMessage, "' with arguments '");
-			c598a24c_append_stringArray(errorMessage, argv);
-			c598a24c_append_string(errorMessage, "' failed");
+		command->outputFd = outputPipe[0];
+		command->errorFd = errorPipe[0];
 
-			c7c88e52_printLibError(errorMessage->buffer, errno);
-			c598a24c_destroyStringBuilder(errorMessage);
+		// The low bit of the event data selects STDOUT or STDERR
+		addEpollFd(epollFd, command->outputFd, ((uint64_t) i) << 1);
+		addEpollFd(epollFd, command->errorFd, (((uint64_t) i) << 1) | 1);
+		numOpenFds += 2;
+	}
+
+	while (numOpenFds > 0) {
+		numEvents = epoll_wait(epollFd, events, EXECUTE_ALL_MAX_EVENTS, -1);
+
+		if (numEvents == SYSTEM_ERROR_CODE) {
+			if (errno == EINTR) {
+				continue;
+			}
 
+			c7c88e52_printLibError("Attempt to epoll_wait() on child processes failed", errno);
 			exit(EXIT_FAILURE);
 		}
+
+		for (int j = 0; j < numEvents; j++) {
+			const uint64_t data = events[j].data.u64;
+			command = &commands[data >> 1];
+
+			int *fd = (data & 1) ? &command->errorFd : &command->outputFd;
+			StringBuilder *strBuilder = (data & 1) ? &command->error : &command->output;
+
+			numBytes = read(*fd, buffer, EXECUTE_ALL_BUFFER_SIZE);
+
+			if (numBytes > 0) {
+				c598a24c_append_string_uint32(strBuilder, buffer, numBytes);
+			} else if (numBytes == 0 || errno != EINTR) {
+				// End of output; a child that is still finishing its exec can hold a
+				// copy of the pipe open, so the fd is removed from the epoll set first
+				epoll_ctl(epollFd, EPOLL_CTL_DEL, *fd, NULL);
+				close(*fd);
+				*fd = SYSTEM_ERROR_CODE;
+				numOpenFds--;
+			}
+		}
 	}
 
-	return NULL;
+	close(epollFd);
+
+	for (uint32_t i = 0; i < numCommands; i++) {
+		commands[i].exitStatus = c16819a0_waitForExitStatus(commands[i].pid);
+	}
 }
 
-pid_t c16819a0_execute_pipe(const char *path, char *const argv[], Pipe *pipe) {
-	// First configure the pipe to caputre output from the process execution
-	c31ab0c3_createPipe(pipe);
+size_t c16819a0_execute_chunkBuilder(const char *path, char *const argv[], ChunkBuilder *chunkBuilder) {
+	Pipe pipe;
+	const pid_t child = c16819a0_execute_pipe(path, argv, &pipe);
 
-	pid_t child = fork();
+	// Read straight into the spare capacity of the ChunkBuilder
+	const size_t numBytes = f485dc30_readFile(chunkBuilder, *pipe.read, path);
+	c31ab0c3_closeRead(&pipe);
 
-	if (child == SYSTEM_ERROR_CODE) {
-		c7c88e52_printLibError("Attempt to fork() child process failed", errno);
-		exit(EXIT_FAILURE);
-	} else if (child > 0) {
-		// We are actually in the "parent"
-		c31ab0c3_closeWrite(pipe);
+	c16819a0_waitForChild(child);
+
+	return numBytes;
+}
+
+size_t c16819a0_execute_fd(const char *path, char *const argv[], const int fd) {
+	Pipe pipe;
+	const pid_t child = c16819a0_execute_pipe(path, argv, &pipe);
+	register ssize_t numBytes;
+	size_t totalBytes = 0;
 
-		return child;
-	} else {
-		// We are actually in the "child"
-		c31ab0c3_redirectToStdout(pipe);
-		c31ab0c3_closeRead(pipe);
+	// Move the output from the pipe to the file without copying it to userspace
+	while (true) {
+		numBytes = splice(*pipe.read, NULL, fd, NULL, EXECUTE_PIPE_SIZE, SPLICE_F_MOVE | SPLICE_F_MORE);
+
+		if (numBytes == END_OF_FILE) {
+			break;
+		}
+
+		if (numBytes == SYSTEM_ERROR_CODE) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			// Files opened with O_APPEND and some filesystems cannot be spliced into
+			if (errno == EINVAL) {
+				copyFile(*pipe.read, fd, path, &totalBytes);
+				break;
+			}
 
-		if (execv(path, argv) == SYSTEM_ERROR_CODE) {
 			StringBuilder errorMessage;
-			c598a24c_initStringBuilder_uint32(&errorMessage, 256);
+			c598a24c_initStringBuilder(&errorMessage);
 
-			c598a24c_append_string(&errorMessage, "Attempt to execute() child process '");
+			c598a24c_append_string(&errorMessage, "Cannot splice output of '");
 			c598a24c_append_string(&errorMessage, path);
-			c598a24c_append_string(&errorMessage, "' with arguments '");
-			c598a24c_append_stringArray(&errorMessage, argv);
-			c598a24c_append_string(&errorMessage, "' failed");
+			c598a24c_append_char(&errorMessage, '\'');
 
 			c7c88e52_printLibError(errorMessage.buffer, errno);
+			c598a24c_cleanUpStringBuilder(&errorMessage);
+
+			exit(EXIT_FAILURE);
 		}
+
+		totalBytes += numBytes;
+	}
+	c31ab0c3_closeRead(&pipe);
+
+	c16819a0_waitForChild(child);
+
+	return totalBytes;
+}
+
+pid_t c16819a0_execute_pipe(const char *path, char *const argv[], Pipe *pipe) {
+	return c16819a0_execute_pipe_options(path, argv, pipe, NULL);
+}
+
+pid_t c16819a0_execute_pipe_options(const char *path, char *const argv[], Pipe *pipe, const ExecuteOptions *options) {
+	ChildStdio stdio;
+	pid_t child;
+
+	// First configure the pipe to caputre output from the process execution
+	c31ab0c3_createPipe(pipe);
+	growPipe(*pipe->read);
+
+	// The child writes STDOUT into the pipe and inherits neither pipe descriptor
+	initChildStdio(&stdio);
+	stdio.stdoutFd = *pipe->write;
+	stdio.closeFd[0] = *pipe->read;
+	stdio.closeFd[1] = *pipe->write;
+
+	child = spawnChild(path, argv, &stdio, options);
+
+	c31ab0c3_closeWrite(pipe);
+
+	return child;
+}
+
+pid_t c16819a0_spawn(const char *path, char *const argv[], const ExecuteOptions *options) {
+	ChildStdio stdio;
+
+	initChildStdio(&stdio);
+
+	return spawnChild(path, argv, &stdio, options);
+}
+
+pid_t c16819a0_trySpawn(const char *path, char *const argv[], const ExecuteOptions *options) {
+	ChildStdio stdio;
+	pid_t child;
+	int status;
+
+	initChildStdio(&stdio);
+	status = startChild(path, argv, &stdio, options, &child);
+
+	if (status != 0) {
+		errno = status;
+		return SYSTEM_ERROR_CODE;
+	}
+
+	return child;
+}
+
+int c16819a0_waitForExitStatus(const pid_t child) {
+	int status;
+	pid_t pid = waitpid(child, &status, 0);
+
+	while (pid == SYSTEM_ERROR_CODE && errno == EINTR) {
+		pid = waitpid(child, &status, 0);
+	}
+
+	if (pid == SYSTEM_ERROR_CODE) {
+		StringBuilder errorMessage;
+		c598a24c_initStringBuilder(&errorMessage);
+
+		c598a24c_append_string(&errorMessage, "Attempt to wait() on child process '");
+		c598a24c_append_int(&errorMessage, child);
+		c598a24c_append_string(&errorMessage, "' failed");
+
+		c7c88e52_printLibError(errorMessage.buffer, errno);
+
+		exit(EXIT_FAILURE);
+	}
+
+	if (WIFEXITED(status)) {
+		return WEXITSTATUS(status);
 	}
 
-	exit(EXIT_FAILURE);
+	// Follow the shell convention for children terminated by a signal
+	return 128 + WTERMSIG(status);
 }
 
 void c16819a0_waitForChild(const pid_t child) {
@@ -153,7 +542,7 @@ void c16819a0_waitForChild(const pid_t child) {
 		c598a24c_initStringBuilder(&errorMessage);
 
 		c598a24c_append_string(&errorMessage, "Attempt to wait() on child process '");
-		c598a24c_append_int32(&errorMessage, child);
+		c598a24c_append_int(&errorMessage, child);
 		c598a24c_append_string(&errorMessage, "' failed");
 
 		c7c88e52_printLibError(errorMessage.buffer, errno);
@@ -166,7 +555,7 @@ void c16819a0_waitForChild(const pid_t child) {
 		c598a24c_initStringBuilder(&errorMessage);
 
 		c598a24c_append_string(&errorMessage, "Invalid child process exit status '");
-		c598a24c_append_int32(&errorMessage, status);
+		c598a24c_append_int(&errorMessage, status);
 		c598a24c_append_char(&errorMessage, '\'');
 
 		c7c88e52_printError_string(errorMessage.buffer);
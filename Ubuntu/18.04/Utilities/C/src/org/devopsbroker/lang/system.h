@@ -27,6 +27,13 @@
 
 // ═════════════════════════════════ Includes ═════════════════════════════════
 
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <assert.h>
+#include <sys/types.h>
+
+#include "chunkbuilder.h"
 #include "stringbuilder.h"
 
 #include "../io/pipe.h"
@@ -36,6 +43,28 @@
 
 // ═════════════════════════════════ Typedefs ═════════════════════════════════
 
+typedef struct ExecuteOptions {
+	char *const *envp;               // NULL to inherit the environment
+	const char *workingDir;          // NULL to inherit the working directory
+	bool discardStderr;              // Redirect STDERR to /dev/null
+	char _padding[7];
+} ExecuteOptions;
+
+static_assert(sizeof(ExecuteOptions) == 24, "Check your assumptions");
+
+typedef struct ExecuteCommand {
+	const char *path;
+	char *const *argv;
+	const ExecuteOptions *options;   // NULL for the default options
+	StringBuilder output;            // STDOUT output of the command
+	StringBuilder error;             // STDERR output of the command
+	pid_t pid;
+	int exitStatus;
+	int outputFd;
+	int errorFd;
+} ExecuteCommand;
+
+static_assert(sizeof(ExecuteCommand) == 88, "Check your assumptions");
 
 // ═════════════════════════════ Global Variables ═════════════════════════════
 
@@ -46,6 +75,9 @@
  * Function:    c16819a0_execute
  * Description: Executes the specified file with the specified arguments
  *        NOTE: Terminate the argv[] array with NULL as the last value
+ *        NOTE: The child is started with posix_spawn(), which glibc implements
+ *              with vfork semantics so the cost does not grow with the size
+ *              of the parent process
  *
  * Parameters:
  *   path       The name of the file to execute
@@ -55,6 +87,92 @@
  */
 StringBuilder *c16819a0_execute(const char *path, char *const argv[]);
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c16819a0_execute_options
+ * Description: Executes the specified file with the specified arguments in the
+ *              environment and working directory given by the ExecuteOptions
+ *        NOTE: Terminate the argv[] and envp[] arrays with NULL as the last value
+ *        NOTE: Before glibc 2.29 posix_spawn() cannot change the working directory
+ *              of the child, so a child with a workingDir is started with fork()
+ *
+ * Parameters:
+ *   path       The name of the file to execute
+ *   argv       The argument list available to the new program
+ *   options    The ExecuteOptions to apply to the new program (may be NULL)
+ * Returns:     A StringBuilder containing the STDOUT output from the program execution
+ * ----------------------------------------------------------------------------
+ */
+StringBuilder *c16819a0_execute_options(const char *path, char *const argv[], const ExecuteOptions *options);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c16819a0_initExecuteCommand
+ * Description: Initializes an ExecuteCommand struct for c16819a0_executeAll()
+ *        NOTE: Terminate the argv[] array with NULL as the last value
+ *
+ * Parameters:
+ *   command    A pointer to the ExecuteCommand instance to initalize
+ *   path       The name of the file to execute
+ *   argv       The argument list available to the new program
+ * ----------------------------------------------------------------------------
+ */
+void c16819a0_initExecuteCommand(ExecuteCommand *command, const char *path, char *const argv[]);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c16819a0_cleanUpExecuteCommand
+ * Description: Frees the output buffers of the ExecuteCommand struct
+ *
+ * Parameters:
+ *   command    A pointer to the ExecuteCommand instance to clean up
+ * ----------------------------------------------------------------------------
+ */
+void c16819a0_cleanUpExecuteCommand(ExecuteCommand *command);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c16819a0_executeAll
+ * Description: Executes every command at once and collects their STDOUT and
+ *              STDERR output and exit statuses
+ *        NOTE: The pipes of all children are multiplexed with epoll, so the
+ *              total latency is roughly that of the slowest command
+ *
+ * Parameters:
+ *   commands       The array of ExecuteCommand instances to execute
+ *   numCommands    The number of commands in the array
+ * ----------------------------------------------------------------------------
+ */
+void c16819a0_executeAll(ExecuteCommand *commands, const uint32_t numCommands);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c16819a0_execute_chunkBuilder
+ * Description: Executes the specified file with the specified arguments and
+ *              appends its STDOUT output to the ChunkBuilder without ever
+ *              copying previously captured output
+ *        NOTE: Terminate the argv[] array with NULL as the last value
+ *
+ * Parameters:
+ *   path           The name of the file to execute
+ *   argv           The argument list available to the new program
+ *   chunkBuilder   The ChunkBuilder instance to append the output to
+ * Returns:         The number of bytes captured from the program execution
+ * ----------------------------------------------------------------------------
+ */
+size_t c16819a0_execute_chunkBuilder(const char *path, char *const argv[], ChunkBuilder *chunkBuilder);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c16819a0_execute_fd
+ * Description: Executes the specified file with the specified arguments and
+ *              writes its STDOUT output to the file descriptor
+ *        NOTE: The output is moved with splice() so it never passes through a
+ *              userspace buffer; files opened with O_APPEND fall back to copying
+ *
+ * Parameters:
+ *   path       The name of the file to execute
+ *   argv       The argument list available to the new program
+ *   fd         The file descriptor to write the output to
+ * Returns:     The number of bytes written to the file descriptor
+ * ----------------------------------------------------------------------------
+ */
+size_t c16819a0_execute_fd(const char *path, char *const argv[], const int fd);
+
 /* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
  * Function:    c16819a0_execute_pipe
  * Description: Executes the specified file with the specified arguments
@@ -69,6 +187,67 @@ StringBuilder *c16819a0_execute(const char *path, char *const argv[]);
  */
 pid_t c16819a0_execute_pipe(const char *path, char *const argv[], Pipe *pipe);
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c16819a0_execute_pipe_options
+ * Description: Executes the specified file with the specified arguments in the
+ *              environment and working directory given by the ExecuteOptions
+ *        NOTE: Terminate the argv[] and envp[] arrays with NULL as the last value
+ *        NOTE: Before glibc 2.29 posix_spawn() cannot change the working directory
+ *              of the child, so a child with a workingDir is started with fork()
+ *
+ * Parameters:
+ *   path       The name of the file to execute
+ *   argv       The argument list available to the new program
+ *   pipe       The Pipe struct instance to utilize
+ *   options    The ExecuteOptions to apply to the new program (may be NULL)
+ * Returns:     The PID of the child process
+ * ----------------------------------------------------------------------------
+ */
+pid_t c16819a0_execute_pipe_options(const char *path, char *const argv[], Pipe *pipe, const ExecuteOptions *options);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c16819a0_spawn
+ * Description: Executes the specified file with the specified arguments without
+ *              capturing its output; STDIN and STDOUT are inherited
+ *        NOTE: Terminate the argv[] array with NULL as the last value
+ *
+ * Parameters:
+ *   path       The name of the file to execute
+ *   argv       The argument list available to the new program
+ *   options    The ExecuteOptions to apply to the new program (may be NULL)
+ * Returns:     The PID of the child process
+ * ----------------------------------------------------------------------------
+ */
+pid_t c16819a0_spawn(const char *path, char *const argv[], const ExecuteOptions *options);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c16819a0_trySpawn
+ * Description: Same as c16819a0_spawn() except a failure to start the child is
+ *              returned to the caller instead of terminating the process
+ *        NOTE: Terminate the argv[] array with NULL as the last value
+ *
+ * Parameters:
+ *   path       The name of the file to execute
+ *   argv       The argument list available to the new program
+ *   options    The ExecuteOptions to apply to the new program (may be NULL)
+ * Returns:     The PID of the child process, or SYSTEM_ERROR_CODE with errno set
+ * ----------------------------------------------------------------------------
+ */
+pid_t c16819a0_trySpawn(const char *path, char *const argv[], const ExecuteOptions *options);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    c16819a0_waitForExitStatus
+ * Description: Waits for the child process with PID to complete and returns its
+ *              exit status instead of treating a failure as fatal
+ *
+ * Parameters:
+ *   child      The PID of the child process to wait on
+ * Returns:     The exit status of the child, or 128 + the signal number if the
+ *              child was terminated by a signal
+ * ----------------------------------------------------------------------------
+ */
+int c16819a0_waitForExitStatus(const pid_t child);
+
 /* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
  * Function:    c16819a0_waitForChild
  * Description: Waits for the child process with PID to complete
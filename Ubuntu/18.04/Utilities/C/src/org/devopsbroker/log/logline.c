@@ -41,6 +41,8 @@
 
 // ═══════════════════════════ Function Declarations ══════════════════════════
 
+static void cloneFields(LogLine *clone, LogLine *logLine);
+
 static inline char *terminateField(char *field) {
 	register char ch = *field;
 
@@ -71,11 +73,25 @@ LogLine *b45c9f7e_createLogLine() {
 	return logLine;
 }
 
+LogLine *b45c9f7e_createLogLine_pool(ObjectPool *objectPool) {
+	LogLine *logLine = e744848d_alloc(objectPool);
+
+	// Perform initializations
+	f668c4bd_meminit(logLine, sizeof(LogLine));
+
+	return logLine;
+}
+
 void b45c9f7e_destroyLogLine(LogLine *logLine) {
 	f668c4bd_free(logLine->in);
 	f668c4bd_free(logLine);
 }
 
+void b45c9f7e_destroyLogLine_pool(LogLine *logLine, ObjectPool *objectPool) {
+	f668c4bd_free(logLine->in);
+	e744848d_free(objectPool, logLine);
+}
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 void b45c9f7e_initLogLine(LogLine *logLine, String *line) {
@@ -140,18 +156,15 @@ void b45c9f7e_initLogLine(LogLine *logLine, String *line) {
 
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-LogLine *b45c9f7e_cloneLogLine(LogLine *logLine) {
-	register LogLine *clone = f668c4bd_malloc(sizeof(LogLine));
-
-	// in
-	clone->in = f6215943_copy(logLine->in, logLine->lineLength);
-
+static void cloneFields(register LogLine *clone, register LogLine *logLine) {
 	// out
 	clone->out = (clone->in + (logLine->out - logLine->in));
 
 	// macAddress
 	if (logLine->macAddress != NULL) {
 		clone->macAddress = (clone->in + (logLine->macAddress - logLine->in));
+	} else {
+		clone->macAddress = NULL;
 	}
 
 	// sourceIPAddr
@@ -181,6 +194,30 @@ LogLine *b45c9f7e_cloneLogLine(LogLine *logLine) {
 
 	// count
 	clone->count = logLine->count;
+}
+
+LogLine *b45c9f7e_cloneLogLine(LogLine *logLine) {
+	register LogLine *clone = f668c4bd_malloc(sizeof(LogLine));
+
+	// in
+	clone->in = f6215943_copy(logLine->in, logLine->lineLength);
+
+	cloneFields(clone, logLine);
 
 	return clone;
 }
+
+LogLine *b45c9f7e_cloneLogLine_arena(LogLine *logLine, Arena *arena) {
+	register LogLine *clone = eab6f0ff_alloc(arena, sizeof(LogLine));
+
+	b45c9f7e_copyLogLine_arena(clone, logLine, arena);
+
+	return clone;
+}
+
+void b45c9f7e_copyLogLine_arena(LogLine *clone, LogLine *logLine, Arena *arena) {
+	// in
+	clone->in = eab6f0ff_strdup(arena, logLine->in, logLine->lineLength);
+
+	cloneFields(clone, logLine);
+}
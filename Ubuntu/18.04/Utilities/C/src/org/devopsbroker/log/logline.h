@@ -31,6 +31,8 @@
 
 #include <assert.h>
 
+#include "../lang/arena.h"
+#include "../lang/objectpool.h"
 #include "../lang/string.h"
 
 // ═══════════════════════════════ Preprocessor ═══════════════════════════════
@@ -69,6 +71,17 @@ static_assert(sizeof(LogLine) == 64, "Check your assumptions");
  */
 LogLine *b45c9f7e_createLogLine();
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    b45c9f7e_createLogLine_pool
+ * Description: Creates a LogLine struct instance from the ObjectPool
+ *
+ * Parameters:
+ *   objectPool A pointer to an ObjectPool of sizeof(LogLine) objects
+ * Returns:     A LogLine struct instance
+ * ----------------------------------------------------------------------------
+ */
+LogLine *b45c9f7e_createLogLine_pool(ObjectPool *objectPool);
+
 /* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
  * Function:    b45c9f7e_destroyLogLine
  * Description: Frees the memory allocated to the LogLine struct pointer
@@ -79,6 +92,17 @@ LogLine *b45c9f7e_createLogLine();
  */
 void b45c9f7e_destroyLogLine(LogLine *logLine);
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    b45c9f7e_destroyLogLine_pool
+ * Description: Returns the LogLine struct pointer to the ObjectPool
+ *
+ * Parameters:
+ *   logLine	A pointer to the LogLine instance to destroy
+ *   objectPool The ObjectPool the LogLine was created from
+ * ----------------------------------------------------------------------------
+ */
+void b45c9f7e_destroyLogLine_pool(LogLine *logLine, ObjectPool *objectPool);
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 /* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
@@ -105,4 +129,29 @@ void b45c9f7e_initLogLine(LogLine *logLine, String *line);
  */
 LogLine *b45c9f7e_cloneLogLine(LogLine *logLine);
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    b45c9f7e_cloneLogLine_arena
+ * Description: Clones the LogLine contents into memory owned by the Arena
+ *
+ * Parameters:
+ *   logLine    The LogLine instance to clone
+ *   arena      The Arena to allocate the clone from
+ * Returns:     A cloned instance of the LogLine
+ * ----------------------------------------------------------------------------
+ */
+LogLine *b45c9f7e_cloneLogLine_arena(LogLine *logLine, Arena *arena);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    b45c9f7e_copyLogLine_arena
+ * Description: Copies the LogLine contents into an existing LogLine struct with
+ *              the line data allocated from the Arena
+ *
+ * Parameters:
+ *   clone      A pointer to the LogLine instance to copy into
+ *   logLine    The LogLine instance to copy
+ *   arena      The Arena to allocate the line data from
+ * ----------------------------------------------------------------------------
+ */
+void b45c9f7e_copyLogLine_arena(LogLine *clone, LogLine *logLine, Arena *arena);
+
 #endif /* ORG_DEVOPSBROKER_LOG_LOGLINE_H */
@@ -0,0 +1,63 @@
+/*
+ * ipv4address.c - DevOpsBroker C source file for the org.devopsbroker.net.IPv4Address struct
+ *
+ * Copyright (C) 2018-2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.1 LTS running kernel.osrelease = 4.15.0-38
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+// ════════════════════════════ Feature Test Macros ═══════════════════════════
+
+#define _DEFAULT_SOURCE
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdlib.h>
+
+#include "ipv4address.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+
+// ════════════════════════════ Function Prototypes ═══════════════════════════
+
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═════════════════════════ Function Implementations ═════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Create/Destroy Functions ~~~~~~~~~~~~~~~~~~~~~~~~~
+
+IPv4Address *e1e7e8f5_createIPv4Address_pool(char *ipAddress, ObjectPool *objectPool) {
+	IPv4Address *ipv4Address = e744848d_alloc(objectPool);
+
+	if (e1e7e8f5_initIPv4Address(ipv4Address, ipAddress) != 0) {
+		e744848d_free(objectPool, ipv4Address);
+		return NULL;
+	}
+
+	return ipv4Address;
+}
+
+void e1e7e8f5_destroyIPv4Address_pool(IPv4Address *ipv4Address, ObjectPool *objectPool) {
+	e744848d_free(objectPool, ipv4Address);
+}
@@ -24,6 +24,7 @@
  * following files:
  *
  *   o ipv4address.linux.asm
+ *   o ipv4address.c
  * -----------------------------------------------------------------------------
  */
 
@@ -36,6 +37,8 @@
 
 #include <assert.h>
 
+#include "../lang/objectpool.h"
+
 // ═══════════════════════════════ Preprocessor ═══════════════════════════════
 
 #define IPV4_STRBUF_LEN   20
@@ -76,6 +79,18 @@ static_assert(sizeof(IPv4Address) == 16, "Check your assumptions");
  */
 IPv4Address *e1e7e8f5_createIPv4Address(char *ipAddress);
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e1e7e8f5_createIPv4Address_pool
+ * Description: Creates a IPv4Address struct instance from the ObjectPool
+ *
+ * Parameters:
+ *   ipAddress  A string representation of an IPv4 address
+ *   objectPool A pointer to an ObjectPool of sizeof(IPv4Address) objects
+ * Returns:     A IPv4Address struct instance, or NULL if ipAddress is invalid
+ * ----------------------------------------------------------------------------
+ */
+IPv4Address *e1e7e8f5_createIPv4Address_pool(char *ipAddress, ObjectPool *objectPool);
+
 /* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
  * Function:    e1e7e8f5_destroyIPv4Address
  * Description: Frees the memory allocated to the IPv4Address struct pointer
@@ -86,6 +101,17 @@ IPv4Address *e1e7e8f5_createIPv4Address(char *ipAddress);
  */
 void e1e7e8f5_destroyIPv4Address(IPv4Address *ipv4Address);
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e1e7e8f5_destroyIPv4Address_pool
+ * Description: Returns the IPv4Address struct pointer to the ObjectPool
+ *
+ * Parameters:
+ *   ipv4Address    A pointer to the IPv4Address instance to destroy
+ *   objectPool     The ObjectPool the IPv4Address was created from
+ * ----------------------------------------------------------------------------
+ */
+void e1e7e8f5_destroyIPv4Address_pool(IPv4Address *ipv4Address, ObjectPool *objectPool);
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~ Initialization Functions ~~~~~~~~~~~~~~~~~~~~~~~~~
 
 /* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
@@ -48,6 +48,22 @@
 
 // ═════════════════════════ Function Implementations ═════════════════════════
 
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Create/Destroy Functions ~~~~~~~~~~~~~~~~~~~~~~~~~
+
+IPv6Address *b7808f25_createIPv6Address_pool(char *ipAddress, ObjectPool *objectPool) {
+	IPv6Address *ipv6Address = e744848d_alloc(objectPool);
+
+	if (b7808f25_initIPv6Address(ipv6Address, ipAddress) != 0) {
+		a25c96b2_invalidIPv6Address(ipAddress);
+	}
+
+	return ipv6Address;
+}
+
+void b7808f25_destroyIPv6Address_pool(IPv6Address *ipv6Address, ObjectPool *objectPool) {
+	e744848d_free(objectPool, ipv6Address);
+}
+
 /*
 int b7808f25_initIPv6Address(IPv6Address *ipv6Address, char *ipAddress) {
 
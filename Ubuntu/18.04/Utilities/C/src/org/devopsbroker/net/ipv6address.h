@@ -38,6 +38,8 @@
 
 #include <assert.h>
 
+#include "../lang/objectpool.h"
+
 // ═══════════════════════════════ Preprocessor ═══════════════════════════════
 
 #define IPV6_STRBUF_LEN   48
@@ -69,6 +71,18 @@ static_assert(sizeof(IPv6Address) == 20, "Check your assumptions");
  */
 IPv6Address *b7808f25_createIPv6Address(char *ipAddress);
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    b7808f25_createIPv6Address_pool
+ * Description: Creates an IPv6Address struct instance from the ObjectPool
+ *
+ * Parameters:
+ *   ipAddress  A string representation of an IPv6 address
+ *   objectPool A pointer to an ObjectPool of sizeof(IPv6Address) objects
+ * Returns:     An IPv6Address struct instance
+ * ----------------------------------------------------------------------------
+ */
+IPv6Address *b7808f25_createIPv6Address_pool(char *ipAddress, ObjectPool *objectPool);
+
 /* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
  * Function:    b7808f25_destroyIPv6Address
  * Description: Frees the memory allocated to the IPv6Address struct pointer
@@ -79,6 +93,17 @@ IPv6Address *b7808f25_createIPv6Address(char *ipAddress);
  */
 void b7808f25_destroyIPv6Address(IPv6Address *ipv6Address);
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    b7808f25_destroyIPv6Address_pool
+ * Description: Returns the IPv6Address struct pointer to the ObjectPool
+ *
+ * Parameters:
+ *   ipv6Address	A pointer to the IPv6Address instance to destroy
+ *   objectPool     The ObjectPool the IPv6Address was created from
+ * ----------------------------------------------------------------------------
+ */
+void b7808f25_destroyIPv6Address_pool(IPv6Address *ipv6Address, ObjectPool *objectPool);
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~ Initialization Functions ~~~~~~~~~~~~~~~~~~~~~~~~~
 
 /* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
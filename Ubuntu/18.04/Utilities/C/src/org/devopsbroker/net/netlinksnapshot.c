@@ -0,0 +1,359 @@
+/*
+ * netlinksnapshot.c - DevOpsBroker C source file for the NetlinkSnapshot struct
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+// ════════════════════════════ Feature Test Macros ═══════════════════════════
+
+#define _DEFAULT_SOURCE
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdbool.h>
+#include <string.h>
+
+#include <errno.h>
+
+#include <linux/if_addr.h>
+#include <linux/if_link.h>
+
+#include "netlinksnapshot.h"
+
+#include "../lang/error.h"
+#include "../lang/memory.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define NETLINKSNAPSHOT_DEFAULT_SIZE 16
+
+#define NETLINKSNAPSHOT_REQUEST_SIZE 96
+
+// Added in Linux 4.4 and missing from older kernel headers
+#ifndef RTEXT_FILTER_SKIP_STATS
+#define RTEXT_FILTER_SKIP_STATS (1 << 3)
+#endif
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+typedef union NetlinkFilterRequest {
+	NetlinkInfoRequest info;
+	NetlinkAddressRequest address;
+	NetlinkRouteRequest route;
+	char buffer[NETLINKSNAPSHOT_REQUEST_SIZE];   // Room for the filter attributes
+} NetlinkFilterRequest;
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+/*
+ * Static functions in C restrict their scope to the file where they are declared
+ */
+static void ensureCapacity(register NetlinkSnapshot *snapshot, const uint32_t index) {
+	if (index >= snapshot->size) {
+		register uint32_t size = (snapshot->size == 0) ? NETLINKSNAPSHOT_DEFAULT_SIZE : snapshot->size;
+
+		while (size <= index) {
+			size <<= 1;
+		}
+
+		snapshot->devices = f668c4bd_realloc(snapshot->devices, sizeof(NetworkDevice) * snapshot->size, sizeof(NetworkDevice) * size);
+		snapshot->names = f668c4bd_realloc(snapshot->names, IFNAMSIZ * snapshot->size, IFNAMSIZ * size);
+
+		f668c4bd_meminit(&snapshot->devices[snapshot->size], sizeof(NetworkDevice) * (size - snapshot->size));
+		f668c4bd_meminit(&snapshot->names[snapshot->size], IFNAMSIZ * (size - snapshot->size));
+
+		snapshot->size = size;
+	}
+}
+
+static void storeLink(void *context, NetlinkMessageHeader *msgHeader) {
+	register NetlinkSnapshot *snapshot = context;
+	NetlinkInfoMessage *infoMessage = (NetlinkInfoMessage *) NLMSG_DATA(msgHeader);
+	NetlinkAttribute *attribute = (NetlinkAttribute *) IFLA_RTA(infoMessage);
+	int attributeLen = IFLA_PAYLOAD(msgHeader);
+	register NetworkDevice *networkDevice;
+	uint32_t index = infoMessage->ifi_index;
+	size_t nameLen;
+
+	if (index == 0) {
+		return;
+	}
+
+	ensureCapacity(snapshot, index);
+	networkDevice = &snapshot->devices[index];
+
+	if (networkDevice->index == 0) {
+		snapshot->length++;
+	}
+
+	networkDevice->index = index;
+	networkDevice->flags = infoMessage->ifi_flags;
+
+	for (; RTA_OK(attribute, attributeLen); attribute = RTA_NEXT(attribute, attributeLen)) {
+		if (attribute->rta_type == IFLA_IFNAME) {
+			nameLen = strnlen(RTA_DATA(attribute), RTA_PAYLOAD(attribute));
+
+			if (nameLen >= IFNAMSIZ) {
+				nameLen = IFNAMSIZ - 1;
+			}
+
+			f668c4bd_memcopy(RTA_DATA(attribute), snapshot->names[index], nameLen);
+			snapshot->names[index][nameLen] = '\0';
+			break;
+		}
+	}
+}
+
+static void storeAddress(void *context, NetlinkMessageHeader *msgHeader) {
+	NetlinkSnapshot *snapshot = context;
+	NetlinkAddressMessage *addrMessage = (NetlinkAddressMessage *) NLMSG_DATA(msgHeader);
+	NetlinkAttribute *attribute = (NetlinkAttribute *) IFA_RTA(addrMessage);
+	int attributeLen = IFA_PAYLOAD(msgHeader);
+	register NetworkDevice *networkDevice = e15c4841_getNetworkDevice(snapshot, addrMessage->ifa_index);
+	IPv6Address *ipv6Address;
+
+	// Addresses of interfaces created after the link dump are ignored
+	if (networkDevice == NULL) {
+		return;
+	}
+
+	for (; RTA_OK(attribute, attributeLen); attribute = RTA_NEXT(attribute, attributeLen)) {
+		if (attribute->rta_type != IFA_ADDRESS) {
+			continue;
+		}
+
+		// The primary address is listed first so secondary addresses never overwrite it
+		if (addrMessage->ifa_family == AF_INET) {
+			if (addrMessage->ifa_scope == RT_SCOPE_UNIVERSE && networkDevice->ipv4Address.address == 0) {
+				networkDevice->ipv4Address.address = *((uint32_t *) RTA_DATA(attribute));
+				networkDevice->ipv4Address.cidrSuffix = addrMessage->ifa_prefixlen;
+			}
+		} else if (addrMessage->ifa_family == AF_INET6) {
+			if (addrMessage->ifa_scope == RT_SCOPE_UNIVERSE) {
+				ipv6Address = &networkDevice->ipv6Global;
+			} else if (addrMessage->ifa_scope == RT_SCOPE_LINK) {
+				ipv6Address = &networkDevice->ipv6Local;
+			} else {
+				break;
+			}
+
+			if (b7808f25_isIpAddressZero(ipv6Address)) {
+				f668c4bd_memcopy(RTA_DATA(attribute), ipv6Address->address, 16);
+				ipv6Address->cidrSuffix = addrMessage->ifa_prefixlen;
+			}
+		}
+
+		break;
+	}
+}
+
+static void storeRoute(void *context, NetlinkMessageHeader *msgHeader) {
+	NetlinkSnapshot *snapshot = context;
+	NetlinkRouteMessage *routeMessage = (NetlinkRouteMessage *) NLMSG_DATA(msgHeader);
+	NetlinkAttribute *attribute = (NetlinkAttribute *) RTM_RTA(routeMessage);
+	int attributeLen = RTM_PAYLOAD(msgHeader);
+	register NetworkDevice *networkDevice = NULL;
+	void *gateway = NULL;
+
+	if (routeMessage->rtm_table != RT_TABLE_MAIN || routeMessage->rtm_type != RTN_UNICAST) {
+		return;
+	}
+
+	for (; RTA_OK(attribute, attributeLen); attribute = RTA_NEXT(attribute, attributeLen)) {
+		if (attribute->rta_type == RTA_GATEWAY) {
+			gateway = RTA_DATA(attribute);
+		} else if (attribute->rta_type == RTA_OIF) {
+			networkDevice = e15c4841_getNetworkDevice(snapshot, *((uint32_t *) RTA_DATA(attribute)));
+		}
+	}
+
+	if (gateway == NULL || networkDevice == NULL) {
+		return;
+	}
+
+	// A default route takes precedence over any other gatewayed route
+	if (routeMessage->rtm_family == AF_INET) {
+		if (networkDevice->ipv4Gateway == 0 || routeMessage->rtm_dst_len == 0) {
+			networkDevice->ipv4Gateway = *((uint32_t *) gateway);
+		}
+	} else if (routeMessage->rtm_family == AF_INET6) {
+		if (b7808f25_isIpAddressZero(&networkDevice->ipv6Gateway) || routeMessage->rtm_dst_len == 0) {
+			f668c4bd_memcopy(gateway, networkDevice->ipv6Gateway.address, 16);
+			networkDevice->ipv6Gateway.cidrSuffix = 0;
+		}
+	}
+}
+
+static void resetSnapshot(register NetlinkSnapshot *snapshot) {
+	f668c4bd_meminit(snapshot->devices, sizeof(NetworkDevice) * snapshot->size);
+	f668c4bd_meminit(snapshot->names, IFNAMSIZ * snapshot->size);
+	snapshot->length = 0;
+}
+
+static void attachNames(register NetlinkSnapshot *snapshot) {
+	// Names are attached last since growing the arrays moves them
+	for (uint32_t i = 1; i < snapshot->size; i++) {
+		if (snapshot->devices[i].index != 0) {
+			snapshot->devices[i].name = snapshot->names[i];
+		}
+	}
+}
+
+static int processRequest(NetlinkSnapshot *snapshot, NetlinkSocket *netlinkSocket, NetlinkMessageHeader *request, const uint16_t flags, NetlinkHandler handler) {
+	request->nlmsg_seq = ++snapshot->sequence;
+
+	return e7173ad4_processRequest(netlinkSocket, request, flags, handler, snapshot);
+}
+
+static void dumpTable(NetlinkSnapshot *snapshot, NetlinkSocket *netlinkSocket, NetlinkMessageHeader *request, NetlinkHandler handler) {
+	int errorNumber = processRequest(snapshot, netlinkSocket, request, NLM_F_REQUEST | NLM_F_DUMP, handler);
+
+	if (errorNumber != 0) {
+		c7c88e52_printLibError("Netlink dump request failed", errorNumber);
+		exit(EXIT_FAILURE);
+	}
+}
+
+static void dumpAddressesAndRoutes(NetlinkSnapshot *snapshot, NetlinkSocket *netlinkSocket, const uint32_t index, const unsigned char family) {
+	NetlinkFilterRequest request;
+	uint32_t routeTable = RT_TABLE_MAIN;
+
+	// With strict checking the kernel drops other interfaces before they are sent
+	e7173ad4_initNetlinkAddressRequest(&request.address, family);
+
+	if (netlinkSocket->strictChecking) {
+		request.address.msgBody.ifa_index = index;
+	}
+
+	dumpTable(snapshot, netlinkSocket, &request.address.msgHeader, storeAddress);
+
+	// The handlers still filter for kernels that ignore the request filters
+	e7173ad4_initNetlinkRouteRequest(&request.route, (SocketProtocol) family);
+
+	// Other AF_UNSPEC families (e.g. MPLS) reject table and type filters
+	if (netlinkSocket->strictChecking && family != AF_UNSPEC) {
+		request.route.msgBody.rtm_type = RTN_UNICAST;
+		e7173ad4_addAttribute(&request.route.msgHeader, sizeof(NetlinkFilterRequest), RTA_TABLE, &routeTable, sizeof(uint32_t));
+
+		if (index != 0) {
+			e7173ad4_addAttribute(&request.route.msgHeader, sizeof(NetlinkFilterRequest), RTA_OIF, &index, sizeof(uint32_t));
+		}
+	}
+
+	dumpTable(snapshot, netlinkSocket, &request.route.msgHeader, storeRoute);
+}
+
+static void initLinkRequest(NetlinkFilterRequest *request) {
+	const uint32_t extMask = RTEXT_FILTER_SKIP_STATS;
+
+	// Interface statistics are the bulk of every RTM_NEWLINK message
+	e7173ad4_initNetlinkInfoRequest(&request->info, 0);
+	request->info.msgBody.ifi_change = 0;
+	e7173ad4_addAttribute(&request->info.msgHeader, sizeof(NetlinkFilterRequest), IFLA_EXT_MASK, &extMask, sizeof(uint32_t));
+}
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═════════════════════════ Function Implementations ═════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void e15c4841_cleanUpNetlinkSnapshot(NetlinkSnapshot *snapshot) {
+	f668c4bd_free(snapshot->devices);
+	f668c4bd_free(snapshot->names);
+
+	snapshot->devices = NULL;
+	snapshot->names = NULL;
+	snapshot->size = 0;
+	snapshot->length = 0;
+}
+
+void e15c4841_initNetlinkSnapshot(NetlinkSnapshot *snapshot) {
+	snapshot->devices = NULL;
+	snapshot->names = NULL;
+	snapshot->size = 0;
+	snapshot->length = 0;
+	snapshot->sequence = 0;
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+NetworkDevice *e15c4841_findNetworkDevice(const NetlinkSnapshot *snapshot, const char *deviceName) {
+	for (uint32_t i = 1; i < snapshot->size; i++) {
+		if (snapshot->devices[i].index != 0 && strcmp(snapshot->names[i], deviceName) == 0) {
+			return &snapshot->devices[i];
+		}
+	}
+
+	return NULL;
+}
+
+bool e15c4841_readNetworkDevice(NetlinkSnapshot *snapshot, NetlinkSocket *netlinkSocket, const char *deviceName, const unsigned char family) {
+	NetlinkFilterRequest request;
+	NetworkDevice *networkDevice;
+	const size_t nameLen = strlen(deviceName);
+	int errorNumber;
+
+	resetSnapshot(snapshot);
+
+	if (nameLen == 0 || nameLen >= IFNAMSIZ) {
+		return false;
+	}
+
+	// A non-dump RTM_GETLINK looks up the name on every kernel version
+	initLinkRequest(&request);
+	e7173ad4_addAttribute(&request.info.msgHeader, sizeof(NetlinkFilterRequest), IFLA_IFNAME, deviceName, nameLen + 1);
+	errorNumber = processRequest(snapshot, netlinkSocket, &request.info.msgHeader, NLM_F_REQUEST | NLM_F_ACK, storeLink);
+
+	if (errorNumber == ENODEV) {
+		return false;
+	} else if (errorNumber != 0) {
+		c7c88e52_printLibError("Netlink link request failed", errorNumber);
+		exit(EXIT_FAILURE);
+	}
+
+	attachNames(snapshot);
+	networkDevice = e15c4841_findNetworkDevice(snapshot, deviceName);
+
+	if (networkDevice == NULL) {
+		return false;
+	}
+
+	dumpAddressesAndRoutes(snapshot, netlinkSocket, networkDevice->index, family);
+
+	return true;
+}
+
+void e15c4841_readNetlinkSnapshot(NetlinkSnapshot *snapshot, NetlinkSocket *netlinkSocket) {
+	NetlinkFilterRequest request;
+
+	resetSnapshot(snapshot);
+
+	// Links first so the address and route handlers can drop unknown indexes
+	initLinkRequest(&request);
+	dumpTable(snapshot, netlinkSocket, &request.info.msgHeader, storeLink);
+
+	// AF_UNSPEC returns both the IPv4 and IPv6 entries in a single dump
+	dumpAddressesAndRoutes(snapshot, netlinkSocket, 0, AF_UNSPEC);
+
+	attachNames(snapshot);
+}
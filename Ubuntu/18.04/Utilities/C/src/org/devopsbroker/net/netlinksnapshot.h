@@ -0,0 +1,151 @@
+/*
+ * netlinksnapshot.h - DevOpsBroker C header file for the NetlinkSnapshot struct
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * A NetlinkSnapshot issues one RTM_GETLINK, one RTM_GETADDR and one RTM_GETROUTE
+ * dump and decodes every message into a NetworkDevice array indexed directly by
+ * the interface index. Any number of address and gateway queries can then be
+ * answered from memory instead of walking a full kernel dump for each one.
+ *
+ * echo ORG_DEVOPSBROKER_NET_NETLINKSNAPSHOT | md5sum | cut -c 25-32
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef ORG_DEVOPSBROKER_NET_NETLINKSNAPSHOT_H
+#define ORG_DEVOPSBROKER_NET_NETLINKSNAPSHOT_H
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <assert.h>
+
+#include <net/if.h>
+
+#include "networkdevice.h"
+
+#include "../socket/netlink.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+typedef struct NetlinkSnapshot {
+	NetworkDevice *devices;        // Indexed by interface index
+	char (*names)[IFNAMSIZ];       // Indexed by interface index
+	uint32_t size;                 // Number of slots in devices and names
+	uint32_t length;               // Number of interfaces present
+	uint32_t sequence;             // Sequence number of the last dump request
+	char _padding[4];
+} NetlinkSnapshot;
+
+static_assert(sizeof(NetlinkSnapshot) == 32, "Check your assumptions");
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e15c4841_cleanUpNetlinkSnapshot
+ * Description: Frees the memory held by the NetlinkSnapshot
+ *
+ * Parameters:
+ *   snapshot       A pointer to the NetlinkSnapshot instance to clean up
+ * ----------------------------------------------------------------------------
+ */
+void e15c4841_cleanUpNetlinkSnapshot(NetlinkSnapshot *snapshot);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e15c4841_initNetlinkSnapshot
+ * Description: Initializes an existing NetlinkSnapshot struct
+ *
+ * Parameters:
+ *   snapshot       A pointer to the NetlinkSnapshot instance to initalize
+ * ----------------------------------------------------------------------------
+ */
+void e15c4841_initNetlinkSnapshot(NetlinkSnapshot *snapshot);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e15c4841_findNetworkDevice
+ * Description: Finds the NetworkDevice with the specified interface name
+ *
+ * Parameters:
+ *   snapshot       A pointer to the NetlinkSnapshot instance to search
+ *   deviceName     The name of the network device
+ * Returns:         The matching NetworkDevice, or NULL if not found
+ * ----------------------------------------------------------------------------
+ */
+NetworkDevice *e15c4841_findNetworkDevice(const NetlinkSnapshot *snapshot, const char *deviceName);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e15c4841_getNetworkDevice
+ * Description: Returns the NetworkDevice with the specified interface index
+ *
+ * Parameters:
+ *   snapshot       A pointer to the NetlinkSnapshot instance
+ *   index          The interface index
+ * Returns:         The matching NetworkDevice, or NULL if not present
+ * ----------------------------------------------------------------------------
+ */
+static inline NetworkDevice *e15c4841_getNetworkDevice(const NetlinkSnapshot *snapshot, const uint32_t index) {
+	return (index < snapshot->size && snapshot->devices[index].index == index) ? &snapshot->devices[index] : NULL;
+}
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e15c4841_readNetworkDevice
+ * Description: Replaces the contents of the NetlinkSnapshot with the named
+ *              network device and its addresses and main table unicast routes
+ *
+ * NOTE: When strict checking is enabled on the NetlinkSocket the kernel
+ *       filters the dumps by interface, table and route type; otherwise the
+ *       full dumps are filtered in userspace
+ *
+ * Parameters:
+ *   snapshot       A pointer to the NetlinkSnapshot instance to populate
+ *   netlinkSocket  A pointer to an open and bound NETLINK_ROUTE NetlinkSocket
+ *   deviceName     The name of the network device
+ *   family         AF_INET, AF_INET6 or AF_UNSPEC for both
+ * Returns:         False if the network device does not exist, true otherwise
+ * ----------------------------------------------------------------------------
+ */
+bool e15c4841_readNetworkDevice(NetlinkSnapshot *snapshot, NetlinkSocket *netlinkSocket, const char *deviceName, const unsigned char family);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e15c4841_readNetlinkSnapshot
+ * Description: Replaces the contents of the NetlinkSnapshot with the current
+ *              links, addresses and main table unicast routes
+ *
+ * NOTE: Each NetworkDevice name points into the NetlinkSnapshot and is only
+ *       valid until the next read or clean up
+ *
+ * Parameters:
+ *   snapshot       A pointer to the NetlinkSnapshot instance to populate
+ *   netlinkSocket  A pointer to an open and bound NETLINK_ROUTE NetlinkSocket
+ * ----------------------------------------------------------------------------
+ */
+void e15c4841_readNetlinkSnapshot(NetlinkSnapshot *snapshot, NetlinkSocket *netlinkSocket);
+
+#endif /* ORG_DEVOPSBROKER_NET_NETLINKSNAPSHOT_H */
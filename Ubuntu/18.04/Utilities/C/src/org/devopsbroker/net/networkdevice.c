@@ -56,6 +56,17 @@ NetworkDevice *f0185083_createNetworkDevice(char* deviceName) {
 
 	networkDevice->name = deviceName;
 	networkDevice->index = 0;
+	networkDevice->flags = 0;
+
+	return networkDevice;
+}
+
+NetworkDevice *f0185083_createNetworkDevice_pool(char* deviceName, ObjectPool *objectPool) {
+	NetworkDevice *networkDevice = e744848d_alloc(objectPool);
+
+	networkDevice->name = deviceName;
+	networkDevice->index = 0;
+	networkDevice->flags = 0;
 
 	return networkDevice;
 }
@@ -64,11 +75,16 @@ void f0185083_destroyNetworkDevice(NetworkDevice *networkDevice) {
 	free(networkDevice);
 }
 
+void f0185083_destroyNetworkDevice_pool(NetworkDevice *networkDevice, ObjectPool *objectPool) {
+	e744848d_free(objectPool, networkDevice);
+}
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~ Initialization Functions ~~~~~~~~~~~~~~~~~~~~~~~~~
 
 void f0185083_initNetworkDevice(NetworkDevice *networkDevice, char* deviceName) {
 	networkDevice->name = deviceName;
 	networkDevice->index = 0;
+	networkDevice->flags = 0;
 }
 
 void f0185083_initNetworkDeviceRequest(NetworkDevice *networkDevice, NetworkDeviceRequest *request) {
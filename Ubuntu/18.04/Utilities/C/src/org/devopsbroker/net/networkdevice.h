@@ -37,6 +37,8 @@
 #include "ipv4address.h"
 #include "ipv6address.h"
 
+#include "../lang/objectpool.h"
+
 #include "../socket/unix.h"
 #include "../socket/netlink.h"
 
@@ -74,7 +76,7 @@ typedef struct NetworkDevice {
 	IPv6Address ipv6Gateway;
 	uint32_t ipv4Gateway;           // e.g. 192.168.1.1
 	uint32_t index;                 // e.g. 2
-	char _padding[4];
+	uint32_t flags;                 // e.g. IFF_UP | IFF_RUNNING
 } NetworkDevice;
 
 static_assert(sizeof(NetworkDevice) == 96, "Check your assumptions");
@@ -97,6 +99,18 @@ static_assert(sizeof(NetworkDevice) == 96, "Check your assumptions");
  */
 NetworkDevice *f0185083_createNetworkDevice(char* deviceName);
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f0185083_createNetworkDevice_pool
+ * Description: Creates a NetworkDevice struct instance from the ObjectPool
+ *
+ * Parameters:
+ *   deviceName     The name of the network device
+ *   objectPool     A pointer to an ObjectPool of sizeof(NetworkDevice) objects
+ * Returns:         A NetworkDevice struct instance
+ * ----------------------------------------------------------------------------
+ */
+NetworkDevice *f0185083_createNetworkDevice_pool(char* deviceName, ObjectPool *objectPool);
+
 /* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
  * Function:    f0185083_destroyNetworkDevice
  * Description: Frees the memory allocated to the NetworkDevice struct pointer
@@ -107,6 +121,17 @@ NetworkDevice *f0185083_createNetworkDevice(char* deviceName);
  */
 void f0185083_destroyNetworkDevice(NetworkDevice *networkDevice);
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f0185083_destroyNetworkDevice_pool
+ * Description: Returns the NetworkDevice struct pointer to the ObjectPool
+ *
+ * Parameters:
+ *   networkDevice	A pointer to the NetworkDevice instance to destroy
+ *   objectPool     The ObjectPool the NetworkDevice was created from
+ * ----------------------------------------------------------------------------
+ */
+void f0185083_destroyNetworkDevice_pool(NetworkDevice *networkDevice, ObjectPool *objectPool);
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~ Initialization Functions ~~~~~~~~~~~~~~~~~~~~~~~~~
 
 /* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
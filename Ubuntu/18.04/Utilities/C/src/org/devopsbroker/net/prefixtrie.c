@@ -0,0 +1,328 @@
+/*
+ * prefixtrie.c - DevOpsBroker C source file for the org.devopsbroker.net.PrefixTrie struct
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+// ════════════════════════════ Feature Test Macros ═══════════════════════════
+
+#define _DEFAULT_SOURCE
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <arpa/inet.h>
+
+#include "prefixtrie.h"
+
+#include "../adt/sort.h"
+#include "../lang/memory.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define ROOT_SIZE  (1 << PREFIXTRIE_ROOT_STRIDE)
+#define CHUNK_SIZE (1 << PREFIXTRIE_STRIDE)
+
+#define LOOKUP_BATCH_SIZE 16
+
+// Entry layout: child flag | chunk index, or prefix length (8 bits) | payload index (23 bits)
+#define CHILD_FLAG          0x80000000
+#define LEAF_LENGTH_SHIFT   23
+#define LEAF_PAYLOAD_MASK   0x007FFFFF
+
+#define isChild(entry)         ((entry) & CHILD_FLAG)
+#define getChunk(trie, entry)  ((trie)->chunks + (((entry) & ~CHILD_FLAG) * CHUNK_SIZE))
+#define getLeafLength(entry)   (((entry) >> LEAF_LENGTH_SHIFT) & 0xFF)
+#define getLeafPayload(entry)  ((entry) & LEAF_PAYLOAD_MASK)
+
+#define makeLeaf(payloadIndex, prefixLength) ((((uint32_t) (prefixLength)) << LEAF_LENGTH_SHIFT) | (payloadIndex))
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+typedef struct PrefixKey {
+	uint8_t address[16];             // Host bits cleared
+	uint8_t prefixLength;
+} PrefixKey;
+
+static_assert(sizeof(PrefixKey) == 17, "Check your assumptions");
+
+// ════════════════════════════ Function Prototypes ═══════════════════════════
+
+/*
+ * Static functions in C restrict their scope to the file where they are declared
+ */
+static uint32_t addChunk(register PrefixTrie *prefixTrie, const uint32_t fillEntry) {
+	if (prefixTrie->numChunks == prefixTrie->chunkCapacity) {
+		prefixTrie->chunkCapacity <<= 1;
+		prefixTrie->chunks = f668c4bd_realloc_void_size(prefixTrie->chunks, sizeof(uint32_t) * CHUNK_SIZE * prefixTrie->chunkCapacity);
+	}
+
+	register uint32_t *chunk = prefixTrie->chunks + (prefixTrie->numChunks * CHUNK_SIZE);
+
+	// The new chunk inherits the prefix that covered the entry it replaces
+	for (uint32_t i = 0; i < CHUNK_SIZE; i++) {
+		chunk[i] = fillEntry;
+	}
+
+	return prefixTrie->numChunks++;
+}
+
+static uint32_t addPayload(register PrefixTrie *prefixTrie, void *payload) {
+	if (prefixTrie->numPayloads == prefixTrie->payloadCapacity) {
+		prefixTrie->payloadCapacity <<= 1;
+		prefixTrie->payloads = f668c4bd_realloc_void_size(prefixTrie->payloads, sizeof(void*) * prefixTrie->payloadCapacity);
+	}
+
+	prefixTrie->payloads[prefixTrie->numPayloads] = payload;
+
+	return prefixTrie->numPayloads++;
+}
+
+static void initPrefixKey(PrefixKey *key, const uint8_t *address, const uint32_t prefixLength) {
+	const uint32_t fullBytes = prefixLength >> 3;
+
+	f668c4bd_meminit(key, sizeof(PrefixKey));
+	memcpy(key->address, address, fullBytes);
+
+	if (prefixLength & 0x07) {
+		key->address[fullBytes] = address[fullBytes] & (uint8_t) (0xFF00 >> (prefixLength & 0x07));
+	}
+
+	key->prefixLength = prefixLength;
+}
+
+/*
+ * Stores the leaf in the entry unless a longer prefix already owns it, pushing
+ * the leaf down into every entry of a child chunk
+ */
+static void setEntry(const PrefixTrie *prefixTrie, register uint32_t *entry, const uint32_t leaf) {
+	if (isChild(*entry)) {
+		register uint32_t *chunk = getChunk(prefixTrie, *entry);
+
+		for (uint32_t i = 0; i < CHUNK_SIZE; i++) {
+			setEntry(prefixTrie, &chunk[i], leaf);
+		}
+	} else if (getLeafLength(*entry) <= getLeafLength(leaf)) {
+		*entry = leaf;
+	}
+}
+
+static bool insertPrefix(register PrefixTrie *prefixTrie, const uint8_t *address, const uint32_t prefixLength, void *payload) {
+	PrefixKey key;
+
+	if (prefixLength > prefixTrie->addressBits) {
+		return false;
+	}
+
+	initPrefixKey(&key, address, prefixLength);
+
+	uint32_t *payloadIndex = c47905f7_find(&prefixTrie->prefixes, &key);
+
+	// The entries of an identical prefix already refer to its payload slot
+	if (payloadIndex != NULL) {
+		prefixTrie->payloads[*payloadIndex] = payload;
+		return true;
+	}
+
+	// Leaf entries only have room for LEAF_PAYLOAD_MASK + 1 payload indexes
+	if (prefixTrie->numPayloads > LEAF_PAYLOAD_MASK) {
+		return false;
+	}
+
+	const uint32_t newIndex = addPayload(prefixTrie, payload);
+	const uint32_t leaf = makeLeaf(newIndex, prefixLength);
+	register uint32_t *entries = prefixTrie->root;
+	register uint32_t index = (address[0] << 8) | address[1];
+	uint32_t levelEnd = PREFIXTRIE_ROOT_STRIDE;
+	uint32_t byte = 2;
+
+	c47905f7_put(&prefixTrie->prefixes, &key, &newIndex);
+	prefixTrie->numPrefixes++;
+
+	// Descend, splitting leaves into chunks, until the level holding the prefix
+	while (prefixLength > levelEnd) {
+		if (!isChild(entries[index])) {
+			if (entries == prefixTrie->root) {
+				entries[index] = CHILD_FLAG | addChunk(prefixTrie, entries[index]);
+			} else {
+				// addChunk() may move the chunks so keep the offset instead
+				const size_t entryOffset = entries - prefixTrie->chunks;
+				const uint32_t chunkIndex = addChunk(prefixTrie, entries[index]);
+
+				entries = prefixTrie->chunks + entryOffset;
+				entries[index] = CHILD_FLAG | chunkIndex;
+			}
+		}
+
+		entries = getChunk(prefixTrie, entries[index]);
+		index = address[byte++];
+		levelEnd += PREFIXTRIE_STRIDE;
+	}
+
+	// Expand the prefix across every entry it covers at this level
+	const uint32_t span = 1U << (levelEnd - prefixLength);
+	const uint32_t first = index & ~(span - 1);
+
+	for (uint32_t i = first; i < first + span; i++) {
+		setEntry(prefixTrie, &entries[i], leaf);
+	}
+
+	return true;
+}
+
+static void *lookupAddress(register const PrefixTrie *prefixTrie, register const uint8_t *address) {
+	register uint32_t entry = prefixTrie->root[(address[0] << 8) | address[1]];
+
+	address += 2;
+
+	while (isChild(entry)) {
+		entry = getChunk(prefixTrie, entry)[*address++];
+	}
+
+	return prefixTrie->payloads[getLeafPayload(entry)];
+}
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═════════════════════════ Function Implementations ═════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void b6678883_cleanUpPrefixTrie(PrefixTrie *prefixTrie) {
+	f668c4bd_free(prefixTrie->root);
+	f668c4bd_free(prefixTrie->chunks);
+	f668c4bd_free(prefixTrie->payloads);
+	c47905f7_cleanUpHashMap(&prefixTrie->prefixes);
+
+	prefixTrie->root = NULL;
+	prefixTrie->chunks = NULL;
+	prefixTrie->payloads = NULL;
+}
+
+void b6678883_initPrefixTrie(PrefixTrie *prefixTrie, const PrefixTrieFamily family) {
+	prefixTrie->root = f668c4bd_malloc(sizeof(uint32_t) * ROOT_SIZE);
+	prefixTrie->chunkCapacity = 16;
+	prefixTrie->chunks = f668c4bd_malloc(sizeof(uint32_t) * CHUNK_SIZE * prefixTrie->chunkCapacity);
+	prefixTrie->payloadCapacity = 64;
+	prefixTrie->payloads = f668c4bd_malloc(sizeof(void*) * prefixTrie->payloadCapacity);
+	prefixTrie->numChunks = 0;
+	prefixTrie->addressBits = family;
+	prefixTrie->numPrefixes = 0;
+
+	c47905f7_initHashMap(&prefixTrie->prefixes, sizeof(PrefixKey), sizeof(uint32_t));
+
+	// Payload index zero is reserved for addresses without a matching prefix
+	prefixTrie->payloads[0] = NULL;
+	prefixTrie->numPayloads = 1;
+
+	f668c4bd_meminit(prefixTrie->root, sizeof(uint32_t) * ROOT_SIZE);
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+bool b6678883_insert_ipv4(PrefixTrie *prefixTrie, const IPv4Address *prefix, void *payload) {
+	return insertPrefix(prefixTrie, (const uint8_t *) &prefix->address, prefix->cidrSuffix, payload);
+}
+
+bool b6678883_insert_ipv6(PrefixTrie *prefixTrie, const IPv6Address *prefix, void *payload) {
+	return insertPrefix(prefixTrie, prefix->address, prefix->cidrSuffix, payload);
+}
+
+bool b6678883_insertAll_ipv4(PrefixTrie *prefixTrie, const IPv4Address *prefixArray, void **payloadArray, const uint32_t numElements) {
+	uint64_t *order = f668c4bd_malloc_size_size(sizeof(uint64_t), numElements);
+	bool allInserted = true;
+
+	// Shorter prefixes first so longer prefixes simply overwrite their ranges
+	for (uint32_t i = 0; i < numElements; i++) {
+		order[i] = (((uint64_t) prefixArray[i].cidrSuffix) << 32) | i;
+	}
+
+	e9497a6d_radixSort_uint64(order, numElements);
+
+	for (uint32_t i = 0; i < numElements; i++) {
+		const uint32_t index = (uint32_t) order[i];
+
+		allInserted &= b6678883_insert_ipv4(prefixTrie, &prefixArray[index], payloadArray[index]);
+	}
+
+	f668c4bd_free(order);
+
+	return allInserted;
+}
+
+bool b6678883_insertAll_ipv6(PrefixTrie *prefixTrie, const IPv6Address *prefixArray, void **payloadArray, const uint32_t numElements) {
+	uint64_t *order = f668c4bd_malloc_size_size(sizeof(uint64_t), numElements);
+	bool allInserted = true;
+
+	for (uint32_t i = 0; i < numElements; i++) {
+		order[i] = (((uint64_t) prefixArray[i].cidrSuffix) << 32) | i;
+	}
+
+	e9497a6d_radixSort_uint64(order, numElements);
+
+	for (uint32_t i = 0; i < numElements; i++) {
+		const uint32_t index = (uint32_t) order[i];
+
+		allInserted &= b6678883_insert_ipv6(prefixTrie, &prefixArray[index], payloadArray[index]);
+	}
+
+	f668c4bd_free(order);
+
+	return allInserted;
+}
+
+void *b6678883_lookup_ipv4(const PrefixTrie *prefixTrie, const uint32_t address) {
+	return lookupAddress(prefixTrie, (const uint8_t *) &address);
+}
+
+void *b6678883_lookup_ipv6(const PrefixTrie *prefixTrie, const uint8_t *address) {
+	return lookupAddress(prefixTrie, address);
+}
+
+void b6678883_lookupAll_ipv4(register const PrefixTrie *prefixTrie, const uint32_t *addressArray, void **payloadArray, const uint32_t numElements) {
+	uint32_t hostAddress[LOOKUP_BATCH_SIZE];
+	uint32_t entry[LOOKUP_BATCH_SIZE];
+
+	for (uint32_t start = 0; start < numElements; start += LOOKUP_BATCH_SIZE) {
+		const uint32_t batchSize = (numElements - start < LOOKUP_BATCH_SIZE) ? numElements - start : LOOKUP_BATCH_SIZE;
+
+		// Each pass issues one independent load per address so the cache
+		// misses of the whole batch are in flight at the same time
+		for (uint32_t i = 0; i < batchSize; i++) {
+			hostAddress[i] = ntohl(addressArray[start + i]);
+			entry[i] = prefixTrie->root[hostAddress[i] >> 16];
+		}
+
+		for (register int shift = 8; shift >= 0; shift -= 8) {
+			for (uint32_t i = 0; i < batchSize; i++) {
+				if (isChild(entry[i])) {
+					entry[i] = getChunk(prefixTrie, entry[i])[(hostAddress[i] >> shift) & 0xFF];
+				}
+			}
+		}
+
+		for (uint32_t i = 0; i < batchSize; i++) {
+			payloadArray[start + i] = prefixTrie->payloads[getLeafPayload(entry[i])];
+		}
+	}
+}
@@ -0,0 +1,207 @@
+/*
+ * prefixtrie.h - DevOpsBroker C header file for the org.devopsbroker.net.PrefixTrie struct
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * A PrefixTrie performs longest-prefix-match lookups of IPv4 or IPv6 addresses
+ * against a set of IPv4Address/IPv6Address prefixes, each with a payload.
+ *
+ * The trie is multibit with a 16-bit root stride followed by 8-bit strides
+ * (16-8-8 for IPv4) and uses controlled prefix expansion: every entry holds
+ * either a child chunk or the payload of the longest prefix covering it, so a
+ * lookup is one array index per stride with no backtracking. An IPv4 lookup
+ * takes at most three memory accesses and an IPv6 lookup at most fifteen.
+ *
+ * Addresses are in network byte order, as stored in IPv4Address.address and
+ * IPv6Address.address. Host bits past the cidrSuffix of a prefix are ignored.
+ * A PrefixTrie holds up to 8388607 inserted prefixes.
+ *
+ * echo ORG_DEVOPSBROKER_NET_PREFIXTRIE | md5sum | cut -c 25-32
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef ORG_DEVOPSBROKER_NET_PREFIXTRIE_H
+#define ORG_DEVOPSBROKER_NET_PREFIXTRIE_H
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <assert.h>
+
+#include "ipv4address.h"
+#include "ipv6address.h"
+
+#include "../adt/hashmap.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define PREFIXTRIE_ROOT_STRIDE 16
+#define PREFIXTRIE_STRIDE 8
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+typedef enum PrefixTrieFamily {
+	PREFIXTRIE_IPV4 = 32,
+	PREFIXTRIE_IPV6 = 128
+} PrefixTrieFamily;
+
+typedef struct PrefixTrie {
+	uint32_t *root;                  // 2^16 entries
+	uint32_t *chunks;                // numChunks * 2^8 entries
+	void **payloads;
+	HashMap prefixes;                // Masked prefix to payload index
+	uint32_t numChunks;
+	uint32_t chunkCapacity;
+	uint32_t numPayloads;
+	uint32_t payloadCapacity;
+	uint32_t addressBits;
+	uint32_t numPrefixes;
+} PrefixTrie;
+
+static_assert(sizeof(PrefixTrie) == 120, "Check your assumptions");
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ════════════════════════════ Function Prototypes ═══════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    b6678883_cleanUpPrefixTrie
+ * Description: Frees the memory owned by the PrefixTrie
+ *
+ * Parameters:
+ *   prefixTrie     A pointer to the PrefixTrie instance to clean up
+ * ----------------------------------------------------------------------------
+ */
+void b6678883_cleanUpPrefixTrie(PrefixTrie *prefixTrie);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    b6678883_initPrefixTrie
+ * Description: Initializes an empty PrefixTrie for the address family
+ *
+ * Parameters:
+ *   prefixTrie     A pointer to the PrefixTrie instance to initalize
+ *   family         PREFIXTRIE_IPV4 or PREFIXTRIE_IPV6
+ * ----------------------------------------------------------------------------
+ */
+void b6678883_initPrefixTrie(PrefixTrie *prefixTrie, const PrefixTrieFamily family);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    b6678883_insert_ipv4
+ * Description: Inserts the IPv4 prefix with its payload, replacing the payload
+ *              of an identical prefix
+ *
+ * Parameters:
+ *   prefixTrie     A pointer to an IPv4 PrefixTrie instance
+ *   prefix         The address and cidrSuffix of the prefix
+ *   payload        The payload returned by lookups matching the prefix
+ * Returns:         False if the cidrSuffix is out of range or the PrefixTrie is
+ *                  full, true otherwise
+ * ----------------------------------------------------------------------------
+ */
+bool b6678883_insert_ipv4(PrefixTrie *prefixTrie, const IPv4Address *prefix, void *payload);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    b6678883_insert_ipv6
+ * Description: Inserts the IPv6 prefix with its payload, replacing the payload
+ *              of an identical prefix
+ *
+ * Parameters:
+ *   prefixTrie     A pointer to an IPv6 PrefixTrie instance
+ *   prefix         The address and cidrSuffix of the prefix
+ *   payload        The payload returned by lookups matching the prefix
+ * Returns:         False if the cidrSuffix is out of range or the PrefixTrie is
+ *                  full, true otherwise
+ * ----------------------------------------------------------------------------
+ */
+bool b6678883_insert_ipv6(PrefixTrie *prefixTrie, const IPv6Address *prefix, void *payload);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    b6678883_insertAll_ipv4
+ * Description: Inserts every IPv4 prefix with its payload
+ *
+ * Parameters:
+ *   prefixTrie     A pointer to an IPv4 PrefixTrie instance
+ *   prefixArray    The array of prefixes to insert
+ *   payloadArray   The payload for each prefix
+ *   numElements    The number of prefixes to insert
+ * Returns:         False if any prefix could not be inserted, true otherwise
+ * ----------------------------------------------------------------------------
+ */
+bool b6678883_insertAll_ipv4(PrefixTrie *prefixTrie, const IPv4Address *prefixArray, void **payloadArray, const uint32_t numElements);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    b6678883_insertAll_ipv6
+ * Description: Inserts every IPv6 prefix with its payload
+ *
+ * Parameters:
+ *   prefixTrie     A pointer to an IPv6 PrefixTrie instance
+ *   prefixArray    The array of prefixes to insert
+ *   payloadArray   The payload for each prefix
+ *   numElements    The number of prefixes to insert
+ * Returns:         False if any prefix could not be inserted, true otherwise
+ * ----------------------------------------------------------------------------
+ */
+bool b6678883_insertAll_ipv6(PrefixTrie *prefixTrie, const IPv6Address *prefixArray, void **payloadArray, const uint32_t numElements);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    b6678883_lookup_ipv4
+ * Description: Finds the payload of the longest prefix matching the address
+ *
+ * Parameters:
+ *   prefixTrie     A pointer to an IPv4 PrefixTrie instance
+ *   address        The IPv4 address in network byte order
+ * Returns:         The payload of the longest matching prefix, or NULL if none
+ * ----------------------------------------------------------------------------
+ */
+void *b6678883_lookup_ipv4(const PrefixTrie *prefixTrie, const uint32_t address);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    b6678883_lookup_ipv6
+ * Description: Finds the payload of the longest prefix matching the address
+ *
+ * Parameters:
+ *   prefixTrie     A pointer to an IPv6 PrefixTrie instance
+ *   address        The 16-byte IPv6 address in network byte order
+ * Returns:         The payload of the longest matching prefix, or NULL if none
+ * ----------------------------------------------------------------------------
+ */
+void *b6678883_lookup_ipv6(const PrefixTrie *prefixTrie, const uint8_t *address);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    b6678883_lookupAll_ipv4
+ * Description: Finds the longest prefix match payload of every address, walking
+ *              a batch of addresses one level at a time so the memory
+ *              accesses of different lookups overlap
+ *
+ * Parameters:
+ *   prefixTrie     A pointer to an IPv4 PrefixTrie instance
+ *   addressArray   The IPv4 addresses in network byte order
+ *   payloadArray   Set to the payload of each address (NULL if none)
+ *   numElements    The number of addresses to look up
+ * ----------------------------------------------------------------------------
+ */
+void b6678883_lookupAll_ipv4(const PrefixTrie *prefixTrie, const uint32_t *addressArray, void **payloadArray, const uint32_t numElements);
+
+#endif /* ORG_DEVOPSBROKER_NET_PREFIXTRIE_H */
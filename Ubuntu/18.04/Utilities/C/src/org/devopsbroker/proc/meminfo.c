@@ -0,0 +1,118 @@
+/*
+ * meminfo.c - DevOpsBroker C source file for parsing /proc/meminfo
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+// ════════════════════════════ Feature Test Macros ═══════════════════════════
+
+#define _DEFAULT_SOURCE
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stddef.h>
+
+
+#include "meminfo.h"
+#include "procfile.h"
+
+#include "../lang/memory.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define MEMINFO_NUM_FIELDS (sizeof(memInfoFields) / sizeof(ProcField))
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+// Listed in the order the kernel emits them
+static const ProcField memInfoFields[] = {
+	{ "MemTotal",         8, offsetof(MemInfo, memTotal) },
+	{ "MemFree",          7, offsetof(MemInfo, memFree) },
+	{ "MemAvailable",    12, offsetof(MemInfo, memAvailable) },
+	{ "Buffers",          7, offsetof(MemInfo, buffers) },
+	{ "Cached",           6, offsetof(MemInfo, cached) },
+	{ "SwapCached",      10, offsetof(MemInfo, swapCached) },
+	{ "Active",           6, offsetof(MemInfo, active) },
+	{ "Inactive",         8, offsetof(MemInfo, inactive) },
+	{ "Active(anon)",    12, offsetof(MemInfo, activeAnon) },
+	{ "Inactive(anon)",  14, offsetof(MemInfo, inactiveAnon) },
+	{ "Active(file)",    12, offsetof(MemInfo, activeFile) },
+	{ "Inactive(file)",  14, offsetof(MemInfo, inactiveFile) },
+	{ "Unevictable",     11, offsetof(MemInfo, unevictable) },
+	{ "Mlocked",          7, offsetof(MemInfo, mlocked) },
+	{ "SwapTotal",        9, offsetof(MemInfo, swapTotal) },
+	{ "SwapFree",         8, offsetof(MemInfo, swapFree) },
+	{ "Dirty",            5, offsetof(MemInfo, dirty) },
+	{ "Writeback",        9, offsetof(MemInfo, writeback) },
+	{ "AnonPages",        9, offsetof(MemInfo, anonPages) },
+	{ "Mapped",           6, offsetof(MemInfo, mapped) },
+	{ "Shmem",            5, offsetof(MemInfo, shmem) },
+	{ "Slab",             4, offsetof(MemInfo, slab) },
+	{ "SReclaimable",    12, offsetof(MemInfo, sReclaimable) },
+	{ "SUnreclaim",      10, offsetof(MemInfo, sUnreclaim) },
+	{ "KernelStack",     11, offsetof(MemInfo, kernelStack) },
+	{ "PageTables",      10, offsetof(MemInfo, pageTables) },
+	{ "CommitLimit",     11, offsetof(MemInfo, commitLimit) },
+	{ "Committed_AS",    12, offsetof(MemInfo, committedAS) },
+	{ "AnonHugePages",   13, offsetof(MemInfo, anonHugePages) },
+	{ "HugePages_Total", 15, offsetof(MemInfo, hugePagesTotal) },
+	{ "HugePages_Free",  14, offsetof(MemInfo, hugePagesFree) },
+	{ "HugePages_Rsvd",  14, offsetof(MemInfo, hugePagesRsvd) },
+	{ "HugePages_Surp",  14, offsetof(MemInfo, hugePagesSurp) },
+	{ "Hugepagesize",    12, offsetof(MemInfo, hugePageSize) }
+};
+
+// ═════════════════════════ Function Implementations ═════════════════════════
+
+void a1212161_readMemInfo(ProcFile *procFile, MemInfo *memInfo) {
+	register char *position;
+	char *name;
+	uint32_t nameLength;
+	uint32_t hint = 0;
+	int32_t index;
+
+	d2468f3c_readProcFile(procFile);
+
+	f668c4bd_meminit(memInfo, sizeof(MemInfo));
+	memInfo->timestamp = d2468f3c_getTimestamp();
+
+	position = procFile->buffer;
+
+	while (*position != '\0') {
+		name = d2468f3c_nextName(position, &nameLength);
+		position = name + nameLength;
+
+		index = d2468f3c_findField(memInfoFields, MEMINFO_NUM_FIELDS, name, nameLength, &hint);
+
+		// Skip the colon; the value is followed by an optional kB unit
+		if (index >= 0 && *position == ':') {
+			position = d2468f3c_parse_uint64(position + 1, (uint64_t *) (((char *) memInfo) + memInfoFields[index].offset));
+		}
+
+		position = d2468f3c_nextLine(position);
+	}
+}
@@ -0,0 +1,101 @@
+/*
+ * meminfo.h - DevOpsBroker C header file for parsing /proc/meminfo
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * Parses /proc/meminfo in a single pass over a ProcFile buffer. Every value is
+ * a gauge reported in kB unless noted otherwise, so there is no delta function;
+ * fields the running kernel does not report are left at zero.
+ *
+ * echo ORG_DEVOPSBROKER_PROC_MEMINFO | md5sum | cut -c 25-32
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef ORG_DEVOPSBROKER_PROC_MEMINFO_H
+#define ORG_DEVOPSBROKER_PROC_MEMINFO_H
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdint.h>
+
+#include <assert.h>
+
+#include "procfile.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+typedef struct MemInfo {
+	uint64_t memTotal;
+	uint64_t memFree;
+	uint64_t memAvailable;
+	uint64_t buffers;
+	uint64_t cached;
+	uint64_t swapCached;
+	uint64_t active;
+	uint64_t inactive;
+	uint64_t activeAnon;
+	uint64_t inactiveAnon;
+	uint64_t activeFile;
+	uint64_t inactiveFile;
+	uint64_t unevictable;
+	uint64_t mlocked;
+	uint64_t swapTotal;
+	uint64_t swapFree;
+	uint64_t dirty;
+	uint64_t writeback;
+	uint64_t anonPages;
+	uint64_t mapped;
+	uint64_t shmem;
+	uint64_t slab;
+	uint64_t sReclaimable;
+	uint64_t sUnreclaim;
+	uint64_t kernelStack;
+	uint64_t pageTables;
+	uint64_t commitLimit;
+	uint64_t committedAS;
+	uint64_t anonHugePages;
+	uint64_t hugePagesTotal;          // Pages, not kB
+	uint64_t hugePagesFree;           // Pages, not kB
+	uint64_t hugePagesRsvd;           // Pages, not kB
+	uint64_t hugePagesSurp;           // Pages, not kB
+	uint64_t hugePageSize;
+	uint64_t timestamp;              // CLOCK_MONOTONIC nanoseconds
+} MemInfo;
+
+static_assert(sizeof(MemInfo) == 280, "Check your assumptions");
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    a1212161_readMemInfo
+ * Description: Re-reads /proc/meminfo and parses it into the MemInfo
+ *
+ * Parameters:
+ *   procFile       A ProcFile opened on /proc/meminfo
+ *   memInfo        A pointer to the MemInfo instance to populate
+ * ----------------------------------------------------------------------------
+ */
+void a1212161_readMemInfo(ProcFile *procFile, MemInfo *memInfo);
+
+#endif /* ORG_DEVOPSBROKER_PROC_MEMINFO_H */
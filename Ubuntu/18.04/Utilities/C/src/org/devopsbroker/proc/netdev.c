@@ -0,0 +1,172 @@
+/*
+ * netdev.c - DevOpsBroker C source file for parsing /proc/net/dev
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+// ════════════════════════════ Feature Test Macros ═══════════════════════════
+
+#define _DEFAULT_SOURCE
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdlib.h>
+#include <string.h>
+
+
+#include "netdev.h"
+#include "procfile.h"
+
+#include "../lang/memory.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define NETDEV_NUM_HEADER_LINES 2
+
+#define NETDEV_DEFAULT_SIZE 8
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+/*
+ * Static functions in C restrict their scope to the file where they are declared
+ */
+static void ensureCapacity(register NetDevSnapshot *snapshot, const uint32_t length) {
+	if (length > snapshot->size) {
+		register uint32_t size = (snapshot->size == 0) ? NETDEV_DEFAULT_SIZE : snapshot->size;
+
+		while (size < length) {
+			size <<= 1;
+		}
+
+		snapshot->interfaces = f668c4bd_realloc(snapshot->interfaces, sizeof(NetDevStats) * snapshot->size, sizeof(NetDevStats) * size);
+		snapshot->size = size;
+	}
+}
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═════════════════════════ Function Implementations ═════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void a65a9b89_cleanUpNetDevSnapshot(NetDevSnapshot *snapshot) {
+	f668c4bd_free(snapshot->interfaces);
+
+	snapshot->interfaces = NULL;
+	snapshot->length = 0;
+	snapshot->size = 0;
+}
+
+void a65a9b89_initNetDevSnapshot(NetDevSnapshot *snapshot) {
+	snapshot->interfaces = NULL;
+	snapshot->timestamp = 0;
+	snapshot->length = 0;
+	snapshot->size = 0;
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void a65a9b89_delta(const NetDevSnapshot *prev, const NetDevSnapshot *curr, NetDevSnapshot *delta) {
+	register const NetDevStats *prevStats;
+	register const NetDevStats *currStats;
+	register NetDevStats *deltaStats;
+
+	ensureCapacity(delta, curr->length);
+
+	for (uint32_t i = 0; i < curr->length; i++) {
+		currStats = &curr->interfaces[i];
+		deltaStats = &delta->interfaces[i];
+
+		// Interfaces are almost always listed in the same order
+		prevStats = (i < prev->length && strcmp(prev->interfaces[i].name, currStats->name) == 0)
+		          ? &prev->interfaces[i] : a65a9b89_find(prev, currStats->name);
+
+		memcpy(deltaStats->name, currStats->name, IFNAMSIZ);
+
+		if (prevStats == NULL) {
+			memcpy(&deltaStats->rxBytes, &currStats->rxBytes, NETDEV_NUM_COUNTERS * sizeof(uint64_t));
+		} else {
+			d2468f3c_delta_uint64(&prevStats->rxBytes, &currStats->rxBytes, &deltaStats->rxBytes, NETDEV_NUM_COUNTERS);
+		}
+	}
+
+	delta->length = curr->length;
+	delta->timestamp = curr->timestamp - prev->timestamp;
+}
+
+NetDevStats *a65a9b89_find(const NetDevSnapshot *snapshot, const char *name) {
+	for (uint32_t i = 0; i < snapshot->length; i++) {
+		if (strcmp(snapshot->interfaces[i].name, name) == 0) {
+			return &snapshot->interfaces[i];
+		}
+	}
+
+	return NULL;
+}
+
+void a65a9b89_readNetDev(ProcFile *procFile, NetDevSnapshot *snapshot) {
+	register char *position;
+	register NetDevStats *stats;
+	register uint64_t *counter;
+	char *name;
+	uint32_t nameLength;
+	uint32_t length = 0;
+
+	d2468f3c_readProcFile(procFile);
+	snapshot->timestamp = d2468f3c_getTimestamp();
+
+	position = procFile->buffer;
+
+	for (int i = 0; i < NETDEV_NUM_HEADER_LINES; i++) {
+		position = d2468f3c_nextLine(position);
+	}
+
+	while (*position != '\0') {
+		name = d2468f3c_nextName(position, &nameLength);
+
+		// Skip malformed lines instead of trusting them
+		if (name[nameLength] != ':' || nameLength >= IFNAMSIZ) {
+			position = d2468f3c_nextLine(name);
+			continue;
+		}
+
+		ensureCapacity(snapshot, length + 1);
+		stats = &snapshot->interfaces[length++];
+
+		memcpy(stats->name, name, nameLength);
+		stats->name[nameLength] = '\0';
+
+		position = name + nameLength + 1;
+		counter = &stats->rxBytes;
+
+		for (int i = 0; i < NETDEV_NUM_COUNTERS; i++) {
+			position = d2468f3c_parse_uint64(position, counter++);
+		}
+
+		position = d2468f3c_nextLine(position);
+	}
+
+	snapshot->length = length;
+}
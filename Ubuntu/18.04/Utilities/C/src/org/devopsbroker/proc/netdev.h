@@ -0,0 +1,145 @@
+/*
+ * netdev.h - DevOpsBroker C header file for parsing /proc/net/dev
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * Parses the per-interface counters of /proc/net/dev in a single pass over a
+ * ProcFile buffer. The NetDevSnapshot array is only reallocated when the number
+ * of interfaces grows, so steady-state sampling performs no allocation.
+ *
+ * echo ORG_DEVOPSBROKER_PROC_NETDEV | md5sum | cut -c 25-32
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef ORG_DEVOPSBROKER_PROC_NETDEV_H
+#define ORG_DEVOPSBROKER_PROC_NETDEV_H
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdint.h>
+
+#include <assert.h>
+#include <net/if.h>
+
+#include "procfile.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define NETDEV_NUM_COUNTERS 16
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+typedef struct NetDevStats {
+	char name[IFNAMSIZ];
+	uint64_t rxBytes;
+	uint64_t rxPackets;
+	uint64_t rxErrors;
+	uint64_t rxDropped;
+	uint64_t rxFifo;
+	uint64_t rxFrame;
+	uint64_t rxCompressed;
+	uint64_t rxMulticast;
+	uint64_t txBytes;
+	uint64_t txPackets;
+	uint64_t txErrors;
+	uint64_t txDropped;
+	uint64_t txFifo;
+	uint64_t txCollisions;
+	uint64_t txCarrier;
+	uint64_t txCompressed;
+} NetDevStats;
+
+static_assert(sizeof(NetDevStats) == 144, "Check your assumptions");
+
+typedef struct NetDevSnapshot {
+	NetDevStats *interfaces;
+	uint64_t timestamp;              // CLOCK_MONOTONIC nanoseconds
+	uint32_t length;
+	uint32_t size;
+} NetDevSnapshot;
+
+static_assert(sizeof(NetDevSnapshot) == 24, "Check your assumptions");
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    a65a9b89_cleanUpNetDevSnapshot
+ * Description: Frees the interface array of the NetDevSnapshot
+ *
+ * Parameters:
+ *   snapshot       A pointer to the NetDevSnapshot instance to clean up
+ * ----------------------------------------------------------------------------
+ */
+void a65a9b89_cleanUpNetDevSnapshot(NetDevSnapshot *snapshot);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    a65a9b89_initNetDevSnapshot
+ * Description: Initializes an empty NetDevSnapshot
+ *
+ * Parameters:
+ *   snapshot       A pointer to the NetDevSnapshot instance to initalize
+ * ----------------------------------------------------------------------------
+ */
+void a65a9b89_initNetDevSnapshot(NetDevSnapshot *snapshot);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    a65a9b89_delta
+ * Description: Computes the per-interface counter deltas between two snapshots;
+ *              interfaces are matched by name and new interfaces report their
+ *              current counters
+ *
+ * Parameters:
+ *   prev           The earlier NetDevSnapshot
+ *   curr           The later NetDevSnapshot
+ *   delta          The NetDevSnapshot to store the deltas in; its timestamp
+ *                  holds the elapsed nanoseconds
+ * ----------------------------------------------------------------------------
+ */
+void a65a9b89_delta(const NetDevSnapshot *prev, const NetDevSnapshot *curr, NetDevSnapshot *delta);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    a65a9b89_find
+ * Description: Finds the statistics for the named interface
+ *
+ * Parameters:
+ *   snapshot       A pointer to the NetDevSnapshot instance
+ *   name           The name of the interface
+ * Returns:         The NetDevStats of the interface, or NULL if not found
+ * ----------------------------------------------------------------------------
+ */
+NetDevStats *a65a9b89_find(const NetDevSnapshot *snapshot, const char *name);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    a65a9b89_readNetDev
+ * Description: Re-reads /proc/net/dev and parses it into the NetDevSnapshot
+ *
+ * Parameters:
+ *   procFile       A ProcFile opened on /proc/net/dev
+ *   snapshot       A pointer to the NetDevSnapshot instance to populate
+ * ----------------------------------------------------------------------------
+ */
+void a65a9b89_readNetDev(ProcFile *procFile, NetDevSnapshot *snapshot);
+
+#endif /* ORG_DEVOPSBROKER_PROC_NETDEV_H */
@@ -0,0 +1,158 @@
+/*
+ * procfile.c - DevOpsBroker C source file for the org.devopsbroker.proc.ProcFile struct
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+// ════════════════════════════ Feature Test Macros ═══════════════════════════
+
+#define _DEFAULT_SOURCE
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "procfile.h"
+
+#include "../io/file.h"
+#include "../lang/error.h"
+#include "../lang/memory.h"
+#include "../lang/stringbuilder.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═════════════════════════ Function Implementations ═════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void d2468f3c_openProcFile(ProcFile *procFile, const char *pathName) {
+	procFile->fd = e2f74138_openFile(pathName, O_RDONLY | O_CLOEXEC);
+	procFile->pathName = pathName;
+	procFile->buffer = f668c4bd_malloc(PROCFILE_DEFAULT_SIZE);
+	procFile->length = 0;
+	procFile->size = PROCFILE_DEFAULT_SIZE;
+	procFile->buffer[0] = '\0';
+}
+
+void d2468f3c_closeProcFile(ProcFile *procFile) {
+	e2f74138_closeFile(procFile->fd, procFile->pathName);
+	f668c4bd_free(procFile->buffer);
+
+	procFile->fd = SYSTEM_ERROR_CODE;
+	procFile->buffer = NULL;
+	procFile->length = 0;
+	procFile->size = 0;
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void d2468f3c_delta_uint64(register const uint64_t *prev, register const uint64_t *curr, register uint64_t *delta, const uint32_t numValues) {
+	for (uint32_t i = 0; i < numValues; i++) {
+		delta[i] = (curr[i] >= prev[i]) ? curr[i] - prev[i] : curr[i];
+	}
+}
+
+int32_t d2468f3c_findField(register const ProcField *fields, const uint32_t numFields, const char *name, const uint32_t length, uint32_t *hint) {
+	register uint32_t index = *hint;
+
+	for (uint32_t i = 0; i < numFields; i++) {
+		if (index == numFields) {
+			index = 0;
+		}
+
+		if (fields[index].length == length && memcmp(fields[index].name, name, length) == 0) {
+			*hint = index + 1;
+			return index;
+		}
+
+		index++;
+	}
+
+	return -1;
+}
+
+uint64_t d2468f3c_getTimestamp() {
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (now.tv_sec * 1000000000UL) + now.tv_nsec;
+}
+
+uint32_t d2468f3c_readProcFile(register ProcFile *procFile) {
+	register ssize_t numBytes;
+	register uint32_t length = 0;
+
+	while (true) {
+		// Always leave room for the null-termination character
+		if (procFile->size - length == 1) {
+			procFile->buffer = f668c4bd_realloc(procFile->buffer, procFile->size, procFile->size << 1);
+			procFile->size <<= 1;
+		}
+
+		numBytes = pread(procFile->fd, procFile->buffer + length, procFile->size - length - 1, length);
+
+		if (numBytes == END_OF_FILE) {
+			break;
+		}
+
+		if (numBytes == SYSTEM_ERROR_CODE) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			StringBuilder errorMessage;
+			c598a24c_initStringBuilder(&errorMessage);
+
+			c598a24c_append_string(&errorMessage, "Cannot read from file '");
+			c598a24c_append_string(&errorMessage, procFile->pathName);
+			c598a24c_append_char(&errorMessage, '\'');
+
+			c7c88e52_printLibError(errorMessage.buffer, errno);
+			c598a24c_cleanUpStringBuilder(&errorMessage);
+
+			exit(EXIT_FAILURE);
+		}
+
+		length += numBytes;
+	}
+
+	procFile->buffer[length] = '\0';
+	procFile->length = length;
+
+	return length;
+}
@@ -0,0 +1,231 @@
+/*
+ * procfile.h - DevOpsBroker C header file for the org.devopsbroker.proc.ProcFile struct
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * A ProcFile keeps a procfs file open and re-reads it from offset zero with
+ * pread() into a buffer that is reused across samples. The inline scanning
+ * functions below walk that buffer in place so the /proc parsers never call
+ * sscanf() or allocate per field.
+ *
+ * echo ORG_DEVOPSBROKER_PROC_PROCFILE | md5sum | cut -c 25-32
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef ORG_DEVOPSBROKER_PROC_PROCFILE_H
+#define ORG_DEVOPSBROKER_PROC_PROCFILE_H
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <assert.h>
+#include <sys/types.h>
+
+#include "../lang/long.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define PROCFILE_DEFAULT_SIZE 4096
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+typedef struct ProcFile {
+	char *buffer;
+	const char *pathName;
+	int fd;
+	uint32_t length;
+	uint32_t size;
+	char _padding[4];
+} ProcFile;
+
+static_assert(sizeof(ProcFile) == 32, "Check your assumptions");
+
+typedef struct ProcField {
+	const char *name;
+	uint32_t length;
+	uint32_t offset;                 // offsetof() the uint64_t in the target struct
+} ProcField;
+
+static_assert(sizeof(ProcField) == 16, "Check your assumptions");
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    d2468f3c_openProcFile
+ * Description: Opens the procfs file and allocates its read buffer
+ *
+ * Parameters:
+ *   procFile       A pointer to the ProcFile instance to initalize
+ *   pathName       The name of the procfs file (must outlive the ProcFile)
+ * ----------------------------------------------------------------------------
+ */
+void d2468f3c_openProcFile(ProcFile *procFile, const char *pathName);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    d2468f3c_closeProcFile
+ * Description: Closes the procfs file and frees its read buffer
+ *
+ * Parameters:
+ *   procFile       A pointer to the ProcFile instance to close
+ * ----------------------------------------------------------------------------
+ */
+void d2468f3c_closeProcFile(ProcFile *procFile);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    d2468f3c_delta_uint64
+ * Description: Computes curr - prev for an array of monotonic counters; a
+ *              counter that went backwards was reset and reports its current
+ *              value instead
+ *
+ * Parameters:
+ *   prev           The earlier counter values
+ *   curr           The later counter values
+ *   delta          The array to store the differences in (may alias curr)
+ *   numValues      The number of counters in each array
+ * ----------------------------------------------------------------------------
+ */
+void d2468f3c_delta_uint64(const uint64_t *prev, const uint64_t *curr, uint64_t *delta, const uint32_t numValues);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    d2468f3c_findField
+ * Description: Finds the named field, trying the entry after the previous match
+ *              first since procfs emits its fields in a fixed order
+ *
+ * Parameters:
+ *   fields         The array of ProcField descriptors to search
+ *   numFields      The number of descriptors in the array
+ *   name           The field name (need not be null-terminated)
+ *   length         The length of the field name
+ *   hint           The index to try first; updated to follow the match
+ * Returns:         The index of the matching ProcField, or -1 if not found
+ * ----------------------------------------------------------------------------
+ */
+int32_t d2468f3c_findField(const ProcField *fields, const uint32_t numFields, const char *name, const uint32_t length, uint32_t *hint);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    d2468f3c_getTimestamp
+ * Description: Returns the current CLOCK_MONOTONIC time for stamping snapshots
+ *
+ * Returns:         The CLOCK_MONOTONIC time in nanoseconds
+ * ----------------------------------------------------------------------------
+ */
+uint64_t d2468f3c_getTimestamp();
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    d2468f3c_readProcFile
+ * Description: Re-reads the whole procfs file from offset zero with pread(),
+ *              growing the buffer if the file no longer fits
+ *
+ * Parameters:
+ *   procFile       A pointer to the ProcFile instance
+ * Returns:         The number of bytes read into procFile->buffer
+ * ----------------------------------------------------------------------------
+ */
+uint32_t d2468f3c_readProcFile(ProcFile *procFile);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    d2468f3c_nextLine
+ * Description: Returns the position after the end of the current line
+ *
+ * Parameters:
+ *   position       The current position in the procfs buffer
+ * Returns:         The start of the next line, or the terminating null
+ * ----------------------------------------------------------------------------
+ */
+static inline char *d2468f3c_nextLine(register char *position) {
+	while (*position != '\n' && *position != '\0') {
+		position++;
+	}
+
+	return (*position == '\n') ? position + 1 : position;
+}
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    d2468f3c_nextName
+ * Description: Skips leading spaces and returns the next name, which ends at
+ *              a space, colon or newline
+ *
+ * Parameters:
+ *   position       The current position in the procfs buffer
+ *   length         Set to the length of the name
+ * Returns:         The start of the name
+ * ----------------------------------------------------------------------------
+ */
+static inline char *d2468f3c_nextName(register char *position, uint32_t *length) {
+	register char *end;
+
+	while (*position == ' ') {
+		position++;
+	}
+
+	end = position;
+	while (*end != ' ' && *end != ':' && *end != '\n' && *end != '\0') {
+		end++;
+	}
+
+	*length = end - position;
+
+	return position;
+}
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    d2468f3c_parse_uint64
+ * Description: Skips leading spaces and parses the next decimal number; a
+ *              leading minus sign is stored as its two's complement
+ *
+ * Parameters:
+ *   position       The current position in the procfs buffer
+ *   value          Set to the parsed value (zero if no digits follow)
+ * Returns:         The position after the number
+ * ----------------------------------------------------------------------------
+ */
+static inline char *d2468f3c_parse_uint64(register char *position, uint64_t *value) {
+	register char *end;
+	register bool negative;
+
+	while (*position == ' ') {
+		position++;
+	}
+
+	negative = (*position == '-');
+	position += negative;
+
+	end = position;
+	while (*end >= '0' && *end <= '9') {
+		end++;
+	}
+
+	*value = (end == position) ? 0UL : db0acb04_parse_uint64_ssize(position, end - position);
+
+	if (negative) {
+		*value = ~(*value) + 1;
+	}
+
+	return end;
+}
+
+#endif /* ORG_DEVOPSBROKER_PROC_PROCFILE_H */
@@ -0,0 +1,188 @@
+/*
+ * procstat.c - DevOpsBroker C source file for parsing /proc/stat
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+// ════════════════════════════ Feature Test Macros ═══════════════════════════
+
+#define _DEFAULT_SOURCE
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#include "procstat.h"
+#include "procfile.h"
+
+#include "../lang/memory.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define PROCSTAT_DEFAULT_SIZE 8
+
+#define PROCSTAT_NUM_FIELDS (sizeof(procStatFields) / sizeof(ProcField))
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+/*
+ * Static functions in C restrict their scope to the file where they are declared
+ */
+static void ensureCapacity(register ProcStat *procStat, const uint32_t numCpus) {
+	if (numCpus > procStat->size) {
+		register uint32_t size = (procStat->size == 0) ? PROCSTAT_DEFAULT_SIZE : procStat->size;
+
+		while (size < numCpus) {
+			size <<= 1;
+		}
+
+		procStat->cpus = f668c4bd_realloc(procStat->cpus, sizeof(CpuTimes) * procStat->size, sizeof(CpuTimes) * size);
+		procStat->size = size;
+	}
+}
+
+static inline char *parseCpuTimes(register char *position, CpuTimes *cpuTimes) {
+	register uint64_t *counter = &cpuTimes->user;
+
+	for (int i = 0; i < CPUTIMES_NUM_COUNTERS; i++) {
+		position = d2468f3c_parse_uint64(position, counter++);
+	}
+
+	return position;
+}
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+// Listed in the order the kernel emits them
+static const ProcField procStatFields[] = {
+	{ "intr",          4, offsetof(ProcStat, interrupts) },
+	{ "ctxt",          4, offsetof(ProcStat, contextSwitches) },
+	{ "btime",         5, offsetof(ProcStat, bootTime) },
+	{ "processes",     9, offsetof(ProcStat, forks) },
+	{ "procs_running", 13, offsetof(ProcStat, procsRunning) },
+	{ "procs_blocked", 13, offsetof(ProcStat, procsBlocked) },
+	{ "softirq",       7, offsetof(ProcStat, softirqs) }
+};
+
+// ═════════════════════════ Function Implementations ═════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void f7415ab2_cleanUpProcStat(ProcStat *procStat) {
+	f668c4bd_free(procStat->cpus);
+
+	procStat->cpus = NULL;
+	procStat->numCpus = 0;
+	procStat->size = 0;
+}
+
+void f7415ab2_initProcStat(ProcStat *procStat) {
+	f668c4bd_meminit(procStat, sizeof(ProcStat));
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void f7415ab2_delta(const ProcStat *prev, const ProcStat *curr, ProcStat *delta) {
+	const uint32_t numCpus = curr->numCpus;
+
+	ensureCapacity(delta, numCpus);
+
+	d2468f3c_delta_uint64(&prev->total.user, &curr->total.user, &delta->total.user, CPUTIMES_NUM_COUNTERS);
+
+	for (uint32_t i = 0; i < numCpus; i++) {
+		if (i < prev->numCpus) {
+			d2468f3c_delta_uint64(&prev->cpus[i].user, &curr->cpus[i].user, &delta->cpus[i].user, CPUTIMES_NUM_COUNTERS);
+		} else {
+			delta->cpus[i] = curr->cpus[i];
+		}
+	}
+
+	d2468f3c_delta_uint64(&prev->interrupts, &curr->interrupts, &delta->interrupts, PROCSTAT_NUM_COUNTERS);
+
+	delta->timestamp = curr->timestamp - prev->timestamp;
+	delta->bootTime = curr->bootTime;
+	delta->procsRunning = curr->procsRunning;
+	delta->procsBlocked = curr->procsBlocked;
+	delta->numCpus = numCpus;
+}
+
+double f7415ab2_getUtilization(const CpuTimes *cpuTimes) {
+	// guest and guestNice are already accounted for in user and nice
+	const uint64_t idle = cpuTimes->idle + cpuTimes->iowait;
+	const uint64_t total = idle + cpuTimes->user + cpuTimes->nice + cpuTimes->system
+	                     + cpuTimes->irq + cpuTimes->softirq + cpuTimes->steal;
+
+	return (total == 0) ? 0.0 : (double) (total - idle) / total;
+}
+
+void f7415ab2_readProcStat(ProcFile *procFile, ProcStat *procStat) {
+	register char *position;
+	char *name;
+	uint32_t nameLength;
+	uint32_t hint = 0;
+	uint32_t numCpus = 0;
+	uint64_t cpu;
+	int32_t index;
+
+	d2468f3c_readProcFile(procFile);
+	procStat->timestamp = d2468f3c_getTimestamp();
+
+	position = procFile->buffer;
+
+	while (*position != '\0') {
+		name = d2468f3c_nextName(position, &nameLength);
+		position = name + nameLength;
+
+		if (nameLength >= 3 && name[0] == 'c' && name[1] == 'p' && name[2] == 'u') {
+			if (nameLength == 3) {
+				position = parseCpuTimes(position, &procStat->total);
+			} else {
+				d2468f3c_parse_uint64(name + 3, &cpu);
+				ensureCapacity(procStat, cpu + 1);
+
+				// Zero the entries of any offline CPUs that were skipped
+				if (cpu > numCpus) {
+					f668c4bd_meminit(&procStat->cpus[numCpus], sizeof(CpuTimes) * (cpu - numCpus));
+				}
+
+				position = parseCpuTimes(position, &procStat->cpus[cpu]);
+				numCpus = cpu + 1;
+			}
+		} else {
+			index = d2468f3c_findField(procStatFields, PROCSTAT_NUM_FIELDS, name, nameLength, &hint);
+
+			// Only the first value of the intr and softirq lines is the total
+			if (index >= 0) {
+				position = d2468f3c_parse_uint64(position, (uint64_t *) (((char *) procStat) + procStatFields[index].offset));
+			}
+		}
+
+		position = d2468f3c_nextLine(position);
+	}
+
+	procStat->numCpus = numCpus;
+}
@@ -0,0 +1,146 @@
+/*
+ * procstat.h - DevOpsBroker C header file for parsing /proc/stat
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * Parses the CPU time and scheduler counters of /proc/stat in a single pass over
+ * a ProcFile buffer. Per-CPU times are indexed by CPU number, so offline CPUs
+ * leave zeroed entries rather than shifting the ones after them. Only the total
+ * of the long intr and softirq lines is kept.
+ *
+ * echo ORG_DEVOPSBROKER_PROC_PROCSTAT | md5sum | cut -c 25-32
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef ORG_DEVOPSBROKER_PROC_PROCSTAT_H
+#define ORG_DEVOPSBROKER_PROC_PROCSTAT_H
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdint.h>
+
+#include <assert.h>
+
+#include "procfile.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define CPUTIMES_NUM_COUNTERS 10
+
+#define PROCSTAT_NUM_COUNTERS 4
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+typedef struct CpuTimes {                                    // USER_HZ ticks
+	uint64_t user;
+	uint64_t nice;
+	uint64_t system;
+	uint64_t idle;
+	uint64_t iowait;
+	uint64_t irq;
+	uint64_t softirq;
+	uint64_t steal;
+	uint64_t guest;                  // Already included in user
+	uint64_t guestNice;              // Already included in nice
+} CpuTimes;
+
+static_assert(sizeof(CpuTimes) == 80, "Check your assumptions");
+
+typedef struct ProcStat {
+	CpuTimes total;
+	CpuTimes *cpus;
+	uint64_t timestamp;              // CLOCK_MONOTONIC nanoseconds
+	uint64_t interrupts;
+	uint64_t contextSwitches;
+	uint64_t forks;
+	uint64_t softirqs;
+	uint64_t bootTime;
+	uint64_t procsRunning;
+	uint64_t procsBlocked;
+	uint32_t numCpus;
+	uint32_t size;
+} ProcStat;
+
+static_assert(sizeof(ProcStat) == 160, "Check your assumptions");
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f7415ab2_cleanUpProcStat
+ * Description: Frees the per-CPU array of the ProcStat
+ *
+ * Parameters:
+ *   procStat       A pointer to the ProcStat instance to clean up
+ * ----------------------------------------------------------------------------
+ */
+void f7415ab2_cleanUpProcStat(ProcStat *procStat);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f7415ab2_initProcStat
+ * Description: Initializes an empty ProcStat
+ *
+ * Parameters:
+ *   procStat       A pointer to the ProcStat instance to initalize
+ * ----------------------------------------------------------------------------
+ */
+void f7415ab2_initProcStat(ProcStat *procStat);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f7415ab2_delta
+ * Description: Computes the CPU time and counter deltas between two snapshots;
+ *              bootTime, procsRunning and procsBlocked keep their current value
+ *
+ * Parameters:
+ *   prev           The earlier ProcStat
+ *   curr           The later ProcStat
+ *   delta          The ProcStat to store the deltas in; its timestamp holds the
+ *                  elapsed nanoseconds
+ * ----------------------------------------------------------------------------
+ */
+void f7415ab2_delta(const ProcStat *prev, const ProcStat *curr, ProcStat *delta);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f7415ab2_getUtilization
+ * Description: Returns the fraction of non-idle time in a CpuTimes delta
+ *
+ * Parameters:
+ *   cpuTimes       A CpuTimes delta computed by f7415ab2_delta()
+ * Returns:         The utilization between 0.0 and 1.0
+ * ----------------------------------------------------------------------------
+ */
+double f7415ab2_getUtilization(const CpuTimes *cpuTimes);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f7415ab2_readProcStat
+ * Description: Re-reads /proc/stat and parses it into the ProcStat
+ *
+ * Parameters:
+ *   procFile       A ProcFile opened on /proc/stat
+ *   procStat       A pointer to the ProcStat instance to populate
+ * ----------------------------------------------------------------------------
+ */
+void f7415ab2_readProcStat(ProcFile *procFile, ProcStat *procStat);
+
+#endif /* ORG_DEVOPSBROKER_PROC_PROCSTAT_H */
@@ -0,0 +1,187 @@
+/*
+ * snmp.c - DevOpsBroker C source file for parsing /proc/net/snmp
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+// ════════════════════════════ Feature Test Macros ═══════════════════════════
+
+#define _DEFAULT_SOURCE
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stddef.h>
+
+
+#include "snmp.h"
+#include "procfile.h"
+
+#include "../lang/memory.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define SNMP_MAX_COLUMNS 64
+
+#define SNMP_NUM_VALUES (sizeof(SnmpStats) / sizeof(uint64_t) - 1)
+
+#define SNMP_NUM_FIELDS(fields) (sizeof(fields) / sizeof(ProcField))
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+// Listed in the order the kernel emits them
+static const ProcField ipFields[] = {
+	{ "Forwarding",      10, offsetof(IpStats, forwarding) },
+	{ "DefaultTTL",      10, offsetof(IpStats, defaultTTL) },
+	{ "InReceives",      10, offsetof(IpStats, inReceives) },
+	{ "InHdrErrors",     11, offsetof(IpStats, inHdrErrors) },
+	{ "InAddrErrors",    12, offsetof(IpStats, inAddrErrors) },
+	{ "ForwDatagrams",   13, offsetof(IpStats, forwDatagrams) },
+	{ "InUnknownProtos", 15, offsetof(IpStats, inUnknownProtos) },
+	{ "InDiscards",      10, offsetof(IpStats, inDiscards) },
+	{ "InDelivers",      10, offsetof(IpStats, inDelivers) },
+	{ "OutRequests",     11, offsetof(IpStats, outRequests) },
+	{ "OutDiscards",     11, offsetof(IpStats, outDiscards) },
+	{ "OutNoRoutes",     11, offsetof(IpStats, outNoRoutes) },
+	{ "ReasmTimeout",    12, offsetof(IpStats, reasmTimeout) },
+	{ "ReasmReqds",      10, offsetof(IpStats, reasmReqds) },
+	{ "ReasmOKs",         8, offsetof(IpStats, reasmOKs) },
+	{ "ReasmFails",      10, offsetof(IpStats, reasmFails) },
+	{ "FragOKs",          7, offsetof(IpStats, fragOKs) },
+	{ "FragFails",        9, offsetof(IpStats, fragFails) },
+	{ "FragCreates",     11, offsetof(IpStats, fragCreates) }
+};
+
+static const ProcField tcpFields[] = {
+	{ "RtoAlgorithm", 12, offsetof(TcpStats, rtoAlgorithm) },
+	{ "RtoMin",        6, offsetof(TcpStats, rtoMin) },
+	{ "RtoMax",        6, offsetof(TcpStats, rtoMax) },
+	{ "MaxConn",       7, offsetof(TcpStats, maxConn) },
+	{ "ActiveOpens",  11, offsetof(TcpStats, activeOpens) },
+	{ "PassiveOpens", 12, offsetof(TcpStats, passiveOpens) },
+	{ "AttemptFails", 12, offsetof(TcpStats, attemptFails) },
+	{ "EstabResets",  11, offsetof(TcpStats, estabResets) },
+	{ "CurrEstab",     9, offsetof(TcpStats, currEstab) },
+	{ "InSegs",        6, offsetof(TcpStats, inSegs) },
+	{ "OutSegs",       7, offsetof(TcpStats, outSegs) },
+	{ "RetransSegs",  11, offsetof(TcpStats, retransSegs) },
+	{ "InErrs",        6, offsetof(TcpStats, inErrs) },
+	{ "OutRsts",       7, offsetof(TcpStats, outRsts) },
+	{ "InCsumErrors", 12, offsetof(TcpStats, inCsumErrors) }
+};
+
+static const ProcField udpFields[] = {
+	{ "InDatagrams",  11, offsetof(UdpStats, inDatagrams) },
+	{ "NoPorts",       7, offsetof(UdpStats, noPorts) },
+	{ "InErrors",      8, offsetof(UdpStats, inErrors) },
+	{ "OutDatagrams", 12, offsetof(UdpStats, outDatagrams) },
+	{ "RcvbufErrors", 12, offsetof(UdpStats, rcvbufErrors) },
+	{ "SndbufErrors", 12, offsetof(UdpStats, sndbufErrors) },
+	{ "InCsumErrors", 12, offsetof(UdpStats, inCsumErrors) },
+	{ "IgnoredMulti", 12, offsetof(UdpStats, ignoredMulti) }
+};
+
+// ═════════════════════════ Function Implementations ═════════════════════════
+
+void d86813c6_delta(const SnmpStats *prev, const SnmpStats *curr, SnmpStats *delta) {
+	d2468f3c_delta_uint64(&prev->ip.forwarding, &curr->ip.forwarding, &delta->ip.forwarding, SNMP_NUM_VALUES);
+
+	delta->ip.forwarding = curr->ip.forwarding;
+	delta->ip.defaultTTL = curr->ip.defaultTTL;
+	delta->tcp.rtoAlgorithm = curr->tcp.rtoAlgorithm;
+	delta->tcp.rtoMin = curr->tcp.rtoMin;
+	delta->tcp.rtoMax = curr->tcp.rtoMax;
+	delta->tcp.maxConn = curr->tcp.maxConn;
+	delta->tcp.currEstab = curr->tcp.currEstab;
+
+	delta->timestamp = curr->timestamp - prev->timestamp;
+}
+
+void d86813c6_readSnmp(ProcFile *procFile, SnmpStats *snmpStats) {
+	int32_t columns[SNMP_MAX_COLUMNS];
+	register char *position;
+	const ProcField *fields;
+	char *section, *base, *name;
+	uint32_t sectionLength, nameLength, numFields, numColumns, hint;
+	uint64_t value;
+
+	d2468f3c_readProcFile(procFile);
+
+	f668c4bd_meminit(snmpStats, sizeof(SnmpStats));
+	snmpStats->timestamp = d2468f3c_getTimestamp();
+
+	position = procFile->buffer;
+
+	// Each section is a header line of column names followed by a value line
+	while (*position != '\0') {
+		section = d2468f3c_nextName(position, &sectionLength);
+
+		if (sectionLength == 2 && section[0] == 'I' && section[1] == 'p') {
+			fields = ipFields;
+			numFields = SNMP_NUM_FIELDS(ipFields);
+			base = (char *) &snmpStats->ip;
+		} else if (sectionLength == 3 && section[0] == 'T' && section[1] == 'c' && section[2] == 'p') {
+			fields = tcpFields;
+			numFields = SNMP_NUM_FIELDS(tcpFields);
+			base = (char *) &snmpStats->tcp;
+		} else if (sectionLength == 3 && section[0] == 'U' && section[1] == 'd' && section[2] == 'p') {
+			fields = udpFields;
+			numFields = SNMP_NUM_FIELDS(udpFields);
+			base = (char *) &snmpStats->udp;
+		} else {
+			position = d2468f3c_nextLine(d2468f3c_nextLine(section));
+			continue;
+		}
+
+		// Map each column of the header line to a field of the section
+		position = section + sectionLength + 1;
+		numColumns = 0;
+		hint = 0;
+
+		while (*position != '\n' && *position != '\0' && numColumns < SNMP_MAX_COLUMNS) {
+			name = d2468f3c_nextName(position, &nameLength);
+			position = name + nameLength;
+
+			if (nameLength > 0) {
+				columns[numColumns++] = d2468f3c_findField(fields, numFields, name, nameLength, &hint);
+			}
+		}
+
+		// The value line repeats the section name before the values
+		section = d2468f3c_nextName(d2468f3c_nextLine(position), &sectionLength);
+		position = section + sectionLength + 1;
+
+		for (uint32_t i = 0; i < numColumns; i++) {
+			position = d2468f3c_parse_uint64(position, &value);
+
+			if (columns[i] >= 0) {
+				*((uint64_t *) (base + fields[columns[i]].offset)) = value;
+			}
+		}
+
+		position = d2468f3c_nextLine(position);
+	}
+}
@@ -0,0 +1,142 @@
+/*
+ * snmp.h - DevOpsBroker C header file for parsing /proc/net/snmp
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * Parses the Ip, Tcp and Udp sections of /proc/net/snmp in a single pass over
+ * a ProcFile buffer. Columns are matched by the names on each header line, so
+ * kernels that add or drop columns are handled; unknown columns and sections
+ * are skipped and missing columns are left at zero.
+ *
+ * echo ORG_DEVOPSBROKER_PROC_SNMP | md5sum | cut -c 25-32
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef ORG_DEVOPSBROKER_PROC_SNMP_H
+#define ORG_DEVOPSBROKER_PROC_SNMP_H
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdint.h>
+
+#include <assert.h>
+
+#include "procfile.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+typedef struct IpStats {
+	uint64_t forwarding;              // Gauge
+	uint64_t defaultTTL;              // Gauge
+	uint64_t inReceives;
+	uint64_t inHdrErrors;
+	uint64_t inAddrErrors;
+	uint64_t forwDatagrams;
+	uint64_t inUnknownProtos;
+	uint64_t inDiscards;
+	uint64_t inDelivers;
+	uint64_t outRequests;
+	uint64_t outDiscards;
+	uint64_t outNoRoutes;
+	uint64_t reasmTimeout;
+	uint64_t reasmReqds;
+	uint64_t reasmOKs;
+	uint64_t reasmFails;
+	uint64_t fragOKs;
+	uint64_t fragFails;
+	uint64_t fragCreates;
+} IpStats;
+
+static_assert(sizeof(IpStats) == 152, "Check your assumptions");
+
+typedef struct TcpStats {
+	uint64_t rtoAlgorithm;            // Gauge
+	uint64_t rtoMin;                  // Gauge
+	uint64_t rtoMax;                  // Gauge
+	uint64_t maxConn;                 // Gauge (-1 when dynamic)
+	uint64_t activeOpens;
+	uint64_t passiveOpens;
+	uint64_t attemptFails;
+	uint64_t estabResets;
+	uint64_t currEstab;               // Gauge
+	uint64_t inSegs;
+	uint64_t outSegs;
+	uint64_t retransSegs;
+	uint64_t inErrs;
+	uint64_t outRsts;
+	uint64_t inCsumErrors;
+} TcpStats;
+
+static_assert(sizeof(TcpStats) == 120, "Check your assumptions");
+
+typedef struct UdpStats {
+	uint64_t inDatagrams;
+	uint64_t noPorts;
+	uint64_t inErrors;
+	uint64_t outDatagrams;
+	uint64_t rcvbufErrors;
+	uint64_t sndbufErrors;
+	uint64_t inCsumErrors;
+	uint64_t ignoredMulti;
+} UdpStats;
+
+static_assert(sizeof(UdpStats) == 64, "Check your assumptions");
+
+typedef struct SnmpStats {
+	IpStats ip;
+	TcpStats tcp;
+	UdpStats udp;
+	uint64_t timestamp;              // CLOCK_MONOTONIC nanoseconds
+} SnmpStats;
+
+static_assert(sizeof(SnmpStats) == 344, "Check your assumptions");
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    d86813c6_delta
+ * Description: Computes the counter deltas between two snapshots; the fields
+ *              marked as gauges keep their current value
+ *
+ * Parameters:
+ *   prev           The earlier SnmpStats
+ *   curr           The later SnmpStats
+ *   delta          The SnmpStats to store the deltas in; its timestamp holds
+ *                  the elapsed nanoseconds
+ * ----------------------------------------------------------------------------
+ */
+void d86813c6_delta(const SnmpStats *prev, const SnmpStats *curr, SnmpStats *delta);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    d86813c6_readSnmp
+ * Description: Re-reads /proc/net/snmp and parses it into the SnmpStats
+ *
+ * Parameters:
+ *   procFile       A ProcFile opened on /proc/net/snmp
+ *   snmpStats      A pointer to the SnmpStats instance to populate
+ * ----------------------------------------------------------------------------
+ */
+void d86813c6_readSnmp(ProcFile *procFile, SnmpStats *snmpStats);
+
+#endif /* ORG_DEVOPSBROKER_PROC_SNMP_H */
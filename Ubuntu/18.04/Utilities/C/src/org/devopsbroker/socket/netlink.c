@@ -29,14 +29,20 @@
 
 #include <stdio.h>
 
+#include <errno.h>
+#include <fcntl.h>
 #include <unistd.h>
 
 #include <arpa/inet.h>
+#include <sys/uio.h>
 
 #include "netlink.h"
 #include "socket.h"
 
+#include "../io/file.h"
 #include "../lang/error.h"
+#include "../lang/memory.h"
+#include "../lang/stringbuilder.h"
 
 // ═══════════════════════════════ Preprocessor ═══════════════════════════════
 
@@ -50,8 +56,222 @@ typedef struct DebugNetlinkAttribute {
 	unsigned char rtm_family;
 } DebugNetlinkAttribute;
 
+typedef struct NetlinkErrorReply {
+	NetlinkMessageHeader msgHeader;
+	struct nlmsgerr nlError;
+} NetlinkErrorReply;
+
+static_assert(sizeof(NetlinkErrorReply) == 36, "Check your assumptions");
+
+typedef struct ReplayRequest {
+	NetlinkMessageHeader msgHeader;
+	unsigned char family;         // First byte of every routing request
+	char _padding[3];
+} ReplayRequest;
+
+static_assert(sizeof(ReplayRequest) == 20, "Check your assumptions");
+
 // ═══════════════════════════ Function Declarations ══════════════════════════
 
+/*
+ * Static functions in C restrict their scope to the file where they are declared
+ */
+static void invalidCaptureFile(const char *pathName) {
+	StringBuilder errorMessage;
+	c598a24c_initStringBuilder(&errorMessage);
+
+	c598a24c_append_string(&errorMessage, "Invalid Netlink capture file '");
+	c598a24c_append_string(&errorMessage, pathName);
+	c598a24c_append_char(&errorMessage, '\'');
+
+	c7c88e52_printError_string(errorMessage.buffer);
+	free(errorMessage.buffer);
+	exit(EXIT_FAILURE);
+}
+
+static void loadReplay(NetlinkReplay *replay, const char *pathName) {
+	NetlinkCaptureRecord *record;
+	FileStatus fileStatus;
+	size_t offset = 0;
+	uint32_t size = 0;
+	uint32_t maxLength = 0;
+	bool firstRecord = true;
+	int fd;
+
+	e2f74138_getFileStatus(pathName, &fileStatus);
+
+	if (fileStatus.st_size == 0 || fileStatus.st_size > UINT32_MAX) {
+		invalidCaptureFile(pathName);
+	}
+
+	replay->length = fileStatus.st_size;
+	replay->data = f668c4bd_malloc(replay->length);
+	replay->replies = NULL;
+	replay->numReplies = 0;
+	replay->cursor = 0;
+
+	fd = e2f74138_openFile(pathName, O_RDONLY);
+
+	while (offset < replay->length) {
+		ssize_t numBytes = e2f74138_readFile(fd, replay->data + offset, replay->length - offset, pathName);
+
+		if (numBytes == END_OF_FILE) {
+			invalidCaptureFile(pathName);
+		}
+
+		offset += numBytes;
+	}
+
+	e2f74138_closeFile(fd, pathName);
+
+	// Index the first record of every reply and check that no record overruns the file
+	for (offset = 0; offset < replay->length; offset += sizeof(NetlinkCaptureRecord) + record->length) {
+		record = (NetlinkCaptureRecord *) (replay->data + offset);
+
+		if (replay->length - offset < sizeof(NetlinkCaptureRecord)
+				|| record->length < sizeof(NetlinkMessageHeader)
+				|| record->length > replay->length - offset - sizeof(NetlinkCaptureRecord)
+				|| NLMSG_ALIGN(record->length) != record->length) {
+			invalidCaptureFile(pathName);
+		}
+
+		if (firstRecord) {
+			if (replay->numReplies == size) {
+				replay->replies = f668c4bd_realloc(replay->replies, sizeof(uint32_t) * size, sizeof(uint32_t) * (size + 64));
+				size += 64;
+			}
+
+			replay->replies[replay->numReplies++] = offset;
+		}
+
+		if (record->length > maxLength) {
+			maxLength = record->length;
+		}
+
+		firstRecord = (record->flags & NETLINK_CAPTURE_LAST);
+	}
+
+	// A reply cut off at the end of the file would be replayed past the buffer
+	if (!firstRecord) {
+		invalidCaptureFile(pathName);
+	}
+
+	replay->buffer = f668c4bd_malloc(maxLength);
+}
+
+static uint32_t filterDatagram(NetlinkReplay *replay, NetlinkCaptureRecord *record, unsigned char family) {
+	NetlinkMessageHeader *msgHeader = (NetlinkMessageHeader *) (record + 1);
+	int msgLen = record->length;
+	uint32_t length = 0;
+
+	for (; NLMSG_OK(msgHeader, msgLen); msgHeader = NLMSG_NEXT(msgHeader, msgLen)) {
+		if (msgHeader->nlmsg_type == NLMSG_DONE || msgHeader->nlmsg_type == NLMSG_ERROR
+				|| *((unsigned char *) NLMSG_DATA(msgHeader)) == family) {
+			f668c4bd_memcopy(msgHeader, replay->buffer + length, msgHeader->nlmsg_len);
+			length += NLMSG_ALIGN(msgHeader->nlmsg_len);
+		}
+	}
+
+	return length;
+}
+
+static void sendErrorReply(NetlinkReplay *replay, NetlinkMessageHeader *request, int errorNumber) {
+	NetlinkErrorReply reply;
+
+	f668c4bd_meminit(&reply, sizeof(NetlinkErrorReply));
+	reply.msgHeader.nlmsg_len = sizeof(NetlinkErrorReply);
+	reply.msgHeader.nlmsg_type = NLMSG_ERROR;
+	reply.msgHeader.nlmsg_seq = request->nlmsg_seq;
+	reply.nlError.error = -errorNumber;
+	reply.nlError.msg = *request;
+
+	send(replay->fd, &reply, sizeof(NetlinkErrorReply), MSG_NOSIGNAL);
+}
+
+static void sendReply(NetlinkReplay *replay, ReplayRequest *replayRequest) {
+	NetlinkMessageHeader *request = &replayRequest->msgHeader;
+	NetlinkCaptureRecord *record;
+	NetlinkMessageHeader *msgHeader;
+	uint32_t index = replay->cursor;
+	uint32_t i, length;
+	bool lastRecord;
+	void *datagram;
+	int msgLen;
+
+	// Serve the next reply recorded for the same kind of request
+	for (i = 0; i < replay->numReplies; i++) {
+		record = (NetlinkCaptureRecord *) (replay->data + replay->replies[index]);
+
+		if (record->requestType == request->nlmsg_type) {
+			break;
+		}
+
+		index = (index + 1 == replay->numReplies) ? 0 : index + 1;
+	}
+
+	if (i == replay->numReplies) {
+		sendErrorReply(replay, request, EOPNOTSUPP);
+		return;
+	}
+
+	replay->cursor = (index + 1 == replay->numReplies) ? 0 : index + 1;
+
+	do {
+		msgHeader = (NetlinkMessageHeader *) (record + 1);
+		msgLen = record->length;
+
+		// The client drops every message that does not carry its sequence number
+		for (; NLMSG_OK(msgHeader, msgLen); msgHeader = NLMSG_NEXT(msgHeader, msgLen)) {
+			msgHeader->nlmsg_seq = request->nlmsg_seq;
+		}
+
+		datagram = record + 1;
+		length = record->length;
+
+		// The kernel only dumps the address family that was asked for
+		if (replay->filterFamily && replayRequest->family != AF_UNSPEC) {
+			datagram = replay->buffer;
+			length = filterDatagram(replay, record, replayRequest->family);
+		}
+
+		// The client closed its end and is no longer reading
+		if (length > 0 && send(replay->fd, datagram, length, MSG_NOSIGNAL) == SYSTEM_ERROR_CODE) {
+			return;
+		}
+
+		lastRecord = (record->flags & NETLINK_CAPTURE_LAST);
+		record = (NetlinkCaptureRecord *) (((char *) (record + 1)) + record->length);
+	} while (!lastRecord);
+}
+
+static void *replayRequests(void *arg) {
+	NetlinkReplay *replay = arg;
+	ReplayRequest request;
+	ssize_t msgLen;
+
+	// SOCK_SEQPACKET discards the part of the request that does not fit
+	while ((msgLen = recv(replay->fd, &request, sizeof(ReplayRequest), 0)) > 0) {
+		if (msgLen < (ssize_t) sizeof(ReplayRequest)) {
+			request.family = AF_UNSPEC;
+		}
+
+		sendReply(replay, &request);
+	}
+
+	return NULL;
+}
+
+static void closeReplay(NetlinkReplay *replay) {
+	// Closing the client end already made recv() return zero
+	pthread_join(replay->thread, NULL);
+	close(replay->fd);
+
+	free(replay->data);
+	free(replay->replies);
+	free(replay->buffer);
+	free(replay);
+}
+
 
 // ═════════════════════════════ Global Variables ═════════════════════════════
 
@@ -65,9 +285,12 @@ NetlinkSocket *e7173ad4_createNetlinkSocket(NetlinkFamily family, size_t ioBufLe
 
 	f668c4bd_meminit(&netlinkSocket->addr, sizeof(NetlinkAddress));
 	netlinkSocket->addr.nl_family = AF_NETLINK;
+	netlinkSocket->captureFd = -1;
 	netlinkSocket->ioBuffer = a36b5966_createIOBuffer(ioBufLen);
+	netlinkSocket->replay = NULL;
 	netlinkSocket->family = family;
 	netlinkSocket->fd = 0;
+	netlinkSocket->strictChecking = false;
 
 	return netlinkSocket;
 }
@@ -79,6 +302,22 @@ void e7173ad4_destroyNetlinkSocket(NetlinkSocket *netlinkSocket) {
 
 // ~~~~~~~~~~~~~~~~~~~~~~~~~ Initialization Functions ~~~~~~~~~~~~~~~~~~~~~~~~~
 
+void e7173ad4_addAttribute(NetlinkMessageHeader *msgHeader, size_t maxLen, unsigned short type, const void *data, size_t dataLen) {
+	const uint32_t offset = NLMSG_ALIGN(msgHeader->nlmsg_len);
+	NetlinkAttribute *attribute = (NetlinkAttribute *) (((char *) msgHeader) + offset);
+
+	if (offset + RTA_SPACE(dataLen) > maxLen) {
+		c7c88e52_printError_string("Netlink request buffer too small for attribute");
+		exit(EXIT_FAILURE);
+	}
+
+	attribute->rta_type = type;
+	attribute->rta_len = RTA_LENGTH(dataLen);
+	f668c4bd_memcopy((void *) data, RTA_DATA(attribute), dataLen);
+
+	msgHeader->nlmsg_len = offset + RTA_ALIGN(attribute->rta_len);
+}
+
 void e7173ad4_initNetlinkAddressRequest(NetlinkAddressRequest *nlRequest, unsigned char addressType) {
 	nlRequest->msgHeader.nlmsg_len = NLMSG_LENGTH(sizeof(NetlinkAddressMessage));
 	nlRequest->msgHeader.nlmsg_type = RTM_GETADDR;
@@ -124,7 +363,14 @@ void e7173ad4_initReceiveMessageHeader(ReceiveMessageHeader *nlResponse, Netlink
 
 void e7173ad4_bind(NetlinkSocket *netlinkSocket) {
 	uint32_t addrLen = sizeof(NetlinkAddress);
-	int status = bind(netlinkSocket->fd, (struct sockaddr *) &netlinkSocket->addr, sizeof(NetlinkAddress));
+	int status;
+
+	// The replay socketpair is already connected
+	if (netlinkSocket->replay != NULL) {
+		return;
+	}
+
+	status = bind(netlinkSocket->fd, (struct sockaddr *) &netlinkSocket->addr, sizeof(NetlinkAddress));
 
 	if (status == SYSTEM_ERROR_CODE) {
 		c7c88e52_printLibError("Cannot bind Netlink socket", errno);
@@ -146,19 +392,133 @@ void e7173ad4_close(NetlinkSocket *netlinkSocket) {
 		exit(EXIT_FAILURE);
 	}
 
+	if (netlinkSocket->captureFd != -1) {
+		if (close(netlinkSocket->captureFd) == SYSTEM_ERROR_CODE) {
+			c7c88e52_printLibError("Cannot close Netlink capture file", errno);
+			exit(EXIT_FAILURE);
+		}
+
+		netlinkSocket->captureFd = -1;
+	}
+
+	if (netlinkSocket->replay != NULL) {
+		closeReplay(netlinkSocket->replay);
+		netlinkSocket->replay = NULL;
+	}
+}
+
+int e7173ad4_processRequest(NetlinkSocket *netlinkSocket, NetlinkMessageHeader *request, uint16_t flags, NetlinkHandler handler, void *context) {
+	ReceiveMessageHeader response;
+	NetlinkMessageHeader *msgHeader;
+	struct nlmsgerr *nlError;
+	ssize_t datagramLen, msgLen;
+	int errorNumber = -1;         // Stays -1 until the reply is complete
+
+	request->nlmsg_flags = flags;
+	request->nlmsg_pid = 0;
+
+	a36b5966_sendMessage(netlinkSocket->fd, request, request->nlmsg_len, 0);
+	e7173ad4_initReceiveMessageHeader(&response, netlinkSocket);
+
+	do {
+		datagramLen = e7173ad4_receiveMessage(netlinkSocket, &response);
+
+		if (datagramLen == SYSTEM_ERROR_CODE) {
+			return errno;
+		}
+
+		msgHeader = (NetlinkMessageHeader *) netlinkSocket->ioBuffer->iov_base;
+		msgLen = datagramLen;
+
+		for (; errorNumber == -1 && NLMSG_OK(msgHeader, msgLen); msgHeader = NLMSG_NEXT(msgHeader, msgLen)) {
+			// Skip anything left over from an earlier request on the same socket
+			if (msgHeader->nlmsg_seq != request->nlmsg_seq) {
+				continue;
+			}
+
+			if (msgHeader->nlmsg_type == NLMSG_DONE) {
+				// NLMSG_DONE may share a datagram with the last batch of messages
+				errorNumber = 0;
+			} else if (msgHeader->nlmsg_type == NLMSG_ERROR) {
+				// Either a failure or the ACK that ends a non-dump request
+				nlError = (struct nlmsgerr *) NLMSG_DATA(msgHeader);
+				errorNumber = -nlError->error;
+			} else {
+				handler(context, msgHeader);
+			}
+		}
+
+		if (netlinkSocket->captureFd != -1) {
+			e7173ad4_writeCaptureRecord(netlinkSocket->captureFd, request->nlmsg_type, netlinkSocket->ioBuffer->iov_base, datagramLen, errorNumber != -1);
+		}
+	} while (errorNumber == -1);
+
+	return errorNumber;
+}
+
+ssize_t e7173ad4_receiveMessage(NetlinkSocket *netlinkSocket, ReceiveMessageHeader *response) {
+	register IOBuffer *ioBuffer = netlinkSocket->ioBuffer;
+	size_t bufLen;
+	ssize_t msgLen;
+
+	// Probe the length of the next datagram without copying or dequeuing it
+	if (ioBuffer->iov_len < NETLINK_DUMP_SIZE) {
+		response->msg_iovlen = 0;
+		msgLen = a36b5966_receiveMessage(netlinkSocket->fd, response, MSG_PEEK | MSG_TRUNC);
+		response->msg_iovlen = 1;
+
+		// The kernel sizes dump batches to the reader, so a buffer that is more
+		// than half full is grown to NETLINK_DUMP_SIZE along with one that is too small
+		if ((size_t) msgLen > (ioBuffer->iov_len >> 1)) {
+			bufLen = ((size_t) msgLen > NETLINK_DUMP_SIZE) ? (size_t) msgLen : NETLINK_DUMP_SIZE;
+
+			ioBuffer->iov_base = f668c4bd_realloc(ioBuffer->iov_base, ioBuffer->iov_len, bufLen);
+			ioBuffer->iov_len = bufLen;
+		}
+	}
+
+	msgLen = a36b5966_receiveMessage(netlinkSocket->fd, response, 0);
+
+	// Dump batches never exceed NETLINK_DUMP_SIZE but a single message still can
+	if (response->msg_flags & MSG_TRUNC) {
+		errno = EMSGSIZE;
+		return SYSTEM_ERROR_CODE;
+	}
+
+	return msgLen;
 }
 
 void e7173ad4_open(NetlinkSocket *netlinkSocket) {
+	const char *pathName = getenv(NETLINK_REPLAY_ENV);
+
+	// Lets any program run against a recorded or synthetic capture without root
+	if (pathName != NULL) {
+		e7173ad4_openReplay(netlinkSocket, pathName);
+		return;
+	}
+
 	netlinkSocket->fd = socket(AF_NETLINK, SOCK_RAW|SOCK_CLOEXEC, netlinkSocket->family);
 
 	if (netlinkSocket->fd == SYSTEM_ERROR_CODE) {
 		c7c88e52_printLibError("Cannot open Netlink socket", errno);
 		exit(EXIT_FAILURE);
 	}
+
+	pathName = getenv(NETLINK_CAPTURE_ENV);
+
+	if (pathName != NULL) {
+		e7173ad4_startCapture(netlinkSocket, pathName);
+	}
 }
 
 void e7173ad4_setExtendedACKReporting(NetlinkSocket *netlinkSocket, bool extAckFlag) {
-	int status = setsockopt(netlinkSocket->fd, SOL_NETLINK, NETLINK_EXT_ACK, &extAckFlag, 4);
+	int status;
+
+	if (netlinkSocket->replay != NULL) {
+		return;
+	}
+
+	status = setsockopt(netlinkSocket->fd, SOL_NETLINK, NETLINK_EXT_ACK, &extAckFlag, 4);
 
 	if (status == SYSTEM_ERROR_CODE) {
 		c7c88e52_printLibError("Cannot set Netlink extended ACK reporting flag", errno);
@@ -166,6 +526,99 @@ void e7173ad4_setExtendedACKReporting(NetlinkSocket *netlinkSocket, bool extAckF
 	}
 }
 
+bool e7173ad4_setStrictChecking(NetlinkSocket *netlinkSocket, bool strictFlag) {
+	int optionValue = strictFlag;
+	int status;
+
+	// Replayed dumps are never filtered, so the handlers have to do it
+	if (netlinkSocket->replay != NULL) {
+		netlinkSocket->strictChecking = false;
+		return false;
+	}
+
+	status = setsockopt(netlinkSocket->fd, SOL_NETLINK, NETLINK_GET_STRICT_CHK, &optionValue, sizeof(int));
+
+	if (status == SYSTEM_ERROR_CODE) {
+		// Kernels before 4.20 do not know the option and always filter in userspace
+		if (errno == ENOPROTOOPT) {
+			netlinkSocket->strictChecking = false;
+			return false;
+		}
+
+		c7c88e52_printLibError("Cannot set Netlink strict checking flag", errno);
+		exit(EXIT_FAILURE);
+	}
+
+	netlinkSocket->strictChecking = strictFlag;
+
+	return true;
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Capture/Replay Functions ~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void e7173ad4_openReplay(NetlinkSocket *netlinkSocket, const char *pathName) {
+	NetlinkReplay *replay = f668c4bd_malloc(sizeof(NetlinkReplay));
+	int socketPair[2];
+	int status;
+
+	loadReplay(replay, pathName);
+
+	// SOCK_SEQPACKET keeps the recorded datagram boundaries intact
+	if (socketpair(AF_UNIX, SOCK_SEQPACKET|SOCK_CLOEXEC, 0, socketPair) == SYSTEM_ERROR_CODE) {
+		c7c88e52_printLibError("Cannot create Netlink replay socket pair", errno);
+		exit(EXIT_FAILURE);
+	}
+
+	netlinkSocket->fd = socketPair[0];
+	netlinkSocket->replay = replay;
+	replay->fd = socketPair[1];
+	replay->filterFamily = (netlinkSocket->family == NETLINK_ROUTE_ENUM);
+
+	status = pthread_create(&replay->thread, NULL, replayRequests, replay);
+
+	if (status != 0) {
+		c7c88e52_printLibError("Cannot start Netlink replay thread", status);
+		exit(EXIT_FAILURE);
+	}
+}
+
+void e7173ad4_startCapture(NetlinkSocket *netlinkSocket, const char *pathName) {
+	netlinkSocket->captureFd = open(pathName, O_WRONLY|O_CREAT|O_APPEND|O_CLOEXEC, 0640);
+
+	if (netlinkSocket->captureFd == SYSTEM_ERROR_CODE) {
+		StringBuilder errorMessage;
+		c598a24c_initStringBuilder(&errorMessage);
+
+		c598a24c_append_string(&errorMessage, "Cannot open Netlink capture file '");
+		c598a24c_append_string(&errorMessage, pathName);
+		c598a24c_append_char(&errorMessage, '\'');
+
+		c7c88e52_printLibError(errorMessage.buffer, errno);
+		free(errorMessage.buffer);
+		exit(EXIT_FAILURE);
+	}
+}
+
+void e7173ad4_writeCaptureRecord(int fd, uint16_t requestType, const void *datagram, uint32_t length, bool lastFlag) {
+	NetlinkCaptureRecord record;
+	IOBuffer ioBuffers[2];
+
+	record.length = length;
+	record.requestType = requestType;
+	record.flags = (lastFlag) ? NETLINK_CAPTURE_LAST : 0;
+
+	ioBuffers[0].iov_base = &record;
+	ioBuffers[0].iov_len = sizeof(NetlinkCaptureRecord);
+	ioBuffers[1].iov_base = (void *) datagram;
+	ioBuffers[1].iov_len = length;
+
+	// A single writev() keeps records from several sockets from interleaving
+	if (writev(fd, ioBuffers, 2) != (ssize_t) (sizeof(NetlinkCaptureRecord) + length)) {
+		c7c88e52_printLibError("Cannot write Netlink capture record", errno);
+		exit(EXIT_FAILURE);
+	}
+}
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Debug Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 static char *getRoutingTable(unsigned char rtm_table) {
@@ -29,8 +29,10 @@
 
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 #include <assert.h>
+#include <pthread.h>
 
 #include <asm/types.h>
 #include <linux/netlink.h>
@@ -43,6 +45,21 @@
 
 #define NETLINK_BUF_SIZE   32768
 
+// Largest datagram the kernel builds for a dump when the reader allows it
+#define NETLINK_DUMP_SIZE  32768
+
+// Environment variables that record or replay every NetlinkSocket of a program
+#define NETLINK_CAPTURE_ENV "NETLINK_CAPTURE"
+#define NETLINK_REPLAY_ENV  "NETLINK_REPLAY"
+
+// Marks the datagram that completes a reply in a capture file
+#define NETLINK_CAPTURE_LAST 0x01
+
+// Added in Linux 4.20 and missing from older kernel headers
+#ifndef NETLINK_GET_STRICT_CHK
+#define NETLINK_GET_STRICT_CHK 12
+#endif
+
 // ═════════════════════════════════ Typedefs ═════════════════════════════════
 
 typedef enum NetlinkFamily {                                        // netlink(7)
@@ -262,14 +279,43 @@ typedef struct NetlinkRouteRequest {
 
 static_assert(sizeof(NetlinkRouteRequest) == 28, "Check your assumptions");
 
+typedef struct NetlinkCaptureRecord {
+	uint32_t length;              // Length of the datagram that follows
+	uint16_t requestType;         // nlmsg_type of the request it answers
+	uint16_t flags;               // NETLINK_CAPTURE_LAST on the final datagram
+} NetlinkCaptureRecord;
+
+static_assert(sizeof(NetlinkCaptureRecord) == 8, "Check your assumptions");
+
+typedef struct NetlinkReplay {
+	char *data;                   // Capture file contents
+	uint32_t *replies;            // Offset of the first record of every reply
+	char *buffer;                 // Datagrams filtered by address family
+	pthread_t thread;             // Answers requests from the capture file
+	size_t length;
+	uint32_t numReplies;
+	uint32_t cursor;              // Index of the next reply to consider
+	int fd;                       // Responder end of the socketpair
+	bool filterFamily;            // Drop messages of other address families
+	char _padding[3];
+} NetlinkReplay;
+
+static_assert(sizeof(NetlinkReplay) == 56, "Check your assumptions");
+
 typedef struct NetlinkSocket {
 	NetlinkAddress addr;
+	int captureFd;                // Replies are recorded unless -1
 	IOBuffer *ioBuffer;
+	NetlinkReplay *replay;        // Non-NULL when served from a capture file
 	NetlinkFamily family;
 	int fd;
+	bool strictChecking;          // Kernel validates and filters dump requests
+	char _padding[7];
 } NetlinkSocket;
 
-static_assert(sizeof(NetlinkSocket) == 32, "Check your assumptions");
+static_assert(sizeof(NetlinkSocket) == 48, "Check your assumptions");
+
+typedef void (*NetlinkHandler)(void *context, NetlinkMessageHeader *msgHeader);
 
 typedef struct rta_cacheinfo RouteCacheInfo;
 /*	unsigned int   rta_clntref;
@@ -313,6 +359,21 @@ void e7173ad4_destroyNetlinkSocket(NetlinkSocket *netlinkSocket);
 
 // ~~~~~~~~~~~~~~~~~~~~~~~~~ Initialization Functions ~~~~~~~~~~~~~~~~~~~~~~~~~
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e7173ad4_addAttribute
+ * Description: Appends a NetlinkAttribute to the end of a request message and
+ *              updates nlmsg_len accordingly
+ *
+ * Parameters:
+ *   msgHeader      A pointer to the NetlinkMessageHeader of the request
+ *   maxLen         The size of the buffer holding the request
+ *   type           The attribute type (e.g. RTA_OIF)
+ *   data           A pointer to the attribute payload
+ *   dataLen        The length of the attribute payload
+ * ----------------------------------------------------------------------------
+ */
+void e7173ad4_addAttribute(NetlinkMessageHeader *msgHeader, size_t maxLen, unsigned short type, const void *data, size_t dataLen);
+
 /* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
  * Function:    e7173ad4_initNetlinkAddressRequest
  * Description: Initializes an existing NetlinkAddressRequest struct
@@ -363,6 +424,10 @@ void e7173ad4_initReceiveMessageHeader(ReceiveMessageHeader *nlResponse, Netlink
  * Function:    e7173ad4_open
  * Description: Opens the socket for an existing NetlinkSocket struct
  *
+ * NOTE: If NETLINK_REPLAY is set in the environment the socket is served from
+ *       that capture file instead; if NETLINK_CAPTURE is set every reply is
+ *       appended to that capture file
+ *
  * Parameters:
  *   netlinkSocket  A pointer to the NetlinkSocket instance to initalize
  * ----------------------------------------------------------------------------
@@ -389,6 +454,45 @@ void e7173ad4_bind(NetlinkSocket *netlinkSocket);
  */
 void e7173ad4_close(NetlinkSocket *netlinkSocket);
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e7173ad4_receiveMessage
+ * Description: Receives the next datagram into the NetlinkSocket IOBuffer
+ *
+ * NOTE: While the IOBuffer is smaller than NETLINK_DUMP_SIZE each datagram is
+ *       probed first and the IOBuffer is grown before the datagram is received
+ *       once it comes close to filling it, since the kernel sizes dump batches
+ *       to the reader. A larger IOBuffer is received into directly, and a
+ *       datagram the kernel still had to truncate is reported as EMSGSIZE
+ *
+ * Parameters:
+ *   netlinkSocket  A pointer to an open and bound NetlinkSocket instance
+ *   response       A pointer to the ReceiveMessageHeader initialized for the socket
+ * Returns:         The number of bytes received, or SYSTEM_ERROR_CODE with
+ *                  errno set to EMSGSIZE if the datagram was truncated
+ * ----------------------------------------------------------------------------
+ */
+ssize_t e7173ad4_receiveMessage(NetlinkSocket *netlinkSocket, ReceiveMessageHeader *response);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e7173ad4_processRequest
+ * Description: Sends a request and passes every reply message to the handler
+ *              until NLMSG_DONE or an NLMSG_ERROR is received
+ *
+ * NOTE: The caller sets nlmsg_seq; replies with any other sequence number are
+ *       skipped. Set NLM_F_ACK on non-dump requests so the reply is terminated
+ *
+ * Parameters:
+ *   netlinkSocket  A pointer to an open and bound NetlinkSocket instance
+ *   request        A pointer to the request message
+ *   flags          The nlmsg_flags of the request (e.g. NLM_F_REQUEST | NLM_F_DUMP)
+ *   handler        The function to call for each reply message
+ *   context        A pointer passed through to the handler
+ * Returns:         Zero on success, EMSGSIZE if a reply was truncated, or the
+ *                  error number reported by the kernel
+ * ----------------------------------------------------------------------------
+ */
+int e7173ad4_processRequest(NetlinkSocket *netlinkSocket, NetlinkMessageHeader *request, uint16_t flags, NetlinkHandler handler, void *context);
+
 /* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
  * Function:    e7173ad4_setExtendedACKReporting
  * Description: Enables or disables Netlink extended ACK reporting
@@ -400,6 +504,67 @@ void e7173ad4_close(NetlinkSocket *netlinkSocket);
  */
 void e7173ad4_setExtendedACKReporting(NetlinkSocket *netlinkSocket, bool extAckFlag);
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e7173ad4_setStrictChecking
+ * Description: Enables or disables strict checking of dump requests, which
+ *              lets the kernel filter dumps by the header fields and
+ *              attributes of the request
+ *
+ * Parameters:
+ *   netlinkSocket  A pointer to the NetlinkSocket instance
+ *   strictFlag     The strict checking flag value
+ * Returns:         True if the kernel supports strict checking, false otherwise
+ * ----------------------------------------------------------------------------
+ */
+bool e7173ad4_setStrictChecking(NetlinkSocket *netlinkSocket, bool strictFlag);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Capture/Replay Functions ~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e7173ad4_openReplay
+ * Description: Opens the NetlinkSocket on one end of a socketpair whose other
+ *              end answers every request from the specified capture file
+ *
+ * NOTE: Each request is answered with the next recorded reply to a request of
+ *       the same nlmsg_type, wrapping around at the end of the file. Sequence
+ *       numbers are rewritten to match the request. Like the kernel, routing
+ *       replies are filtered by the address family of the request; no other
+ *       filter is applied, so the NetlinkSocket reports strict checking as
+ *       unsupported
+ *
+ * Parameters:
+ *   netlinkSocket  A pointer to the NetlinkSocket instance to open
+ *   pathName       The name of the capture file to replay
+ * ----------------------------------------------------------------------------
+ */
+void e7173ad4_openReplay(NetlinkSocket *netlinkSocket, const char *pathName);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e7173ad4_startCapture
+ * Description: Appends every reply received by e7173ad4_processRequest() to the
+ *              specified capture file
+ *
+ * Parameters:
+ *   netlinkSocket  A pointer to an open NetlinkSocket instance
+ *   pathName       The name of the capture file to append to
+ * ----------------------------------------------------------------------------
+ */
+void e7173ad4_startCapture(NetlinkSocket *netlinkSocket, const char *pathName);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    e7173ad4_writeCaptureRecord
+ * Description: Writes one reply datagram to a capture file
+ *
+ * Parameters:
+ *   fd             The file descriptor of the capture file
+ *   requestType    The nlmsg_type of the request the datagram answers
+ *   datagram       A pointer to the datagram
+ *   length         The length of the datagram
+ *   lastFlag       True if the datagram completes the reply
+ * ----------------------------------------------------------------------------
+ */
+void e7173ad4_writeCaptureRecord(int fd, uint16_t requestType, const void *datagram, uint32_t length, bool lastFlag);
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Debug Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 void e7173ad4_debugNetlinkRouteMessage(NetlinkRouteMessage *routeMessage, NetlinkMessageHeader *nlMsgHeader);
@@ -59,11 +59,24 @@ IOBuffer *a36b5966_createIOBuffer(size_t bufLen) {
 	return ioBuffer;
 }
 
+IOBuffer *a36b5966_createIOBuffer_pool(ObjectPool *objectPool) {
+	IOBuffer *ioBuffer = e744848d_alloc(objectPool);
+
+	ioBuffer->iov_base = ioBuffer + 1;
+	ioBuffer->iov_len = objectPool->objectSize - sizeof(IOBuffer);
+
+	return ioBuffer;
+}
+
 void a36b5966_destroyIOBuffer(IOBuffer *ioBuffer) {
 	free(ioBuffer->iov_base);
 	free(ioBuffer);
 }
 
+void a36b5966_destroyIOBuffer_pool(IOBuffer *ioBuffer, ObjectPool *objectPool) {
+	e744848d_free(objectPool, ioBuffer);
+}
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Socket Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 void a36b5966_setMaxSendBufferSize(int sockfd, uint32_t bufSize) {
@@ -74,7 +87,7 @@ void a36b5966_setMaxSendBufferSize(int sockfd, uint32_t bufSize) {
 		c598a24c_initStringBuilder(&errorMessage);
 
 		c598a24c_append_string(&errorMessage, "Cannot set max send buffer size '");
-		c598a24c_append_uint32(&errorMessage, bufSize);
+		c598a24c_append_uint(&errorMessage, bufSize);
 		c598a24c_append_char(&errorMessage, '\'');
 
 		c7c88e52_printLibError(errorMessage.buffer, errno);
@@ -91,7 +104,7 @@ void a36b5966_setMaxRecvBufferSize(int sockfd, uint32_t bufSize) {
 		c598a24c_initStringBuilder(&errorMessage);
 
 		c598a24c_append_string(&errorMessage, "Cannot set max receive buffer size '");
-		c598a24c_append_uint32(&errorMessage, bufSize);
+		c598a24c_append_uint(&errorMessage, bufSize);
 		c598a24c_append_char(&errorMessage, '\'');
 
 		c7c88e52_printLibError(errorMessage.buffer, errno);
@@ -103,7 +116,7 @@ void a36b5966_setMaxRecvBufferSize(int sockfd, uint32_t bufSize) {
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 ssize_t a36b5966_receiveMessage(int sockfd, ReceiveMessageHeader *msg, int flags) {
-	ssize_t msgLen = recvmsg(sockfd, msg, 0);
+	ssize_t msgLen = recvmsg(sockfd, msg, flags);
 
 	if (msgLen == SYSTEM_ERROR_CODE) {
 		c7c88e52_printLibError("Cannot receive socket message", errno);
@@ -34,6 +34,8 @@
 #include <asm/types.h>
 #include <sys/socket.h>
 
+#include "../lang/objectpool.h"
+
 // ═══════════════════════════════ Preprocessor ═══════════════════════════════
 
 
@@ -168,6 +170,20 @@ static_assert(sizeof(ReceiveMessageHeader) == 56, "Check your assumptions");
  */
 IOBuffer *a36b5966_createIOBuffer(size_t bufLen);
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    a36b5966_createIOBuffer_pool
+ * Description: Creates a IOBuffer struct instance from the ObjectPool with the
+ *              buffer placed directly after the IOBuffer struct
+ *
+ * NOTE: Create the ObjectPool with an object size of sizeof(IOBuffer) + bufLen
+ *
+ * Parameters:
+ *   objectPool A pointer to the ObjectPool to allocate from
+ * Returns:     An IOBuffer struct instance initialized to bufLen
+ * ----------------------------------------------------------------------------
+ */
+IOBuffer *a36b5966_createIOBuffer_pool(ObjectPool *objectPool);
+
 /* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
  * Function:    a36b5966_destroyIOBuffer
  * Description: Frees the memory allocated to the IOBuffer struct pointer
@@ -178,6 +194,17 @@ IOBuffer *a36b5966_createIOBuffer(size_t bufLen);
  */
 void a36b5966_destroyIOBuffer(IOBuffer *ioBuffer);
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    a36b5966_destroyIOBuffer_pool
+ * Description: Returns the IOBuffer struct pointer to the ObjectPool
+ *
+ * Parameters:
+ *   ioBuffer   A pointer to the IOBuffer instance to destroy
+ *   objectPool The ObjectPool the IOBuffer was created from
+ * ----------------------------------------------------------------------------
+ */
+void a36b5966_destroyIOBuffer_pool(IOBuffer *ioBuffer, ObjectPool *objectPool);
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Socket Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 /* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
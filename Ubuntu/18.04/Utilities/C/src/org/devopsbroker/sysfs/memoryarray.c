@@ -37,6 +37,7 @@
 #include "memorytype.h"
 
 #include "../adt/listarray.h"
+#include "../io/pipe.h"
 #include "../lang/float.h"
 #include "../lang/integer.h"
 #include "../lang/long.h"
@@ -53,6 +54,8 @@
 
 // ═══════════════════════════ Function Declarations ══════════════════════════
 
+static MemoryArray *createMemoryArray(Arena *arena);
+
 static inline char *terminate(register char *line, register const char endChar) {
 	while (*line != endChar) {
 		line++;
@@ -173,13 +176,37 @@ char *const argList[] = { "/usr/sbin/dmidecode", "--type", "memory", NULL };
 // ═════════════════════════ Function Implementations ═════════════════════════
 
 MemoryArray *f004d1bd_createMemoryArray() {
+	return createMemoryArray(NULL);
+}
+
+MemoryArray *f004d1bd_createMemoryArray_arena(Arena *arena) {
+	return createMemoryArray(arena);
+}
+
+static MemoryArray *createMemoryArray(Arena *arena) {
 	char *memoryArrayData, *location, *use, *totalWidth;
 	uint32_t maxCapacity, errorInfoHandle;
 	register uint32_t numDevices;
 	ErrorCorrectionType ect;
 
+	StringBuilder *dmidecodeData;
+
 	// Execute dmidecode to get the memory information
-	StringBuilder *dmidecodeData = c16819a0_execute("/usr/sbin/dmidecode", argList);
+	if (arena == NULL) {
+		dmidecodeData = c16819a0_execute("/usr/sbin/dmidecode", argList);
+	} else {
+		// Read the dmidecode output straight into the Arena so everything shares one lifetime
+		Pipe pipe;
+		const pid_t child = c16819a0_execute_pipe("/usr/sbin/dmidecode", argList, &pipe);
+
+		dmidecodeData = eab6f0ff_alloc(arena, sizeof(StringBuilder));
+		c598a24c_initStringBuilder_arena(dmidecodeData, arena, PIPE_BUFFER_LENGTH);
+
+		c598a24c_readFile(dmidecodeData, *pipe.read, "/usr/sbin/dmidecode");
+		c31ab0c3_closeRead(&pipe);
+
+		c16819a0_waitForChild(child);
+	}
 
 	// Process the data for the MemoryArray struct
 	memoryArrayData = f6215943_search("Physical Memory Array", dmidecodeData->buffer);
@@ -191,7 +218,8 @@ MemoryArray *f004d1bd_createMemoryArray() {
 	numDevices = getUInt32Value(         "\tNumber Of Devices: ", &memoryArrayData, '\n');
 
 	// Allocate memory for the MemoryArray struct
-	register MemoryArray *memoryArray = f668c4bd_malloc(sizeof(MemoryArray) + sizeof(MemoryDevice[numDevices]));
+	const size_t memoryArraySize = sizeof(MemoryArray) + sizeof(MemoryDevice[numDevices]);
+	register MemoryArray *memoryArray = (arena == NULL) ? f668c4bd_malloc(memoryArraySize) : eab6f0ff_alloc(arena, memoryArraySize);
 
 	// Fill in the MemoryArray struct
 	memoryArray->dmidecodeData = dmidecodeData;
@@ -207,7 +235,11 @@ MemoryArray *f004d1bd_createMemoryArray() {
 
 	// Build the MemoryDevice list
 	ListArray channelsInUse;
-	b196167f_initListArray(&channelsInUse);
+	if (arena == NULL) {
+		b196167f_initListArray(&channelsInUse);
+	} else {
+		b196167f_initListArray_arena(&channelsInUse, arena, 8);
+	}
 	register MemoryDevice *memoryDevice;
 	register uint32_t j;
 	for (register uint32_t i = 0; i < numDevices; i++) {
@@ -281,6 +313,10 @@ MemoryArray *f004d1bd_createMemoryArray() {
 		}
 	}
 
+	if (arena == NULL) {
+		f668c4bd_free(channelsInUse.values);
+	}
+
 	return memoryArray;
 }
 
@@ -36,6 +36,7 @@
 #include "formfactor.h"
 #include "memorytype.h"
 
+#include "../lang/arena.h"
 #include "../lang/memory.h"
 #include "../lang/stringbuilder.h"
 
@@ -108,6 +109,19 @@ static inline void f004d1bd_destroyMemoryArray(MemoryArray *memoryArray) {
  */
 MemoryArray *f004d1bd_createMemoryArray();
 
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    f004d1bd_createMemoryArray_arena
+ * Description: Creates a MemoryArray struct instance allocated entirely from the Arena
+ *        NOTE: Do not call f004d1bd_destroyMemoryArray() on the result; it is
+ *              released along with the Arena
+ *
+ * Parameters:
+ *   arena          The Arena to allocate the MemoryArray from
+ * Returns:         A MemoryArray struct instance
+ * ----------------------------------------------------------------------------
+ */
+MemoryArray *f004d1bd_createMemoryArray_arena(Arena *arena);
+
 /* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
  * Function:    f004d1bd_toStringMemoryArray
  * Description: Generates a string from the MemoryArray instance
@@ -0,0 +1,152 @@
+/*
+ * sysfsvalue.c - DevOpsBroker C source file for the org.devopsbroker.sysfs.SysfsValue struct
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+// ════════════════════════════ Feature Test Macros ═══════════════════════════
+
+#define _DEFAULT_SOURCE
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdlib.h>
+
+#include <errno.h>
+#include <unistd.h>
+
+#include "sysfsvalue.h"
+
+#include "../io/file.h"
+#include "../lang/error.h"
+#include "../lang/long.h"
+#include "../lang/stringbuilder.h"
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+/*
+ * Static functions in C restrict their scope to the file where they are declared
+ */
+static inline void readValue(register SysfsValue *value) {
+	register ssize_t numBytes = pread(value->fd, value->buffer, SYSFSVALUE_BUFFER_SIZE - 1, 0);
+
+	while (numBytes == SYSTEM_ERROR_CODE) {
+		if (errno != EINTR) {
+			StringBuilder errorMessage;
+			c598a24c_initStringBuilder(&errorMessage);
+
+			c598a24c_append_string(&errorMessage, "Cannot read from file '");
+			c598a24c_append_string(&errorMessage, value->pathName);
+			c598a24c_append_char(&errorMessage, '\'');
+
+			c7c88e52_printLibError(errorMessage.buffer, errno);
+			c598a24c_cleanUpStringBuilder(&errorMessage);
+
+			exit(EXIT_FAILURE);
+		}
+
+		numBytes = pread(value->fd, value->buffer, SYSFSVALUE_BUFFER_SIZE - 1, 0);
+	}
+
+	// Drop the trailing newline the kernel appends to most attributes
+	if (numBytes > 0 && value->buffer[numBytes - 1] == '\n') {
+		numBytes--;
+	}
+
+	value->buffer[numBytes] = '\0';
+	value->length = numBytes;
+}
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═════════════════════════ Function Implementations ═════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void b8584075_openSysfsValue(SysfsValue *value, const char *pathName) {
+	value->pathName = pathName;
+	value->fd = e2f74138_openFile(pathName, O_RDONLY | O_CLOEXEC);
+
+	readValue(value);
+}
+
+void b8584075_closeSysfsValue(SysfsValue *value) {
+	e2f74138_closeFile(value->fd, value->pathName);
+
+	value->fd = SYSTEM_ERROR_CODE;
+	value->length = 0;
+	value->buffer[0] = '\0';
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+uint32_t b8584075_getHex_uint32(const SysfsValue *value) {
+	register const char *source = value->buffer;
+	register uint32_t result = 0;
+	register uint32_t digit;
+	register char ch;
+
+	// Skip the 0x prefix, if present
+	if (source[0] == '0' && (source[1] | 0x20) == 'x') {
+		source += 2;
+	}
+
+	for (ch = *source; ch != '\0'; ch = *(++source)) {
+		if (ch >= '0' && ch <= '9') {
+			digit = ch - '0';
+		} else if ((ch | 0x20) >= 'a' && (ch | 0x20) <= 'f') {
+			digit = (ch | 0x20) - 'a' + 10;
+		} else {
+			break;
+		}
+
+		result = (result << 4) + digit;
+	}
+
+	return result;
+}
+
+uint64_t b8584075_get_uint64(const SysfsValue *value) {
+	if (value->length == 0) {
+		return 0UL;
+	}
+
+	return db0acb04_parse_uint64_ssize(value->buffer, value->length);
+}
+
+void b8584075_refresh(SysfsValue *value) {
+	readValue(value);
+}
+
+void b8584075_refreshAll(register SysfsValue *values, const uint32_t numValues) {
+	register const SysfsValue *end = values + numValues;
+
+	while (values != end) {
+		readValue(values++);
+	}
+}
@@ -0,0 +1,143 @@
+/*
+ * sysfsvalue.h - DevOpsBroker C header file for the org.devopsbroker.sysfs.SysfsValue struct
+ *
+ * Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ * Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+ *
+ * A SysfsValue keeps a sysfs or procfs attribute open and refreshes it with a
+ * single pread() at offset zero, instead of the open()/read()/close() triple of
+ * e2f74138_read_uint64() and friends. Attributes re-generate their contents on
+ * every read from offset zero, so the handle never goes stale.
+ *
+ * Values longer than SYSFSVALUE_BUFFER_SIZE - 1 characters are truncated.
+ *
+ * echo ORG_DEVOPSBROKER_SYSFS_SYSFSVALUE | md5sum | cut -c 25-32
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef ORG_DEVOPSBROKER_SYSFS_SYSFSVALUE_H
+#define ORG_DEVOPSBROKER_SYSFS_SYSFSVALUE_H
+
+// ═════════════════════════════════ Includes ═════════════════════════════════
+
+#include <stdint.h>
+
+#include <assert.h>
+
+// ═══════════════════════════════ Preprocessor ═══════════════════════════════
+
+#define SYSFSVALUE_BUFFER_SIZE 48
+
+// ═════════════════════════════════ Typedefs ═════════════════════════════════
+
+typedef struct SysfsValue {
+	const char *pathName;
+	int fd;
+	uint32_t length;                 // Excludes the trailing newline
+	char buffer[SYSFSVALUE_BUFFER_SIZE];
+} SysfsValue;
+
+static_assert(sizeof(SysfsValue) == 64, "Check your assumptions");
+
+// ═════════════════════════════ Global Variables ═════════════════════════════
+
+
+// ═══════════════════════════ Function Declarations ══════════════════════════
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~ Init/Clean Up Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    b8584075_openSysfsValue
+ * Description: Opens the sysfs or procfs attribute and reads its current value
+ *
+ * Parameters:
+ *   value          A pointer to the SysfsValue instance to initalize
+ *   pathName       The name of the attribute file (must outlive the SysfsValue)
+ * ----------------------------------------------------------------------------
+ */
+void b8584075_openSysfsValue(SysfsValue *value, const char *pathName);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    b8584075_closeSysfsValue
+ * Description: Closes the file descriptor held by the SysfsValue
+ *
+ * Parameters:
+ *   value          A pointer to the SysfsValue instance to close
+ * ----------------------------------------------------------------------------
+ */
+void b8584075_closeSysfsValue(SysfsValue *value);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Utility Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    b8584075_getHex_uint32
+ * Description: Returns the last value read as a hexadecimal unsigned integer
+ *
+ * Parameters:
+ *   value          A pointer to the SysfsValue instance
+ * Returns:         The unsigned integer value
+ * ----------------------------------------------------------------------------
+ */
+uint32_t b8584075_getHex_uint32(const SysfsValue *value);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    b8584075_get_uint64
+ * Description: Returns the last value read as an unsigned long integer
+ *
+ * Parameters:
+ *   value          A pointer to the SysfsValue instance
+ * Returns:         The unsigned long integer value
+ * ----------------------------------------------------------------------------
+ */
+uint64_t b8584075_get_uint64(const SysfsValue *value);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    b8584075_getString
+ * Description: Returns the last value read as a string without the trailing
+ *              newline
+ *
+ * Parameters:
+ *   value          A pointer to the SysfsValue instance
+ * Returns:         The string value, owned by the SysfsValue
+ * ----------------------------------------------------------------------------
+ */
+static inline const char *b8584075_getString(const SysfsValue *value) {
+	return value->buffer;
+}
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    b8584075_refresh
+ * Description: Re-reads the attribute with a single pread() at offset zero
+ *
+ * Parameters:
+ *   value          A pointer to the SysfsValue instance
+ * ----------------------------------------------------------------------------
+ */
+void b8584075_refresh(SysfsValue *value);
+
+/* ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+ * Function:    b8584075_refreshAll
+ * Description: Re-reads every attribute in the array, one pread() per value
+ *
+ * Parameters:
+ *   values         The array of SysfsValue instances to refresh
+ *   numValues      The number of values in the array
+ * ----------------------------------------------------------------------------
+ */
+void b8584075_refreshAll(SysfsValue *values, const uint32_t numValues);
+
+#endif /* ORG_DEVOPSBROKER_SYSFS_SYSFSVALUE_H */
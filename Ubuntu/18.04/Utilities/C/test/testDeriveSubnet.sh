@@ -0,0 +1,142 @@
+#!/bin/bash
+
+#
+# testDeriveSubnet.sh - DevOpsBroker Bash test script for the derivesubnet utility
+#
+# Copyright (C) 2019 Edward Smith <edwardsmith@devopsbroker.org>
+#
+# This program is free software: you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation, either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# -----------------------------------------------------------------------------
+# Developed on Ubuntu 18.04.2 LTS running kernel.osrelease = 4.18.0-16
+#
+# Runs derivesubnet against a synthetic Netlink capture written by netlinkgen
+# with 1000 links, 10000 addresses and 100000 routes. The capture is served
+# through NETLINK_REPLAY, so neither root nor real interfaces are needed.
+# -----------------------------------------------------------------------------
+#
+
+# ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Preprocessing ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+# Load /etc/devops/ansi.conf if ANSI_CONFIG is unset
+if [ -z "$ANSI_CONFIG" ] && [ -f /etc/devops/ansi.conf ]; then
+	source /etc/devops/ansi.conf
+fi
+
+${ANSI_CONFIG?"[1;91mCannot load '/etc/devops/ansi.conf': No such file[0m"}
+
+# Load /etc/devops/exec.conf if EXEC_CONFIG is unset
+if [ -z "$EXEC_CONFIG" ] && [ -f /etc/devops/exec.conf ]; then
+	source /etc/devops/exec.conf
+fi
+
+${EXEC_CONFIG?"[1;91mCannot load '/etc/devops/exec.conf': No such file[0m"}
+
+# Load /etc/devops/functions.conf if FUNC_CONFIG is unset
+if [ -z "$FUNC_CONFIG" ] && [ -f /etc/devops/functions.conf ]; then
+	source /etc/devops/functions.conf
+fi
+
+${FUNC_CONFIG?"[1;91mCannot load '/etc/devops/functions.conf': No such file[0m"}
+
+## Script information
+SCRIPT_DIR=$( $EXEC_DIRNAME "$BASH_SOURCE" )
+EXEC_DIR="$SCRIPT_DIR/../bin"
+
+################################## Functions ##################################
+
+# ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+# Function:     negativeTest
+# Description:  Expects derivesubnet to fail against the synthetic capture
+#
+# Parameter $@: The derivesubnet arguments
+# -----------------------------------------------------------------------------
+function negativeTest() {
+	if ! NETLINK_REPLAY="$captureFile" "$EXEC_DERIVESUBNET" "$@" &>/dev/null; then
+		echo $pass
+	else
+		echo $fail
+	fi
+}
+
+# ¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯¯
+# Function:     positiveTest
+# Description:  Expects the output of derivesubnet against the synthetic capture
+#
+# Parameter $1: The expected output
+# Parameter $@: The derivesubnet arguments
+# -----------------------------------------------------------------------------
+function positiveTest() {
+	local expected="$1"
+	shift
+
+	if [ "$(NETLINK_REPLAY="$captureFile" "$EXEC_DERIVESUBNET" "$@")" == "$expected" ]; then
+		echo $pass
+	else
+		echo $fail
+	fi
+}
+
+################################## Variables ##################################
+
+## Bash exec variables
+EXEC_DERIVESUBNET="$EXEC_DIR/derivesubnet"
+EXEC_NETLINKGEN="$EXEC_DIR/netlinkgen"
+
+# Pass/Fail messages
+pass="${bold}${green}pass${reset}"
+fail="${bold}${red}fail${reset}"
+
+## Variables
+captureFile=$(/bin/mktemp --tmpdir netlinkgen.XXXXXXXX)
+
+trap "/bin/rm -f '$captureFile'" EXIT
+
+"$EXEC_NETLINKGEN" -l 1000 -a 10000 -r 100000 "$captureFile" || exit 1
+
+################################### Testing ###################################
+
+#~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Positive Testing ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+printBanner 'Positive Testing'
+
+## IPv4 Subnet
+printInfo 'IPv4 Subnet'
+echo -e 'derivesubnet syn1\t\t\t\t\t'          "[$(positiveTest $'10.0.1.1/24\n10.0.1.254\n10.0.1.0/24' syn1)]"
+echo -e 'derivesubnet -4 syn1000\t\t\t\t\t'    "[$(positiveTest $'10.3.232.1/24\n10.3.232.254\n10.3.232.0/24' -4 syn1000)]"
+echo
+
+## IPv6 Subnet
+printInfo 'IPv6 Subnet'
+echo -e 'derivesubnet -6 syn42\t\t\t\t\t'      "[$(positiveTest $'fd00:0:0:2a::1/64\n::\nfd00:0:0:2a::fffe\nfd00:0:0:2a::/64' -6 syn42)]"
+echo
+
+## All Interfaces
+printInfo 'All Interfaces'
+echo -e 'derivesubnet | head -1\t\t\t\t\t'     "[$([ "$(NETLINK_REPLAY="$captureFile" "$EXEC_DERIVESUBNET" | head -1)" == $'syn1\t10.0.1.1/24\t10.0.1.254\t10.0.1.0/24' ] && echo $pass || echo $fail)]"
+echo -e 'derivesubnet | wc -l\t\t\t\t\t'       "[$([ "$(NETLINK_REPLAY="$captureFile" "$EXEC_DERIVESUBNET" | wc -l)" == 1000 ] && echo $pass || echo $fail)]"
+echo
+
+#~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Negative Testing ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+printBanner 'Negative Testing'
+
+## Argument Testing
+printInfo 'Argument Testing'
+echo -e 'derivesubnet syn1001\t\t\t\t\t'       "[$(negativeTest syn1001)]"
+echo -e 'derivesubnet -x syn1\t\t\t\t\t'       "[$(negativeTest -x syn1)]"
+
+echo
+
+exit 0